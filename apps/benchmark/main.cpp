@@ -0,0 +1,219 @@
+//
+//  main.cpp
+//  benchmark
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#include <sun_ray/feature/affine_transform.h>
+#include <sun_ray/feature/matrix.h>
+#include <sun_ray/feature/tuple.h>
+#include <sun_ray/feature/tuple_kernel.h>
+
+#include <fmt/format.h>
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+  using Values = std::vector<sunray::Tuple::Vec>;
+
+  constexpr size_t number_of_tuples = 1024;
+
+  Values random_values(std::mt19937& generator)
+  {
+    std::uniform_real_distribution<sunray::Real> distribution{-10, 10};
+    Values values(number_of_tuples);
+    for (auto& value : values) {
+      for (auto& element : value) {
+        element = distribution(generator);
+      }
+    }
+    return values;
+  }
+
+  // Nanoseconds per call of the operation, which gets the index of the tuples
+  template <typename Operation>
+  double measure(size_t rounds, const Operation& operation)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < rounds; ++round) {
+      for (size_t n = 0; n < number_of_tuples; ++n) {
+        operation(n);
+      }
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return elapsed / static_cast<double>(rounds * number_of_tuples);
+  }
+
+  // Times the kernel operations on the same tuples, the results are summed up, so that they are not optimized away
+  template <typename Kernel>
+  std::vector<double> run(size_t rounds, const Values& a, const Values& b, double& sink)
+  {
+    Values r(number_of_tuples);
+    std::vector<double> result;
+    result.push_back(measure(rounds, [&](size_t n) {
+      Kernel::add(a[n].data(), b[n].data(), r[n].data());
+    }));
+    result.push_back(measure(rounds, [&](size_t n) {
+      Kernel::subtract(a[n].data(), b[n].data(), r[n].data());
+    }));
+    result.push_back(measure(rounds, [&](size_t n) {
+      Kernel::scale(a[n].data(), b[n][0], r[n].data());
+    }));
+    result.push_back(measure(rounds, [&](size_t n) {
+      r[n][0] += Kernel::dot(a[n].data(), b[n].data());
+    }));
+    result.push_back(measure(rounds, [&](size_t n) {
+      Kernel::cross(a[n].data(), b[n].data(), r[n].data());
+    }));
+    result.push_back(measure(rounds, [&](size_t n) {
+      // normalize
+      Kernel::scale(a[n].data(), sunray::Real{1} / std::sqrt(Kernel::dot(a[n].data(), a[n].data())), r[n].data());
+    }));
+    for (const auto& value : r) {
+      sink += value[0] + value[1] + value[2] + value[3];
+    }
+    return result;
+  }
+
+  // The inverse from the 16 cofactors of the 3x3 submatrices, as Matrix44::inverse() did before the closed form
+  sunray::Matrix44 cofactor_inverse(const sunray::Matrix44& matrix)
+  {
+    const auto det = matrix.determinant();
+    sunray::Matrix44::Mat m;
+    for (uint8_t r = 0; r < 4; ++r) {
+      for (uint8_t c = 0; c < 4; ++c) {
+        m[c * 4 + r] = matrix.cofactor(r, c) / det;
+      }
+    }
+    return sunray::Matrix44{m};
+  }
+
+  // Times the inverses and the products with a point of affine and of general matrices made from the values
+  std::vector<double> run_matrix(size_t rounds, const Values& a, const Values& b, double& sink)
+  {
+    std::vector<sunray::Matrix44> affine;
+    std::vector<sunray::Matrix44> general;
+    for (size_t n = 0; n < number_of_tuples; ++n) {
+      affine.push_back(sunray::Matrix44::translation(a[n][0], a[n][1], a[n][2]) * sunray::Matrix44::rotation_y(a[n][3]) *
+                       sunray::Matrix44::scaling(b[n][0], b[n][1], b[n][2]));
+      general.push_back(sunray::Matrix44{{a[n][0], a[n][1], a[n][2], a[n][3], b[n][0], b[n][1], b[n][2], b[n][3], a[n][1],
+                                          b[n][2], a[n][3], b[n][0], b[n][1], a[n][2], b[n][3], a[n][0]}});
+    }
+
+    std::vector<double> result;
+    for (const auto* matrices : {&affine, &general}) {
+      result.push_back(measure(rounds, [&](size_t n) {
+        sink += cofactor_inverse((*matrices)[n])[3];
+      }));
+      result.push_back(measure(rounds, [&](size_t n) {
+        sink += (*matrices)[n].inverse()[3];
+      }));
+    }
+    for (const auto* matrices : {&affine, &general}) {
+      result.push_back(measure(rounds, [&](size_t n) {
+        const auto point = sunray::create_point(a[n][0], a[n][1], a[n][2]);
+        // All four rows, as Matrix44 * Tuple did before
+        const auto& m = (*matrices)[n];
+        sunray::Tuple::Vec v;
+        for (uint8_t r = 0; r < 4; ++r) {
+          v[r] = m[{r, 0}] * point.x() + m[{r, 1}] * point.y() + m[{r, 2}] * point.z() + m[{r, 3}] * point.w();
+        }
+        const auto transformed = sunray::Tuple{v};
+        sink += transformed.x() + transformed.w();
+      }));
+      result.push_back(measure(rounds, [&](size_t n) {
+        const auto point = sunray::create_point(a[n][0], a[n][1], a[n][2]);
+        const auto transformed = (*matrices)[n] * point;
+        sink += transformed.x() + transformed.w();
+      }));
+    }
+    return result;
+  }
+
+  // Times transforming rays by the full matrix, as Object did before, and by the compact transform for each kind
+  std::vector<double> run_ray(size_t rounds, const Values& a, const Values& b, double& sink)
+  {
+    std::vector<std::vector<sunray::Matrix44>> matrices(4);
+    for (size_t n = 0; n < number_of_tuples; ++n) {
+      matrices[0].push_back(sunray::Matrix44::identity());
+      matrices[1].push_back(sunray::Matrix44::translation(a[n][0], a[n][1], a[n][2]));
+      matrices[2].push_back(sunray::Matrix44::translation(a[n][0], a[n][1], a[n][2]) *
+                            sunray::Matrix44::scaling(b[n][3], b[n][3], b[n][3]));
+      matrices[3].push_back(sunray::Matrix44::translation(a[n][0], a[n][1], a[n][2]) *
+                            sunray::Matrix44::rotation_y(a[n][3]) * sunray::Matrix44::scaling(b[n][0], b[n][1], b[n][2]));
+    }
+
+    std::vector<double> result;
+    for (const auto& kind : matrices) {
+      std::vector<sunray::AffineTransform> transforms;
+      for (const auto& matrix : kind) {
+        transforms.emplace_back(matrix);
+      }
+      result.push_back(measure(rounds, [&](size_t n) {
+        const sunray::Ray ray{sunray::create_point(a[n][0], a[n][1], a[n][2]), sunray::create_vector(b[n][0], b[n][1], b[n][2])};
+        const auto transformed = ray.transform(kind[n]);
+        sink += transformed.origin().x() + transformed.direction().z();
+      }));
+      result.push_back(measure(rounds, [&](size_t n) {
+        const sunray::Ray ray{sunray::create_point(a[n][0], a[n][1], a[n][2]), sunray::create_vector(b[n][0], b[n][1], b[n][2])};
+        if (transforms[n].kind() == sunray::TransformKind::identity) {
+          sink += ray.origin().x() + ray.direction().z();
+          return;
+        }
+        const auto transformed = transforms[n].transform(ray);
+        sink += transformed.origin().x() + transformed.direction().z();
+      }));
+    }
+    return result;
+  }
+}
+
+
+int main(int argc, const char* argv[])
+{
+  const size_t rounds = argc > 1 ? std::stoul(argv[1]) : 20000;
+
+  std::mt19937 generator{42};
+  const auto a = random_values(generator);
+  const auto b = random_values(generator);
+
+  double sink{0.0};
+  const auto scalar = run<sunray::kernel::ScalarTuple>(rounds, a, b, sink);
+  const auto simd = run<sunray::kernel::TupleKernel>(rounds, a, b, sink);
+
+  std::cout << fmt::format("{} tuples, {} rounds, kernel of Tuple: {}\n\n", number_of_tuples, rounds,
+                           sunray::kernel::TupleKernel::name);
+  std::cout << fmt::format("{:<12}{:>12}{:>12}{:>10}\n", "operation", "scalar ns", "kernel ns", "speedup");
+  const std::array<std::string, 6> names{"add", "subtract", "scale", "dot", "cross", "normalize"};
+  for (size_t n = 0; n < names.size(); ++n) {
+    std::cout << fmt::format("{:<12}{:>12.3f}{:>12.3f}{:>9.2f}x\n", names[n], scalar[n], simd[n], scalar[n] / simd[n]);
+  }
+
+  const auto matrix = run_matrix(rounds / 10, a, b, sink);
+  std::cout << fmt::format("\n{:<24}{:>12}{:>12}{:>10}\n", "matrix operation", "before ns", "now ns", "speedup");
+  const std::array<std::string, 4> matrix_names{"inverse affine", "inverse general", "multiply point affine",
+                                                "multiply point general"};
+  for (size_t n = 0; n < matrix_names.size(); ++n) {
+    std::cout << fmt::format("{:<24}{:>12.3f}{:>12.3f}{:>9.2f}x\n", matrix_names[n], matrix[2 * n], matrix[2 * n + 1],
+                             matrix[2 * n] / matrix[2 * n + 1]);
+  }
+
+  const auto ray = run_ray(rounds / 10, a, b, sink);
+  std::cout << fmt::format("\n{:<24}{:>12}{:>12}{:>10}\n", "ray transform", "matrix ns", "compact ns", "speedup");
+  const std::array<std::string, 4> ray_names{"identity", "translate", "translate scale", "affine"};
+  for (size_t n = 0; n < ray_names.size(); ++n) {
+    std::cout << fmt::format("{:<24}{:>12.3f}{:>12.3f}{:>9.2f}x\n", ray_names[n], ray[2 * n], ray[2 * n + 1],
+                             ray[2 * n] / ray[2 * n + 1]);
+  }
+  std::cout << fmt::format("\nchecksum: {}\n", sink);
+  return 0;
+}
@@ -81,15 +81,20 @@ int main(int argc, const char* argv[])
       world.add_object(left);
     }
 
+    world.build_hierarchy();
+
     auto from = sunray::create_point(0, 1.5, -7);
     auto to = sunray::create_point(0, 1, 0);
     auto up = sunray::create_vector(0, 1, 0);
     sunray::Camera c{pixels, pixels / 2, sunray::PI / 3.0, sunray::view_transformation(from, to, up)};
-    auto canvas = c.render(world);
+    sunray::RenderStatistics statistics;
+    auto canvas = c.render(world, statistics);
 
     auto end = std::chrono::steady_clock::now();
     std::cout << "Took " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << "ms to process"
               << std::endl;
+    std::cout << "Shadow cache answered " << statistics.shadow_cache_hits_ << " of " << statistics.shadow_rays_
+              << " shadow rays (" << statistics.shadow_cache_hit_rate() * 100.0 << "%)" << std::endl;
 
     start = std::chrono::steady_clock::now();
 
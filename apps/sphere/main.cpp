@@ -52,6 +52,8 @@ int main(int argc, const char* argv[])
                                          trans1.matrix());
     world.add_object(sphere);
 
+    world.build_hierarchy();
+
     sunray::Intersections intersections;
     for (uint32_t y = 0; y < pixels; ++y) {
       const auto world_y = half - pixel_size * y;
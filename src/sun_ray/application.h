@@ -9,10 +9,17 @@
 #include <sun_ray/script/engine.h>
 #include <sun_ray/version.h>
 
+#include <atomic>
+#include <csignal>
 #include <fstream>
 #include <iostream>
+#include <mutex>
+#include <optional>
+#include <thread>
 
 #include "options.h"
+#include "progress_reporter.h"
+#include "synchronized_stream.h"
 
 
 namespace sunray
@@ -36,21 +43,42 @@ namespace sunray
 
       int ret{0};
       try {
-        sunray::script::Engine executor{stream_, error_stream_, opts_.second.format_, opts_.second.dump_};
+        const auto progress = opts_.second.progress_ ? std::make_shared<RenderProgress>() : nullptr;
+        const InterruptGuard interrupt{progress.get()};
+        // The progress is reported by a thread of its own, its lines must not interleave with the errors of the engine
+        std::mutex error_mutex;
+        SynchronizedStream errors{error_stream_, error_mutex};
+        SynchronizedStream progress_errors{error_stream_, error_mutex};
+        const auto processes = start_processes();
+        sunray::script::Engine executor{stream_, errors, opts_.second.format_, opts_.second.dump_,
+                                        opts_.second.threads_, opts_.second.region_, processes,
+                                        opts_.second.frames_, opts_.second.deadline_, progress, opts_.second.affinity_};
 
         for (const auto& file : opts_.second.files_) {
           std::ifstream input_source{file.string()};
           if (input_source.good()) {
-            error_stream_ << "================================================================================\n";
-            error_stream_ << file.string() << ":" << std::endl;
-            error_stream_ << "================================================================================\n\n";
+            errors << "================================================================================\n";
+            errors << file.string() << ":" << std::endl;
+            errors << "================================================================================\n\n";
 
-            if (!executor.process(input_source)) {
-              error_stream_ << "\nfailure!\n\n";
+            std::optional<ProgressReporter> reporter;
+            if (progress) {
+              progress->reset();
+              reporter.emplace(progress_errors, *progress);
+            }
+            const auto processed = executor.process(input_source);
+            reporter.reset();
+            if (!processed) {
+              errors << "\nfailure!\n\n";
+              ret = -1;
+            }
+            if (progress && progress->cancelled()) {
+              errors << "\ncancelled!\n\n";
               ret = -1;
+              break;
             }
           } else {
-            error_stream_ << "Could not open sunray source file " << file.string() << std::endl;
+            errors << "Could not open sunray source file " << file.string() << std::endl;
             ret = -1;
           }
         }
@@ -70,6 +98,75 @@ namespace sunray
     Application& operator=(Application&&) = delete;
 
   private:
+    // Interrupting the application cancels the renders of the progress, their canvases are still written. A second
+    // interrupt terminates the application.
+    class InterruptGuard
+    {
+    public:
+      explicit InterruptGuard(RenderProgress* progress)
+      {
+        if (progress) {
+          interrupted_progress_ = progress;
+          previous_ = std::signal(SIGINT, interrupt);
+        }
+      }
+
+      ~InterruptGuard()
+      {
+        if (interrupted_progress_) {
+          std::signal(SIGINT, previous_);
+          interrupted_progress_ = nullptr;
+        }
+      }
+
+      InterruptGuard(const InterruptGuard&) = delete;
+      InterruptGuard(InterruptGuard&&) = delete;
+      InterruptGuard& operator=(const InterruptGuard&) = delete;
+      InterruptGuard& operator=(InterruptGuard&&) = delete;
+
+    private:
+      static void interrupt(int signal)
+      {
+        if (RenderProgress* progress = interrupted_progress_) {
+          progress->cancel();
+        }
+        std::signal(signal, SIG_DFL);
+      }
+
+      inline static std::atomic<RenderProgress*> interrupted_progress_{nullptr};
+      void (*previous_)(int){SIG_DFL};
+    };
+
+    // The worker processes are started before any thread, they split the render threads among them. The engines of the
+    // coordinating and the worker processes start no threads of their own.
+    DistributedRendererPtr start_processes() const
+    {
+      if (opts_.second.processes_ <= 1) {
+        return nullptr;
+      }
+      const auto threads = opts_.second.threads_ != 0 ? opts_.second.threads_ : std::thread::hardware_concurrency();
+      auto processes = std::make_shared<DistributedRenderer>(opts_.second.processes_, threads / opts_.second.processes_,
+                                                             opts_.second.affinity_);
+      processes->start([this, &processes](DistributedRenderer&) {
+        work(processes);
+      });
+      return processes;
+    }
+
+    // A worker process runs the same scripts as the coordinating process, to render the tiles of its images. Its output
+    // and diagnostics are dropped, an exception ends the worker.
+    void work(const DistributedRendererPtr& processes) const
+    {
+      std::ostream dropped{nullptr};
+      sunray::script::Engine executor{dropped, dropped, false, false, 0, opts_.second.region_, processes};
+      for (const auto& file : opts_.second.files_) {
+        std::ifstream input_source{file.string()};
+        if (input_source.good()) {
+          executor.process(input_source);
+        }
+      }
+    }
+
     void print_copy_right()
     {
       error_stream_ << fmt::format("SunRay ray tracer {}\n{}\n\n", SUNRAY_VERSION_STRING, SUNRAY_COPYRIGHT);
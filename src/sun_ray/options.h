@@ -6,9 +6,16 @@
 //  Copyright © 2020 Lars-Christian Fürstenberg. All rights reserved.
 //
 
+#include <sun_ray/feature/cpu_topology.h>
+#include <sun_ray/feature/tile_scheduler.h>
 #include <sun_ray/script/format_helper.h>
 
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <chrono>
 #include <filesystem>
+#include <optional>
 #include <ostream>
 #include <vector>
 
@@ -18,13 +25,20 @@ namespace sunray
   struct Options {
     static void print_usage(std::ostream& stream)
     {
-      auto help = R"(Usage: sun_ray [ --help ] | [ [-df] <FILE> [<FILE>]... ]
+      auto help = R"(Usage: sun_ray [ --help ] | [ [-dfs] [-t <THREADS>] [-c <POLICY>] [-p <PROCESSES>] [-a <FRAMES>] [-l <MILLISECONDS>] [-r <X,Y,WIDTH,HEIGHT>] <FILE> [<FILE>]... ]
 help:
   --help                              display this help and exit
 
 processing options:
   -d, --dump                          dump instructions
   -f, --format                        format the program
+  -s, --progress                      print the progress of the renders, interrupting cancels them
+  -t, --threads <THREADS>             number of render threads, defaults to the number of hardware threads
+  -c, --affinity <POLICY>             pin the render threads: none, compact or scatter, defaults to none
+  -p, --processes <PROCESSES>         number of render processes sharing the threads, defaults to 1
+  -a, --frames <FRAMES>               number of animation frames rendered at the same time, defaults to 1
+  -l, --deadline <MILLISECONDS>       lower the quality of every frame to render it in time
+  -r, --region <X,Y,WIDTH,HEIGHT>     render only this rectangle of pixels and patch it into existing images
   <FILE>                              script to execute
 )";
       stream << help << std::endl;
@@ -53,6 +67,37 @@ processing options:
             error = true;
           }
           opts.dump_ = true;
+        } else if (option == "-s" || option == "--progress") {
+          if (start_untagged_options) {
+            error = true;
+          }
+          opts.progress_ = true;
+        } else if (option == "-t" || option == "--threads") {
+          if (start_untagged_options || n + 1 == args.size() || !parse_count(args[++n], opts.threads_)) {
+            error = true;
+          }
+        } else if (option == "-c" || option == "--affinity") {
+          if (start_untagged_options || n + 1 == args.size() || !parse_affinity(args[++n], opts.affinity_)) {
+            error = true;
+          }
+        } else if (option == "-p" || option == "--processes") {
+          if (start_untagged_options || n + 1 == args.size() || !parse_count(args[++n], opts.processes_)) {
+            error = true;
+          }
+        } else if (option == "-a" || option == "--frames") {
+          if (start_untagged_options || n + 1 == args.size() || !parse_count(args[++n], opts.frames_)) {
+            error = true;
+          }
+        } else if (option == "-l" || option == "--deadline") {
+          uint32_t milliseconds{0};
+          if (start_untagged_options || n + 1 == args.size() || !parse_count(args[++n], milliseconds, 7)) {
+            error = true;
+          }
+          opts.deadline_ = std::chrono::milliseconds{milliseconds};
+        } else if (option == "-r" || option == "--region") {
+          if (start_untagged_options || n + 1 == args.size() || !parse_region(args[++n], opts.region_)) {
+            error = true;
+          }
         } else if (option == "-h" || option == "--help") {
           error = true;
         } else if (option[0] == '-') {
@@ -74,6 +119,62 @@ processing options:
 
     bool dump_{false};
     bool format_{false};
+    bool progress_{false};
+    uint32_t threads_{0};
+    AffinityPolicy affinity_{AffinityPolicy::none};
+    uint32_t processes_{1};
+    uint32_t frames_{1};
+    std::chrono::milliseconds deadline_{0};
+    std::optional<Tile> region_;
     std::vector<std::filesystem::path> files_;
+
+  private:
+    static bool parse_count(const std::string& value, uint32_t& count, size_t max_digits = 4)
+    {
+      const auto is_number = std::all_of(value.begin(), value.end(), [](unsigned char c) {
+        return std::isdigit(c) != 0;
+      });
+      if (value.empty() || value.size() > max_digits || !is_number) {
+        return false;
+      }
+      count = static_cast<uint32_t>(std::stoul(value));
+      return count > 0;
+    }
+
+    static bool parse_affinity(const std::string& value, AffinityPolicy& affinity)
+    {
+      try {
+        affinity = affinity_policy(value);
+        return true;
+      } catch (const std::invalid_argument&) {
+        return false;
+      }
+    }
+
+    static bool parse_region(const std::string& value, std::optional<Tile>& region)
+    {
+      std::array<uint32_t, 4> numbers{};
+      size_t start{0};
+      for (size_t n = 0; n < numbers.size(); ++n) {
+        const auto end = n + 1 < numbers.size() ? value.find(',', start) : value.size();
+        if (end == std::string::npos) {
+          return false;
+        }
+        const auto number = value.substr(start, end - start);
+        const auto is_number = std::all_of(number.begin(), number.end(), [](unsigned char c) {
+          return std::isdigit(c) != 0;
+        });
+        if (number.empty() || number.size() > 6 || !is_number) {
+          return false;
+        }
+        numbers[n] = static_cast<uint32_t>(std::stoul(number));
+        start = end + 1;
+      }
+      if (numbers[2] == 0 || numbers[3] == 0) {
+        return false;
+      }
+      region = Tile{numbers[0], numbers[1], numbers[2], numbers[3]};
+      return true;
+    }
   };
 }
@@ -0,0 +1,85 @@
+//
+//  progress_reporter.h
+//  sun_ray
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#include <sun_ray/feature/render_progress.h>
+
+#include <fmt/format.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+
+namespace sunray
+{
+  // Prints the progress of the renders in a thread of its own, whenever tiles have been done since the last line. The last
+  // line is printed, when the reporter is destroyed.
+  class ProgressReporter
+  {
+  public:
+    ProgressReporter(std::ostream& stream, const RenderProgress& progress,
+                     std::chrono::milliseconds interval = std::chrono::milliseconds{1000})
+    : stream_{stream}
+    , progress_{progress}
+    {
+      thread_ = std::thread{[this, interval]() {
+        std::unique_lock<std::mutex> lock{mutex_};
+        while (!stopped_.wait_for(lock, interval, [this]() {
+          return stop_;
+        })) {
+          report();
+        }
+        report();
+      }};
+    }
+
+    ~ProgressReporter()
+    {
+      {
+        std::lock_guard<std::mutex> lock{mutex_};
+        stop_ = true;
+      }
+      stopped_.notify_all();
+      thread_.join();
+    }
+
+    ProgressReporter(const ProgressReporter&) = delete;
+    ProgressReporter(ProgressReporter&&) = delete;
+    ProgressReporter& operator=(const ProgressReporter&) = delete;
+    ProgressReporter& operator=(ProgressReporter&&) = delete;
+
+    // e.g. "progress: 42% (108/256 tiles) 1.23 Mrays/s", counting the camera rays
+    static std::string line(const RenderProgress& progress)
+    {
+      return fmt::format("progress: {:.0f}% ({}/{} tiles) {:.2f} Mrays/s{}", progress.fraction() * 100.0,
+                         progress.tiles_done(), progress.tiles_total(), progress.samples_per_second() / 1e6,
+                         progress.cancelled() ? " cancelled" : "");
+    }
+
+  private:
+    void report()
+    {
+      const auto tiles_done = progress_.tiles_done();
+      if (tiles_done != reported_tiles_) {
+        reported_tiles_ = tiles_done;
+        stream_ << line(progress_) << std::endl;
+      }
+    }
+
+    std::ostream& stream_;
+    const RenderProgress& progress_;
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable stopped_;
+    uint64_t reported_tiles_{0};
+    bool stop_{false};
+  };
+}
@@ -0,0 +1,112 @@
+//
+//  synchronized_stream.h
+//  sun_ray
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#pragma once
+
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+
+namespace sunray
+{
+  // Collects the characters written to a stream and passes complete lines on to the buffer of the target stream, while
+  // holding the mutex shared by all writers of the target
+  class LineBuffer : public std::streambuf
+  {
+  public:
+    LineBuffer(std::streambuf& target, std::mutex& mutex)
+    : target_{target}
+    , mutex_{mutex}
+    {
+    }
+
+    ~LineBuffer() override
+    {
+      write(line_.size());
+    }
+
+    LineBuffer(const LineBuffer&) = delete;
+    LineBuffer(LineBuffer&&) = delete;
+    LineBuffer& operator=(const LineBuffer&) = delete;
+    LineBuffer& operator=(LineBuffer&&) = delete;
+
+  protected:
+    int_type overflow(int_type c) override
+    {
+      if (!traits_type::eq_int_type(c, traits_type::eof())) {
+        const auto character = traits_type::to_char_type(c);
+        xsputn(&character, 1);
+      }
+      return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize count) override
+    {
+      line_.append(s, static_cast<size_t>(count));
+      const auto end_of_line = line_.rfind('\n');
+      if (end_of_line != std::string::npos) {
+        write(end_of_line + 1);
+      }
+      return count;
+    }
+
+    // Flushing passes on an incomplete line as well
+    int sync() override
+    {
+      write(line_.size());
+      std::lock_guard<std::mutex> lock{mutex_};
+      return target_.pubsync();
+    }
+
+  private:
+    void write(size_t count)
+    {
+      if (count == 0) {
+        return;
+      }
+      {
+        std::lock_guard<std::mutex> lock{mutex_};
+        target_.sputn(line_.data(), static_cast<std::streamsize>(count));
+      }
+      line_.erase(0, count);
+    }
+
+    std::streambuf& target_;
+    std::mutex& mutex_;
+    std::string line_;
+  };
+
+
+  // Stream of a single thread writing to a stream shared with other threads. Every thread writes through a
+  // SynchronizedStream of its own, all of them with the same mutex, so that their lines do not interleave.
+  class SynchronizedStream : public std::ostream
+  {
+  public:
+    SynchronizedStream(std::ostream& target, std::mutex& mutex)
+    : std::ostream{nullptr}
+    , buffer_{*target.rdbuf(), mutex}
+    {
+      rdbuf(&buffer_);
+    }
+
+    ~SynchronizedStream() override
+    {
+      flush();
+    }
+
+    SynchronizedStream(const SynchronizedStream&) = delete;
+    SynchronizedStream(SynchronizedStream&&) = delete;
+    SynchronizedStream& operator=(const SynchronizedStream&) = delete;
+    SynchronizedStream& operator=(SynchronizedStream&&) = delete;
+
+  private:
+    LineBuffer buffer_;
+  };
+}
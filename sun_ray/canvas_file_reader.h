@@ -0,0 +1,63 @@
+//
+//  canvas_file_reader.h
+//  sun_ray
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#pragma once
+
+#include <sun_ray/feature/canvas.h>
+#include <sun_ray/image.h>
+#include <sun_ray/script/format_helper.h>
+
+#include <filesystem>
+#include <memory>
+
+
+namespace sunray
+{
+  // Reads an image file written by the CanvasFileWriter, which is any format stb_image is able to load
+  class CanvasFileReader
+  {
+  public:
+    explicit CanvasFileReader(std::filesystem::path path)
+    : path_{std::move(path)}
+    {
+    }
+
+    ~CanvasFileReader() = default;
+
+    CanvasFileReader(const CanvasFileReader&) = delete;
+    CanvasFileReader(CanvasFileReader&&) = delete;
+    CanvasFileReader& operator=(const CanvasFileReader&) = delete;
+    CanvasFileReader& operator=(CanvasFileReader&&) = delete;
+
+    Canvas read() const
+    {
+      constexpr int channels = 3;
+      int width{0};
+      int height{0};
+      int channels_in_file{0};
+      std::unique_ptr<stbi_uc, decltype(&stbi_image_free)> data{
+        stbi_load(path_.string().c_str(), &width, &height, &channels_in_file, channels), stbi_image_free};
+      if (!data) {
+        throw std::runtime_error{fmt::format("Cannot read canvas from file '{}'", path_.string())};
+      }
+
+      Canvas canvas{static_cast<uint32_t>(width), static_cast<uint32_t>(height)};
+      const auto* pixel = data.get();
+      for (uint32_t y = 0; y < canvas.height(); ++y) {
+        for (uint32_t x = 0; x < canvas.width(); ++x) {
+          canvas.pixel_at(x, y, Color{pixel[0] / 255.0f, pixel[1] / 255.0f, pixel[2] / 255.0f});
+          pixel += channels;
+        }
+      }
+      return canvas;
+    }
+
+  private:
+    std::filesystem::path path_;
+  };
+}
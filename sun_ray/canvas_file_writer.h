@@ -36,6 +36,25 @@ namespace sunray
     CanvasFileWriter& operator=(CanvasFileWriter&&) = delete;
 
     void write(const Canvas& canvas) const
+    {
+      const auto writer = make_writer();
+      const auto path = file_path(*writer);
+      std::ofstream of(path, std::ofstream::out | std::ios::binary);
+      if (!of.good()) {
+        throw std::runtime_error{fmt::format("Cannot write canvas to file ''", path_.string())};
+      }
+      writer->write(canvas, of);
+      of.close();
+    }
+
+    // Path of the written file, which gets the extension of the format, if it has none
+    std::filesystem::path path() const
+    {
+      return file_path(*make_writer());
+    }
+
+  private:
+    std::unique_ptr<sunray::CanvasWriter> make_writer() const
     {
       std::unique_ptr<sunray::CanvasWriter> writer;
       switch (format_) {
@@ -49,20 +68,18 @@ namespace sunray
           writer.reset(new sunray::CanvasPNGWriter);
           break;
       }
+      return writer;
+    }
 
+    std::filesystem::path file_path(const sunray::CanvasWriter& writer) const
+    {
       auto path = path_;
       if (path.extension().empty()) {
-        path += writer->extension();
+        path += writer.extension();
       }
-      std::ofstream of(path, std::ofstream::out | std::ios::binary);
-      if (!of.good()) {
-        throw std::runtime_error{fmt::format("Cannot write canvas to file ''", path_.string())};
-      }
-      writer->write(canvas, of);
-      of.close();
+      return path;
     }
 
-  private:
     ImageFormat format_;
     std::filesystem::path path_;
   };
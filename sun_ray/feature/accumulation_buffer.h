@@ -0,0 +1,138 @@
+//
+//  accumulation_buffer.h
+//  sun_ray
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#pragma once
+
+#include <sun_ray/feature/canvas.h>
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace sunray
+{
+  // Sums up several weighted samples per pixel. Besides the color, the running mean and variance of the luminance of the
+  // samples is kept, so that the noise of a pixel can be estimated while rendering. Different pixels can be written by
+  // different threads at the same time, a single pixel must be written by one thread only.
+  class AccumulationBuffer
+  {
+  public:
+    AccumulationBuffer(uint32_t width, uint32_t height)
+    : width_{width}
+    , height_{height}
+    , pixels_(static_cast<size_t>(width) * height)
+    {
+    }
+
+    ~AccumulationBuffer() = default;
+
+    AccumulationBuffer(const AccumulationBuffer&) = delete;
+    AccumulationBuffer(AccumulationBuffer&&) = default;
+    AccumulationBuffer& operator=(const AccumulationBuffer&) = delete;
+    AccumulationBuffer& operator=(AccumulationBuffer&&) = delete;
+
+    inline uint32_t width() const
+    {
+      return width_;
+    }
+
+    inline uint32_t height() const
+    {
+      return height_;
+    }
+
+    void add(uint32_t x, uint32_t y, const Color& color, float weight = 1.0f)
+    {
+      auto& pixel = pixels_[index(x, y)];
+      pixel.red_ += color.red() * weight;
+      pixel.green_ += color.green() * weight;
+      pixel.blue_ += color.blue() * weight;
+      pixel.weight_ += weight;
+
+      // Welford's online algorithm keeps the variance numerically stable
+      ++pixel.samples_;
+      const auto value = luminance(color);
+      const auto delta = value - pixel.mean_;
+      pixel.mean_ += delta / pixel.samples_;
+      pixel.m2_ += delta * (value - pixel.mean_);
+    }
+
+    inline uint32_t samples(uint32_t x, uint32_t y) const
+    {
+      return pixels_[index(x, y)].samples_;
+    }
+
+    // Estimated standard error of the mean luminance of the pixel, infinite while there are less than two samples
+    double standard_error(uint32_t x, uint32_t y) const
+    {
+      const auto& pixel = pixels_[index(x, y)];
+      if (pixel.samples_ < 2) {
+        return std::numeric_limits<double>::infinity();
+      }
+      return std::sqrt(pixel.m2_ / (pixel.samples_ - 1) / pixel.samples_);
+    }
+
+    Color color_at(uint32_t x, uint32_t y) const
+    {
+      const auto& pixel = pixels_[index(x, y)];
+      if (pixel.weight_ <= 0.0f) {
+        return Color{0, 0, 0};
+      }
+      return Color{pixel.red_ / pixel.weight_, pixel.green_ / pixel.weight_, pixel.blue_ / pixel.weight_};
+    }
+
+    // Canvas of the current state. A pixel without samples takes the color of the closest sampled pixel on the left and top
+    // in a block of 2, 4 or 8 pixels, which fills the gaps of a coarse preview.
+    Canvas canvas() const
+    {
+      Canvas canvas{width_, height_};
+      for (uint32_t y = 0; y < height_; ++y) {
+        for (uint32_t x = 0; x < width_; ++x) {
+          auto sx = x;
+          auto sy = y;
+          for (uint32_t mask = ~uint32_t{1}; samples(sx, sy) == 0 && mask >= ~uint32_t{7}; mask <<= 1) {
+            sx = x & mask;
+            sy = y & mask;
+          }
+          canvas.pixel_at(x, y, color_at(sx, sy));
+        }
+      }
+      return canvas;
+    }
+
+    static double luminance(const Color& color)
+    {
+      return 0.2126 * color.red() + 0.7152 * color.green() + 0.0722 * color.blue();
+    }
+
+  private:
+    struct Pixel {
+      float red_{0.0f};
+      float green_{0.0f};
+      float blue_{0.0f};
+      float weight_{0.0f};
+      double mean_{0.0};
+      double m2_{0.0};
+      uint32_t samples_{0};
+    };
+
+    size_t index(uint32_t x, uint32_t y) const
+    {
+      if (x >= width_ || y >= height_) {
+        throw std::out_of_range{"pixel " + std::to_string(x) + "," + std::to_string(y) + " is out of range"};
+      }
+      return static_cast<size_t>(y) * width_ + x;
+    }
+
+    uint32_t width_{0};
+    uint32_t height_{0};
+    std::vector<Pixel> pixels_;
+  };
+}
@@ -0,0 +1,160 @@
+//
+//  affine_transform.h
+//  sun_ray
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#pragma once
+
+#include <sun_ray/feature/matrix.h>
+#include <sun_ray/feature/ray.h>
+
+#include <array>
+#include <cmath>
+#include <cstring>
+
+
+namespace sunray
+{
+  // The kinds of transformations, from the cheapest to the most expensive to apply
+  enum class TransformKind {
+    identity,
+    translate,
+    // Scales along the axes, uniformly or not, and translates
+    translate_scale,
+    // Any composition of translations, scalings, rotations and shearings
+    affine,
+    // Bottom row other than 0, 0, 0, 1, which the 3x4 matrix cannot represent
+    general
+  };
+
+
+  // The upper three rows of a transformation matrix together with its kind, which selects the cheapest way to apply it.
+  // The kind is read from the exact zeros and ones of the matrix, so a rotation by 90 degrees with rounding errors in its
+  // zeros is affine.
+  class AffineTransform
+  {
+  public:
+    static constexpr uint8_t elements = 12;
+    using Mat = std::array<Real, elements>;
+
+    explicit AffineTransform(const Matrix44& matrix)
+    : kind_{classify(matrix)}
+    {
+      for (uint8_t n = 0; n < elements; ++n) {
+        m_[n] = matrix[n];
+      }
+    }
+
+    ~AffineTransform() = default;
+
+    AffineTransform(const AffineTransform&) = default;
+    AffineTransform(AffineTransform&&) = default;
+    AffineTransform& operator=(const AffineTransform&) = delete;
+    AffineTransform& operator=(AffineTransform&&) = delete;
+
+    // The transposed upper 3x3 matrix without translation, which turns normals in object space into world space when
+    // made from the inverse transformation
+    static AffineTransform normal_matrix(const Matrix44& inverse)
+    {
+      // clang-format off
+      return AffineTransform{Matrix44{{ inverse[0], inverse[4], inverse[8], 0,
+                                        inverse[1], inverse[5], inverse[9], 0,
+                                        inverse[2], inverse[6], inverse[10], 0,
+                                        0, 0, 0, 1 }}};
+      // clang-format on
+    }
+
+    inline TransformKind kind() const
+    {
+      return kind_;
+    }
+
+    Real operator[](uint8_t n) const
+    {
+      return m_.at(n);
+    }
+
+    // Points are moved by the translation, vectors are not. A general transformation applies the upper three rows only
+    // and keeps w, it is up to the caller to use the full matrix instead.
+    friend Tuple operator*(const AffineTransform& lhs, const Tuple& rhs)
+    {
+      const Real* m = lhs.m_.data();
+      const Real x = rhs.x();
+      const Real y = rhs.y();
+      const Real z = rhs.z();
+      const Real w = rhs.w();
+      switch (lhs.kind_) {
+        case TransformKind::identity:
+          return rhs;
+        case TransformKind::translate:
+          return Tuple{x + m[3] * w, y + m[7] * w, z + m[11] * w, w};
+        case TransformKind::translate_scale:
+          return Tuple{m[0] * x + m[3] * w, m[5] * y + m[7] * w, m[10] * z + m[11] * w, w};
+        default:
+          return Tuple{m[0] * x + m[1] * y + m[2] * z + m[3] * w, m[4] * x + m[5] * y + m[6] * z + m[7] * w,
+                       m[8] * x + m[9] * y + m[10] * z + m[11] * w, w};
+      }
+    }
+
+    // Selects the kind once for the origin and the direction. The origin of a ray is a point and its direction a vector,
+    // which is not translated.
+    Ray transform(const Ray& ray) const
+    {
+      const auto& o = ray.origin();
+      const auto& d = ray.direction();
+      const Real* m = m_.data();
+      switch (kind_) {
+        case TransformKind::identity:
+          return Ray{create_point(o.x(), o.y(), o.z()), create_vector(d.x(), d.y(), d.z())};
+        case TransformKind::translate:
+          return Ray{create_point(o.x() + m[3], o.y() + m[7], o.z() + m[11]), create_vector(d.x(), d.y(), d.z())};
+        case TransformKind::translate_scale:
+          return Ray{create_point(m[0] * o.x() + m[3], m[5] * o.y() + m[7], m[10] * o.z() + m[11]),
+                     create_vector(m[0] * d.x(), m[5] * d.y(), m[10] * d.z())};
+        default:
+          return Ray{create_point(m[0] * o.x() + m[1] * o.y() + m[2] * o.z() + m[3],
+                                  m[4] * o.x() + m[5] * o.y() + m[6] * o.z() + m[7],
+                                  m[8] * o.x() + m[9] * o.y() + m[10] * o.z() + m[11]),
+                     create_vector(m[0] * d.x() + m[1] * d.y() + m[2] * d.z(), m[4] * d.x() + m[5] * d.y() + m[6] * d.z(),
+                                   m[8] * d.x() + m[9] * d.y() + m[10] * d.z())};
+      }
+    }
+
+    static TransformKind classify(const Matrix44& matrix)
+    {
+      if (!matrix.is_affine()) {
+        return TransformKind::general;
+      }
+      if (!is_zero(matrix[1]) || !is_zero(matrix[2]) || !is_zero(matrix[4]) || !is_zero(matrix[6]) ||
+          !is_zero(matrix[8]) || !is_zero(matrix[9])) {
+        return TransformKind::affine;
+      }
+      if (!is_one(matrix[0]) || !is_one(matrix[5]) || !is_one(matrix[10])) {
+        return TransformKind::translate_scale;
+      }
+      if (!is_zero(matrix[3]) || !is_zero(matrix[7]) || !is_zero(matrix[11])) {
+        return TransformKind::translate;
+      }
+      return TransformKind::identity;
+    }
+
+  private:
+    // Either sign of zero
+    static bool is_zero(Real value)
+    {
+      return std::fpclassify(value) == FP_ZERO;
+    }
+
+    static bool is_one(Real value)
+    {
+      static constexpr Real one{1.0};
+      return memcmp(&value, &one, sizeof(one)) == 0;
+    }
+
+    Mat m_{};
+    TransformKind kind_;
+  };
+}
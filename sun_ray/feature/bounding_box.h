@@ -0,0 +1,176 @@
+//
+//  bounding_box.h
+//  sun_ray
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#pragma once
+
+#include <sun_ray/feature/matrix.h>
+#include <sun_ray/feature/tuple.h>
+
+#include <algorithm>
+#include <limits>
+#include <ostream>
+
+
+namespace sunray
+{
+  class BoundingBox
+  {
+  public:
+    BoundingBox() = default;
+
+    BoundingBox(Point minimum, Point maximum)
+    : minimum_{std::move(minimum)}
+    , maximum_{std::move(maximum)}
+    {
+    }
+
+    ~BoundingBox() = default;
+
+    BoundingBox(const BoundingBox&) = default;
+    BoundingBox(BoundingBox&&) = default;
+    BoundingBox& operator=(const BoundingBox&) = default;
+    BoundingBox& operator=(BoundingBox&&) = default;
+
+    static BoundingBox infinite()
+    {
+      static constexpr Real inf = std::numeric_limits<Real>::infinity();
+      return BoundingBox{create_point(-inf, -inf, -inf), create_point(inf, inf, inf)};
+    }
+
+    friend bool operator==(const BoundingBox& lhs, const BoundingBox& rhs)
+    {
+      return lhs.minimum_ == rhs.minimum_ && lhs.maximum_ == rhs.maximum_;
+    }
+
+    inline const Point& minimum() const
+    {
+      return minimum_;
+    }
+
+    inline const Point& maximum() const
+    {
+      return maximum_;
+    }
+
+    bool is_empty() const
+    {
+      return minimum_.x() > maximum_.x() || minimum_.y() > maximum_.y() || minimum_.z() > maximum_.z();
+    }
+
+    bool is_bounded() const
+    {
+      return !is_empty() && std::isfinite(minimum_.x()) && std::isfinite(minimum_.y()) && std::isfinite(minimum_.z()) &&
+             std::isfinite(maximum_.x()) && std::isfinite(maximum_.y()) && std::isfinite(maximum_.z());
+    }
+
+    void add(const Point& point)
+    {
+      minimum_ = create_point(std::min(minimum_.x(), point.x()), std::min(minimum_.y(), point.y()),
+                              std::min(minimum_.z(), point.z()));
+      maximum_ = create_point(std::max(maximum_.x(), point.x()), std::max(maximum_.y(), point.y()),
+                              std::max(maximum_.z(), point.z()));
+    }
+
+    void add(const BoundingBox& box)
+    {
+      if (!box.is_empty()) {
+        add(box.minimum_);
+        add(box.maximum_);
+      }
+    }
+
+    bool contains(const Point& point) const
+    {
+      return minimum_.x() <= point.x() && point.x() <= maximum_.x() && minimum_.y() <= point.y() && point.y() <= maximum_.y() &&
+             minimum_.z() <= point.z() && point.z() <= maximum_.z();
+    }
+
+    bool contains(const BoundingBox& box) const
+    {
+      return contains(box.minimum_) && contains(box.maximum_);
+    }
+
+    Point centroid() const
+    {
+      return create_point((minimum_.x() + maximum_.x()) * Real{0.5}, (minimum_.y() + maximum_.y()) * Real{0.5},
+                          (minimum_.z() + maximum_.z()) * Real{0.5});
+    }
+
+    Real surface_area() const
+    {
+      if (is_empty()) {
+        return 0.0;
+      }
+      const auto extent = maximum_ - minimum_;
+      return 2 * (extent.x() * extent.y() + extent.y() * extent.z() + extent.z() * extent.x());
+    }
+
+    uint8_t largest_axis() const
+    {
+      const auto extent = maximum_ - minimum_;
+      if (extent.x() >= extent.y() && extent.x() >= extent.z()) {
+        return 0;
+      }
+      return extent.y() >= extent.z() ? 1 : 2;
+    }
+
+    BoundingBox transform(const Matrix44& matrix) const
+    {
+      if (is_empty()) {
+        return BoundingBox{};
+      }
+      if (!is_bounded()) {
+        return infinite();
+      }
+
+      BoundingBox box;
+      box.add(matrix * create_point(minimum_.x(), minimum_.y(), minimum_.z()));
+      box.add(matrix * create_point(minimum_.x(), minimum_.y(), maximum_.z()));
+      box.add(matrix * create_point(minimum_.x(), maximum_.y(), minimum_.z()));
+      box.add(matrix * create_point(minimum_.x(), maximum_.y(), maximum_.z()));
+      box.add(matrix * create_point(maximum_.x(), minimum_.y(), minimum_.z()));
+      box.add(matrix * create_point(maximum_.x(), minimum_.y(), maximum_.z()));
+      box.add(matrix * create_point(maximum_.x(), maximum_.y(), minimum_.z()));
+      box.add(matrix * create_point(maximum_.x(), maximum_.y(), maximum_.z()));
+      return box;
+    }
+
+    // Slab test against a ray given by its origin and the reciprocal of its direction. Only the part of the ray between
+    // 0 and max_t is considered. NaNs resulting from rays lying in a slab plane are ignored by the comparisons.
+    bool intersects(const Point& origin, const Vector& inverse_direction, Real max_t) const
+    {
+      Real t_min = 0.0;
+      Real t_max = max_t;
+      for (uint8_t axis = 0; axis < 3; ++axis) {
+        auto t0 = (minimum_[axis] - origin[axis]) * inverse_direction[axis];
+        auto t1 = (maximum_[axis] - origin[axis]) * inverse_direction[axis];
+        if (t0 > t1) {
+          std::swap(t0, t1);
+        }
+        t_min = t0 > t_min ? t0 : t_min;
+        t_max = t1 < t_max ? t1 : t_max;
+        if (t_min > t_max) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    friend std::ostream& operator<<(std::ostream& stream, const BoundingBox& box)
+    {
+      stream << "minimum: " << box.minimum() << " maximum: " << box.maximum();
+      return stream;
+    }
+
+  private:
+    Point minimum_{create_point(std::numeric_limits<Real>::infinity(), std::numeric_limits<Real>::infinity(),
+                                std::numeric_limits<Real>::infinity())};
+    Point maximum_{create_point(-std::numeric_limits<Real>::infinity(), -std::numeric_limits<Real>::infinity(),
+                                -std::numeric_limits<Real>::infinity())};
+  };
+}
@@ -0,0 +1,258 @@
+//
+//  bvh.h
+//  sun_ray
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#pragma once
+
+#include <sun_ray/feature/bounding_box.h>
+#include <sun_ray/feature/ray.h>
+
+#include <array>
+#include <numeric>
+#include <vector>
+
+
+namespace sunray
+{
+  // Bounding volume hierarchy over an arbitrary set of primitives, which are identified by their index into the bounding
+  // box list given at construction. The tree is built top down using a binned surface area heuristic and stored as a
+  // flat array in depth first order, i.e. the left child of an inner node always directly follows its parent.
+  class Bvh
+  {
+  public:
+    static constexpr uint32_t default_leaf_size = 4;
+
+    Bvh() = default;
+
+    explicit Bvh(const std::vector<BoundingBox>& bounds, uint32_t maximum_leaf_size = default_leaf_size)
+    : maximum_leaf_size_{std::max(maximum_leaf_size, uint32_t{1})}
+    {
+      if (bounds.empty()) {
+        return;
+      }
+
+      indices_.resize(bounds.size());
+      std::iota(indices_.begin(), indices_.end(), 0);
+
+      std::vector<Point> centroids;
+      centroids.reserve(bounds.size());
+      for (const auto& box : bounds) {
+        centroids.emplace_back(box.centroid());
+      }
+
+      nodes_.reserve(2 * bounds.size());
+      build(bounds, centroids, 0, static_cast<uint32_t>(bounds.size()), 0);
+    }
+
+    ~Bvh() = default;
+
+    Bvh(const Bvh&) = delete;
+    Bvh(Bvh&&) = default;
+    Bvh& operator=(const Bvh&) = delete;
+    Bvh& operator=(Bvh&&) = default;
+
+    bool empty() const
+    {
+      return nodes_.empty();
+    }
+
+    size_t size() const
+    {
+      return indices_.size();
+    }
+
+    size_t node_count() const
+    {
+      return nodes_.size();
+    }
+
+    const BoundingBox& bounds() const
+    {
+      static const BoundingBox empty_box;
+      return nodes_.empty() ? empty_box : nodes_.front().bounds_;
+    }
+
+    // Calls visitor with the index of every primitive whose leaf box is hit by the ray. Children are visited front to
+    // back with respect to the ray direction.
+    template<typename Visitor>
+    void traverse(const Ray& ray, Visitor&& visitor) const
+    {
+      walk(ray, std::numeric_limits<Real>::infinity(), [&visitor](uint32_t index) {
+        visitor(index);
+        return false;
+      });
+    }
+
+    // Calls predicate with the index of every primitive whose leaf box is hit by the ray before max_t, until the predicate
+    // returns true for one of them. Returns whether such a primitive has been found.
+    template<typename Predicate>
+    bool any_of(const Ray& ray, Real max_t, Predicate&& predicate) const
+    {
+      return walk(ray, max_t, std::forward<Predicate>(predicate));
+    }
+
+  private:
+    static constexpr uint32_t bin_count = 16;
+    // keeps the traversal stack from overflowing, as it holds at most one entry per level
+    static constexpr uint32_t maximum_depth = 63;
+
+    struct Node {
+      BoundingBox bounds_;
+      // leaf: index of the first primitive in indices_, inner node: index of the right child
+      uint32_t offset_{0};
+      // number of primitives of a leaf, 0 for inner nodes
+      uint32_t count_{0};
+      uint8_t axis_{0};
+    };
+
+    struct Bin {
+      BoundingBox bounds_;
+      uint32_t count_{0};
+    };
+
+    uint32_t build(const std::vector<BoundingBox>& bounds, const std::vector<Point>& centroids, uint32_t from, uint32_t to,
+                   uint32_t depth)
+    {
+      const auto node_index = static_cast<uint32_t>(nodes_.size());
+      nodes_.emplace_back();
+
+      BoundingBox node_bounds;
+      BoundingBox centroid_bounds;
+      for (auto n = from; n < to; ++n) {
+        node_bounds.add(bounds[indices_[n]]);
+        centroid_bounds.add(centroids[indices_[n]]);
+      }
+      nodes_[node_index].bounds_ = node_bounds;
+
+      const auto count = to - from;
+      const auto axis = centroid_bounds.largest_axis();
+      const auto axis_min = centroid_bounds.minimum()[axis];
+      const auto axis_extent = centroid_bounds.maximum()[axis] - axis_min;
+
+      if (count <= maximum_leaf_size_ || axis_extent <= 0.0 || depth >= maximum_depth) {
+        make_leaf(node_index, from, count);
+        return node_index;
+      }
+
+      std::array<Bin, bin_count> bins;
+      const auto bin_of = [&](uint32_t index) {
+        auto bin = static_cast<uint32_t>(bin_count * ((centroids[index][axis] - axis_min) / axis_extent));
+        return std::min(bin, bin_count - 1);
+      };
+      for (auto n = from; n < to; ++n) {
+        auto& bin = bins[bin_of(indices_[n])];
+        bin.bounds_.add(bounds[indices_[n]]);
+        ++bin.count_;
+      }
+
+      // Sweep the bins from both sides to evaluate the cost of every possible split plane
+      std::array<Real, bin_count - 1> right_area;
+      std::array<uint32_t, bin_count - 1> right_count;
+      BoundingBox accumulated;
+      uint32_t accumulated_count{0};
+      for (auto n = bin_count - 1; n > 0; --n) {
+        accumulated.add(bins[n].bounds_);
+        accumulated_count += bins[n].count_;
+        right_area[n - 1] = accumulated.surface_area();
+        right_count[n - 1] = accumulated_count;
+      }
+
+      accumulated = BoundingBox{};
+      accumulated_count = 0;
+      uint32_t best_split{0};
+      Real best_cost{std::numeric_limits<Real>::infinity()};
+      for (uint32_t n = 0; n < bin_count - 1; ++n) {
+        accumulated.add(bins[n].bounds_);
+        accumulated_count += bins[n].count_;
+        if (accumulated_count == 0 || right_count[n] == 0) {
+          continue;
+        }
+        const auto cost = accumulated.surface_area() * static_cast<Real>(accumulated_count) +
+                          right_area[n] * static_cast<Real>(right_count[n]);
+        if (cost < best_cost) {
+          best_cost = cost;
+          best_split = n;
+        }
+      }
+
+      const auto parent_area = node_bounds.surface_area();
+      const auto leaf_cost = static_cast<Real>(count);
+      const auto split_cost = parent_area > 0.0 ? traversal_cost + best_cost / parent_area : leaf_cost;
+      if (!std::isfinite(best_cost) || split_cost >= leaf_cost) {
+        make_leaf(node_index, from, count);
+        return node_index;
+      }
+
+      auto middle = std::partition(indices_.begin() + from, indices_.begin() + to, [&](uint32_t index) {
+        return bin_of(index) <= best_split;
+      });
+      const auto split = static_cast<uint32_t>(middle - indices_.begin());
+
+      build(bounds, centroids, from, split, depth + 1);
+      const auto right = build(bounds, centroids, split, to, depth + 1);
+      nodes_[node_index].offset_ = right;
+      nodes_[node_index].axis_ = axis;
+
+      return node_index;
+    }
+
+    // Walks the tree front to back and stops as soon as visitor returns true
+    template<typename Visitor>
+    bool walk(const Ray& ray, Real max_t, Visitor&& visitor) const
+    {
+      if (nodes_.empty()) {
+        return false;
+      }
+
+      const auto& origin = ray.origin();
+      const auto inverse_direction =
+        create_vector(Real{1} / ray.direction().x(), Real{1} / ray.direction().y(), Real{1} / ray.direction().z());
+      const std::array<bool, 3> negative{inverse_direction.x() < 0, inverse_direction.y() < 0, inverse_direction.z() < 0};
+
+      std::array<uint32_t, 64> stack;
+      size_t stack_size{0};
+      uint32_t current{0};
+
+      while (true) {
+        const auto& node = nodes_[current];
+        if (node.bounds_.intersects(origin, inverse_direction, max_t)) {
+          if (node.count_ > 0) {
+            for (uint32_t n = node.offset_; n < node.offset_ + node.count_; ++n) {
+              if (visitor(indices_[n])) {
+                return true;
+              }
+            }
+          } else if (negative[node.axis_]) {
+            stack[stack_size++] = current + 1;
+            current = node.offset_;
+            continue;
+          } else {
+            stack[stack_size++] = node.offset_;
+            current = current + 1;
+            continue;
+          }
+        }
+        if (stack_size == 0) {
+          return false;
+        }
+        current = stack[--stack_size];
+      }
+    }
+
+    void make_leaf(uint32_t node_index, uint32_t from, uint32_t count)
+    {
+      nodes_[node_index].offset_ = from;
+      nodes_[node_index].count_ = count;
+    }
+
+    static constexpr Real traversal_cost = 0.125;
+
+    uint32_t maximum_leaf_size_{default_leaf_size};
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> indices_;
+  };
+}
@@ -8,13 +8,37 @@
 
 #pragma once
 
+#include <sun_ray/feature/accumulation_buffer.h>
 #include <sun_ray/feature/canvas.h>
+#include <sun_ray/feature/pixel_sampler.h>
 #include <sun_ray/feature/ray.h>
+#include <sun_ray/feature/render_progress.h>
+#include <sun_ray/feature/thread_pool.h>
+#include <sun_ray/feature/tile_scheduler.h>
 #include <sun_ray/feature/world.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
 
 namespace sunray
 {
+  struct ProgressiveSettings {
+    uint32_t max_samples_{64};
+    uint32_t min_samples_{4};
+    // A pixel is converged, once the standard error of its mean luminance drops below the threshold
+    double noise_threshold_{0.002};
+    // No limit, if zero
+    std::chrono::milliseconds time_budget_{0};
+    std::chrono::milliseconds snapshot_interval_{1000};
+  };
+
+
   class Camera
   {
   public:
@@ -42,11 +66,19 @@ namespace sunray
     Camera& operator=(const Camera&) = delete;
     Camera& operator=(Camera&&) = delete;
 
+    using Snapshot = std::function<void(const Canvas&, uint32_t pass)>;
+
     Ray ray_for_pixel(uint32_t x, uint32_t y) const
     {
-      auto x_offset = (x + 0.5) * pixel_size_;
-      auto y_offset = (y + 0.5) * pixel_size_;
-      auto world_p = create_point(half_width_ - x_offset, half_height_ - y_offset, -1);
+      return ray_for_pixel(x, y, 0.5, 0.5);
+    }
+
+    // Ray through the given position relative to the top left corner of the pixel, an offset of 1 is the size of a pixel
+    Ray ray_for_pixel(uint32_t x, uint32_t y, double offset_x, double offset_y) const
+    {
+      auto x_offset = (x + offset_x) * pixel_size_;
+      auto y_offset = (y + offset_y) * pixel_size_;
+      auto world_p = create_point(static_cast<Real>(half_width_ - x_offset), static_cast<Real>(half_height_ - y_offset), -1);
 
       static auto s_origin = create_point(0, 0, 0);
       auto pixel = transformation_ * world_p;
@@ -58,46 +90,117 @@ namespace sunray
 
     Canvas render(const World& world) const
     {
-      Canvas canvas{horizontal_size_, vertical_size_};
+      RenderStatistics statistics;
+      return render(world, statistics);
+    }
 
-      struct RenderPart {
-        uint32_t from_;
-        uint32_t to_;
-      };
+    Canvas render(const World& world, RenderStatistics& statistics) const
+    {
+      ThreadPool pool{world.context().number_of_threads_};
+      return render(world, statistics, pool);
+    }
 
-      uint32_t nr_parts = world.context().number_of_threads_;
-      uint32_t part_size = vertical_size_ / nr_parts;
+    Canvas render(const World& world, ThreadPool& pool) const
+    {
+      RenderStatistics statistics;
+      return render(world, statistics, pool);
+    }
 
-      if (part_size == 0) {
-        nr_parts = 1;
-        part_size = vertical_size_;
-      }
+    Canvas render(const World& world, RenderStatistics& statistics, ThreadPool& pool,
+                  RenderProgress* progress = nullptr) const
+    {
+      return render(world, Tile{0, 0, horizontal_size_, vertical_size_}, statistics, pool, progress);
+    }
 
-      std::vector<RenderPart> parts;
-      uint32_t vertical_lines{0};
-      for (uint32_t n = 0; n < nr_parts; ++n) {
-        parts.emplace_back(RenderPart{part_size * n, part_size * (n + 1)});
-        vertical_lines += parts.back().to_ - parts.back().from_;
-      }
+    // The anti aliasing pass stops at the deadline, the pixels it has not reached keep the color of the first pass, which
+    // is always completed
+    Canvas render(const World& world, RenderStatistics& statistics, ThreadPool& pool, RenderProgress* progress,
+                  std::chrono::steady_clock::time_point deadline) const
+    {
+      return render(
+        world, Tile{0, 0, horizontal_size_, vertical_size_}, statistics, pool.size(),
+        [&pool](const ThreadPool::Job& job) { pool.run(job); }, progress, deadline);
+    }
 
-      if (vertical_lines < vertical_size_) {
-        parts.emplace_back(RenderPart{parts.back().from_ + 1, vertical_size_});
-      }
+    // Renders the given region of the image only, the canvas has the size of the region. Its pixels are the same as the
+    // ones of a full render, except for anti aliasing, which only compares neighbours inside of the region.
+    //
+    // The number of samples per pixel of the render context are combined by its reconstruction filter. With a single
+    // sample per pixel and anti aliasing activated, a second pass supersamples only the pixels, which differ from one of
+    // their neighbours in color or in the hit object.
+    //
+    // The progress counts the tiles of both passes. Once it is cancelled, no further tiles are rendered and the canvas is
+    // returned as far as it is done, the pixels of the missing tiles are black.
+    Canvas render(const World& world, const Tile& region, RenderStatistics& statistics, ThreadPool& pool,
+                  RenderProgress* progress = nullptr) const
+    {
+      return render(
+        world, region, statistics, pool.size(), [&pool](const ThreadPool::Job& job) { pool.run(job); }, progress);
+    }
 
-      std::vector<std::thread> threads;
-      for (const auto& part : parts) {
-        threads.emplace_back(std::thread{[&]() {
-          render(canvas, world, part.from_, part.to_);
-        }});
-      }
+    // Renders the region on the calling thread, for callers which already distribute the work by themselves
+    Canvas render(const World& world, const Tile& region, RenderStatistics& statistics) const
+    {
+      return render(world, region, statistics, 1, [](const ThreadPool::Job& job) { job(0); }, nullptr);
+    }
+
+    // Renders a coarse preview first, with one sample for every block of 8x8, 4x4 and 2x2 pixels, followed by a pass with
+    // one sample for each remaining pixel. Every further pass adds one sample to each pixel, which has not converged yet,
+    // until no pixel needs more samples or the time budget is used up. The first pass is always completed. After a pass,
+    // the snapshot is called with the current image, at most once per snapshot interval. The tiles of a pass are added to
+    // the progress when the pass starts, a cancellation ends the render at the next tile, even during the first pass. With
+    // several samples per pixel in the world, the samples are the ones of a plain render weighted by its filter.
+    Canvas render_progressive(const World& world, const ProgressiveSettings& settings, ThreadPool& pool,
+                              RenderStatistics& statistics, const Snapshot& snapshot = {},
+                              RenderProgress* progress = nullptr) const
+    {
+      using Clock = std::chrono::steady_clock;
+      const auto start = Clock::now();
+      const auto out_of_time = [&settings, start]() {
+        return settings.time_budget_.count() > 0 && Clock::now() - start >= settings.time_budget_;
+      };
+      const auto cancelled = [progress]() {
+        return progress && progress->cancelled();
+      };
+
+      AccumulationBuffer buffer{horizontal_size_, vertical_size_};
+      std::vector<Worker> workers(pool.size());
+      auto last_snapshot = start;
+      for (uint32_t pass = 0;; ++pass) {
+        TileScheduler scheduler{horizontal_size_, vertical_size_, world.context().tile_size_,
+                                static_cast<uint32_t>(pool.size())};
+        if (progress) {
+          progress->add_tiles(scheduler.tile_count());
+        }
+        std::atomic<uint64_t> samples{0};
+        pool.run([&](size_t n) {
+          uint64_t taken{0};
+          while (const auto tile = scheduler.next(n)) {
+            if ((pass > 0 && out_of_time()) || cancelled()) {
+              break;
+            }
+            const auto tile_samples = refine(buffer, world, *tile, pass, settings, workers[n]);
+            if (progress) {
+              progress->tile_done(tile_samples);
+            }
+            taken += tile_samples;
+          }
+          samples += taken;
+        });
+        statistics.samples_ += samples;
+        statistics.passes_ += 1;
 
-      for (auto& thread : threads) {
-        if (thread.joinable()) {
-          thread.join();
+        if (snapshot && Clock::now() - last_snapshot >= settings.snapshot_interval_) {
+          snapshot(buffer.canvas(), pass);
+          last_snapshot = Clock::now();
+        }
+        if (cancelled() || (pass + 1 >= coarse_passes && (samples == 0 || out_of_time()))) {
+          break;
         }
       }
 
-      return canvas;
+      collect(workers, statistics);
+      return buffer.canvas();
     }
 
     inline uint32_t horizontal_size() const
@@ -132,16 +235,295 @@ namespace sunray
       return stream;
     }
 
-  private:
-    void render(Canvas& canvas, const World& world, uint32_t from, uint32_t to) const
+    // The following functions render single tiles for callers, which distribute the tiles by themselves. Every thread
+    // renders with a worker of its own, the anti aliasing pass starts once all tiles of the first pass are done.
+
+    // State of a render thread, which is reused for all of its pixels. The states of the threads lie next to each other,
+    // they start on a cache line of their own, so that updating the counters of the shadow cache does not slow down the
+    // neighbouring thread.
+    struct alignas(64) Worker {
+      Intersections intersections_;
+      ShadowCache cache_;
+      RayStack stack_;
+
+      inline Color color_at(const World& world, const Ray& ray)
+      {
+        return world.color_at(ray, intersections_, cache_, stack_);
+      }
+    };
+
+    // Whether a render of the world is followed by the anti aliasing pass
+    static bool anti_aliasing(const World& world)
+    {
+      return world.context().anti_aliasing_ && samples_per_pixel(world) == 1;
+    }
+
+    // Renders a tile into the canvas covering the region, the tile is given in image coordinates. With anti aliasing, the
+    // hit objects have room for every pixel of the region and record the object seen by each one. Returns the number of
+    // samples.
+    uint64_t render_tile(Canvas& canvas, std::vector<const Object*>& hit_objects, const World& world, const Tile& region,
+                         const Tile& tile, Worker& worker) const
     {
-      sunray::Intersections intersections;
-      for (uint32_t y = from; y < to; ++y) {
-        for (uint32_t x = 0; x < horizontal_size_ - 1; ++x) {
+      const auto samples = samples_per_pixel(world);
+      for (uint32_t y = tile.y_; y < tile.y_ + tile.height_; ++y) {
+        for (uint32_t x = tile.x_; x < tile.x_ + tile.width_; ++x) {
+          const auto cx = x - region.x_;
+          const auto cy = y - region.y_;
+          if (samples > 1) {
+            canvas.pixel_at(cx, cy, multi_sample(world, x, y, samples, worker));
+            continue;
+          }
           const auto ray = ray_for_pixel(x, y);
-          canvas.pixel_at(x, y, world.color_at(ray, intersections));
+          canvas.pixel_at(cx, cy, worker.color_at(world, ray));
+          if (!hit_objects.empty()) {
+            // Instances share the objects of their prototype, so the instance tells them apart
+            const auto* hit = worker.intersections_.hit();
+            hit_objects[cy * region.width_ + cx] = hit ? (hit->instance() ? hit->instance() : hit->object()) : nullptr;
+          }
+        }
+      }
+      return static_cast<uint64_t>(tile.width_) * tile.height_ * samples;
+    }
+
+    // Supersamples the pixels of the tile, which differ from one of their neighbours in the canvas of the first pass, and
+    // writes them to the anti aliased canvas. Both canvases cover the region, the first pass has to be complete. Returns
+    // the number of samples.
+    uint64_t anti_alias(Canvas& anti_aliased, const Canvas& canvas, const std::vector<const Object*>& hit_objects,
+                        const World& world, const Tile& region, const Tile& tile, Worker& worker) const
+    {
+      const auto threshold = world.context().anti_aliasing_threshold_;
+      uint64_t samples{0};
+      for (uint32_t y = tile.y_; y < tile.y_ + tile.height_; ++y) {
+        for (uint32_t x = tile.x_; x < tile.x_ + tile.width_; ++x) {
+          const auto cx = x - region.x_;
+          const auto cy = y - region.y_;
+          const auto index = cy * region.width_ + cx;
+          const auto color = canvas.pixel_at(cx, cy);
+          const auto differs = [&](uint32_t nx, uint32_t ny) {
+            return hit_objects[index] != hit_objects[ny * region.width_ + nx] ||
+                   contrast(color, canvas.pixel_at(nx, ny)) > threshold;
+          };
+          if ((cx > 0 && differs(cx - 1, cy)) || (cx + 1 < region.width_ && differs(cx + 1, cy)) ||
+              (cy > 0 && differs(cx, cy - 1)) || (cy + 1 < region.height_ && differs(cx, cy + 1))) {
+            anti_aliased.pixel_at(cx, cy,
+                                  supersample(world, x, y, 0.0, 0.0, 1.0, world.context().anti_aliasing_depth_, worker, samples));
+          }
         }
       }
+      return samples;
+    }
+
+  private:
+    // The run function calls the job once for each of the given number of workers
+    template <typename Run>
+    Canvas render(const World& world, const Tile& region, RenderStatistics& statistics, size_t number_of_workers,
+                  const Run& run, RenderProgress* progress,
+                  std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max()) const
+    {
+      if (region.width_ == 0 || region.height_ == 0 || uint64_t{region.x_} + region.width_ > horizontal_size_ ||
+          uint64_t{region.y_} + region.height_ > vertical_size_) {
+        throw std::out_of_range{"region " + std::to_string(region.x_) + "," + std::to_string(region.y_) + " " +
+                                std::to_string(region.width_) + "x" + std::to_string(region.height_) +
+                                " is not inside of the image"};
+      }
+
+      // Every pixel is written first by the worker rendering its tile, which places the pages of the canvas on the NUMA
+      // nodes of the workers pinned by the pool
+      Canvas canvas{region.width_, region.height_, Canvas::uninitialized};
+      TileScheduler scheduler{region, world.context().tile_size_, static_cast<uint32_t>(number_of_workers)};
+
+      // Every worker owns its buffers and shadow cache, the statistics are collected once all workers are done
+      std::vector<Worker> workers(scheduler.number_of_workers());
+      const auto anti_aliasing = Camera::anti_aliasing(world);
+      std::vector<const Object*> hit_objects(anti_aliasing ? canvas.width() * canvas.height() : 0);
+      const auto cancelled = [progress]() {
+        return progress && progress->cancelled();
+      };
+      if (progress) {
+        progress->add_tiles(scheduler.tile_count() * (anti_aliasing ? 2 : 1));
+      }
+      std::atomic<uint64_t> samples{0};
+      run([&](size_t n) {
+        uint64_t taken{0};
+        while (!cancelled()) {
+          const auto tile = scheduler.next(n);
+          if (!tile) {
+            break;
+          }
+          const auto tile_samples = render_tile(canvas, hit_objects, world, region, *tile, workers[n]);
+          if (progress) {
+            progress->tile_done(tile_samples);
+          }
+          taken += tile_samples;
+        }
+        samples += taken;
+      });
+      statistics.samples_ += samples;
+      statistics.passes_ += 1;
+
+      if (cancelled()) {
+        // Tiles, which have not been rendered, are black
+        while (const auto tile = scheduler.next(0)) {
+          for (uint32_t y = tile->y_; y < tile->y_ + tile->height_; ++y) {
+            for (uint32_t x = tile->x_; x < tile->x_ + tile->width_; ++x) {
+              canvas.pixel_at(x - region.x_, y - region.y_, Color{0, 0, 0});
+            }
+          }
+        }
+      }
+      if (!anti_aliasing || cancelled()) {
+        collect(workers, statistics);
+        return canvas;
+      }
+
+      Canvas anti_aliased{canvas};
+      TileScheduler edges{region, world.context().tile_size_, static_cast<uint32_t>(number_of_workers)};
+      samples = 0;
+      run([&](size_t n) {
+        uint64_t taken{0};
+        while (!cancelled() && std::chrono::steady_clock::now() < deadline) {
+          const auto tile = edges.next(n);
+          if (!tile) {
+            break;
+          }
+          const auto tile_samples = anti_alias(anti_aliased, canvas, hit_objects, world, region, *tile, workers[n]);
+          if (progress) {
+            progress->tile_done(tile_samples);
+          }
+          taken += tile_samples;
+        }
+        samples += taken;
+      });
+      statistics.samples_ += samples;
+      statistics.passes_ += 1;
+      if (progress && !cancelled()) {
+        // Tiles skipped at the deadline are done without further samples
+        while (edges.next(0)) {
+          progress->tile_done(0);
+        }
+      }
+
+      collect(workers, statistics);
+      return anti_aliased;
+    }
+
+    static constexpr uint32_t coarse_passes = 4;
+
+    static void collect(const std::vector<Worker>& workers, RenderStatistics& statistics)
+    {
+      for (const auto& worker : workers) {
+        statistics.shadow_rays_ += worker.cache_.lookups();
+        statistics.shadow_cache_hits_ += worker.cache_.hits();
+      }
+    }
+
+    // Size of the coarse block, the pixel is the top left corner of. Pixels of the coarse pass with block size 8 >> pass
+    // are sampled in that pass.
+    static uint32_t coarse_block_size(uint32_t x, uint32_t y)
+    {
+      const auto bits = x | y | 8u;
+      return bits & (~bits + 1);
+    }
+
+    uint64_t refine(AccumulationBuffer& buffer, const World& world, const Tile& tile, uint32_t pass,
+                    const ProgressiveSettings& settings, Worker& worker) const
+    {
+      uint64_t samples{0};
+      for (uint32_t y = tile.y_; y < tile.y_ + tile.height_; ++y) {
+        for (uint32_t x = tile.x_; x < tile.x_ + tile.width_; ++x) {
+          const auto count = buffer.samples(x, y);
+          if (pass < coarse_passes) {
+            if (coarse_block_size(x, y) != (8u >> pass)) {
+              continue;
+            }
+          } else if (count >= settings.max_samples_ ||
+                     (count >= settings.min_samples_ && buffer.standard_error(x, y) < settings.noise_threshold_)) {
+            continue;
+          }
+          if (samples_per_pixel(world) > 1) {
+            // The samples of a plain render with their filter weights, so that the image is the same once the samples
+            // per pixel of the world are taken
+            const auto sample = PixelSampler{x, y, world.context().filter_}.sample(count);
+            buffer.add(x, y, worker.color_at(world, ray_for_pixel(x, y, sample.x_, sample.y_)), sample.weight_);
+          } else {
+            // The first sample is the center of the pixel, so the coarse passes match a plain render
+            const auto offset = PixelSampler::r2(count);
+            buffer.add(x, y, worker.color_at(world, ray_for_pixel(x, y, offset.first, offset.second)));
+          }
+          ++samples;
+        }
+      }
+      return samples;
+    }
+
+    // Weighted mean of the samples, the samples are added in a fixed order, so that the result is the same bit by bit
+    // regardless of the thread rendering the pixel
+    Color multi_sample(const World& world, uint32_t x, uint32_t y, uint32_t samples, Worker& worker) const
+    {
+      const PixelSampler sampler{x, y, world.context().filter_};
+      float red{0.0f};
+      float green{0.0f};
+      float blue{0.0f};
+      float weight{0.0f};
+      for (uint32_t n = 0; n < samples; ++n) {
+        const auto sample = sampler.sample(n);
+        const auto color = worker.color_at(world, ray_for_pixel(x, y, sample.x_, sample.y_));
+        red += color.red() * sample.weight_;
+        green += color.green() * sample.weight_;
+        blue += color.blue() * sample.weight_;
+        weight += sample.weight_;
+      }
+      return Color{red / weight, green / weight, blue / weight};
+    }
+
+    static uint32_t samples_per_pixel(const World& world)
+    {
+      return std::max(world.context().samples_per_pixel_, uint32_t{1});
+    }
+
+    // Average color of the square at the given offset inside of the pixel. The centers of its four quarters are sampled,
+    // and a quarter which differs from one of the others is subdivided again as long as depth allows.
+    Color supersample(const World& world, uint32_t x, uint32_t y, double offset_x, double offset_y, double size, uint8_t depth,
+                      Worker& worker, uint64_t& samples) const
+    {
+      const auto half = size / 2.0;
+      const auto threshold = world.context().anti_aliasing_threshold_;
+      std::array<Color, 4> colors{Color{0, 0, 0}, Color{0, 0, 0}, Color{0, 0, 0}, Color{0, 0, 0}};
+      for (size_t n = 0; n < colors.size(); ++n) {
+        const auto quarter_x = offset_x + static_cast<double>(n % 2) * half;
+        const auto quarter_y = offset_y + static_cast<double>(n / 2) * half;
+        colors[n] = worker.color_at(world, ray_for_pixel(x, y, quarter_x + half / 2.0, quarter_y + half / 2.0));
+        ++samples;
+      }
+
+      if (depth > 1) {
+        std::array<bool, 4> subdivide{false, false, false, false};
+        for (size_t n = 0; n < colors.size(); ++n) {
+          for (size_t m = n + 1; m < colors.size(); ++m) {
+            if (contrast(colors[n], colors[m]) > threshold) {
+              subdivide[n] = true;
+              subdivide[m] = true;
+            }
+          }
+        }
+        for (size_t n = 0; n < colors.size(); ++n) {
+          if (subdivide[n]) {
+            colors[n] = supersample(world, x, y, offset_x + static_cast<double>(n % 2) * half,
+                                    offset_y + static_cast<double>(n / 2) * half, half, static_cast<uint8_t>(depth - 1),
+                                    worker, samples);
+          }
+        }
+      }
+
+      return (colors[0] + colors[1] + colors[2] + colors[3]) * 0.25f;
+    }
+
+    // Largest difference of the color channels, clamped to the displayable range
+    static float contrast(const Color& lhs, const Color& rhs)
+    {
+      const auto a = lhs.normalize();
+      const auto b = rhs.normalize();
+      return std::max({std::abs(a.red() - b.red()), std::abs(a.green() - b.green()), std::abs(a.blue() - b.blue())});
     }
 
     void calculate_pixel_size()
@@ -10,16 +10,57 @@
 
 #include <sun_ray/feature/color.h>
 
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <new>
+#include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 
 namespace sunray
 {
+  // Allocates elements, which are default initialized unless a value is given. Resizing a vector of floats leaves the new
+  // elements untouched then.
+  template <typename T>
+  struct DefaultInitAllocator : std::allocator<T> {
+    template <typename U>
+    struct rebind {
+      using other = DefaultInitAllocator<U>;
+    };
+
+    DefaultInitAllocator() = default;
+
+    template <typename U>
+    DefaultInitAllocator(const DefaultInitAllocator<U>& other) noexcept
+    : std::allocator<T>{other}
+    {
+    }
+
+    template <typename U>
+    void construct(U* element)
+    {
+      ::new (static_cast<void*>(element)) U;
+    }
+
+    template <typename U, typename... Args>
+    void construct(U* element, Args&&... args)
+    {
+      ::new (static_cast<void*>(element)) U(std::forward<Args>(args)...);
+    }
+  };
+
+
   class Canvas
   {
   public:
-    using Vec = std::vector<float>;
+    using Vec = std::vector<float, DefaultInitAllocator<float>>;
+
+    struct Uninitialized {
+    };
+    static constexpr Uninitialized uninitialized{};
 
     Canvas(uint32_t width, uint32_t height)
     : width_{width}
@@ -28,6 +69,15 @@ namespace sunray
       pixels_.resize(height_ * width_ * 3, 0.0f);
     }
 
+    // The pixels are left uninitialized and have to be written before they are read. The memory pages of a large canvas
+    // are placed on the NUMA node of the thread writing them first, instead of the one of the constructing thread.
+    Canvas(uint32_t width, uint32_t height, Uninitialized)
+    : width_{width}
+    , height_{height}
+    {
+      pixels_.resize(height_ * width_ * 3);
+    }
+
     Canvas(const Canvas& canvas)
     : width_{canvas.width_}
     , height_{canvas.height_}
@@ -74,6 +124,19 @@ namespace sunray
       pixels_[offset + 2] = color.blue();
     }
 
+    // Copies the patch into the canvas, its top left corner is placed at the given pixel
+    void paste(const Canvas& patch, uint32_t x, uint32_t y)
+    {
+      if (patch.width_ == 0 || patch.height_ == 0) {
+        return;
+      }
+      check_ranges(x + patch.width_ - 1, y + patch.height_ - 1);
+      for (uint32_t row = 0; row < patch.height_; ++row) {
+        const auto source = patch.pixels_.begin() + row * patch.width_ * 3;
+        std::copy(source, source + patch.width_ * 3, pixels_.begin() + (x + (y + row) * width_) * 3);
+      }
+    }
+
     friend std::ostream& operator<<(std::ostream& stream, const Canvas& canvas)
     {
       stream << "width: " << canvas.width_ << " height: " << canvas.height_;
@@ -95,4 +158,41 @@ namespace sunray
     uint32_t height_{0};
     Vec pixels_;
   };
+
+
+  // How much two canvases differ, with the channels clamped to [0, 1] as they are written to an image
+  struct CanvasDifference {
+    // Largest difference of a channel
+    float maximum_{0.0f};
+    // Mean difference of all channels
+    double mean_{0.0};
+    // Pixels with a channel differing by more than the tolerance
+    uint64_t pixels_{0};
+  };
+
+  inline CanvasDifference difference(const Canvas& lhs, const Canvas& rhs, float tolerance = 1.0f / 255.0f)
+  {
+    if (lhs.width() != rhs.width() || lhs.height() != rhs.height()) {
+      throw std::invalid_argument{"canvases of different sizes cannot be compared"};
+    }
+
+    CanvasDifference result;
+    double sum{0.0};
+    for (uint32_t y = 0; y < lhs.height(); ++y) {
+      for (uint32_t x = 0; x < lhs.width(); ++x) {
+        const auto a = lhs.pixel_at(x, y).normalize();
+        const auto b = rhs.pixel_at(x, y).normalize();
+        const auto pixel = std::max({std::fabs(a.red() - b.red()), std::fabs(a.green() - b.green()),
+                                     std::fabs(a.blue() - b.blue())});
+        sum += std::fabs(a.red() - b.red()) + std::fabs(a.green() - b.green()) + std::fabs(a.blue() - b.blue());
+        result.maximum_ = std::max(result.maximum_, pixel);
+        if (pixel > tolerance) {
+          ++result.pixels_;
+        }
+      }
+    }
+    const auto channels = static_cast<double>(lhs.width()) * lhs.height() * 3;
+    result.mean_ = channels > 0 ? sum / channels : 0.0;
+    return result;
+  }
 }
@@ -10,6 +10,8 @@
 
 #include <sun_ray/feature/object.h>
 
+#include <algorithm>
+
 
 namespace sunray
 {
@@ -21,7 +23,7 @@ namespace sunray
   , public std::enable_shared_from_this<Cone>
   {
   public:
-    Cone(double maximum = std::numeric_limits<double>::infinity(), double minimum = -std::numeric_limits<double>::infinity(),
+    Cone(Real maximum = std::numeric_limits<Real>::infinity(), Real minimum = -std::numeric_limits<Real>::infinity(),
          bool closed = false)
     : maximum_{maximum}
     , minimum_{minimum}
@@ -29,8 +31,8 @@ namespace sunray
     {
     }
 
-    explicit Cone(Material material, double maximum = std::numeric_limits<double>::infinity(),
-                  double minimum = -std::numeric_limits<double>::infinity(), bool closed = false)
+    explicit Cone(Material material, Real maximum = std::numeric_limits<Real>::infinity(),
+                  Real minimum = -std::numeric_limits<Real>::infinity(), bool closed = false)
     : Object(std::move(material))
     , maximum_{maximum}
     , minimum_{minimum}
@@ -38,8 +40,8 @@ namespace sunray
     {
     }
 
-    explicit Cone(Matrix44 transformation, double maximum = std::numeric_limits<double>::infinity(),
-                  double minimum = -std::numeric_limits<double>::infinity(), bool closed = false)
+    explicit Cone(Matrix44 transformation, Real maximum = std::numeric_limits<Real>::infinity(),
+                  Real minimum = -std::numeric_limits<Real>::infinity(), bool closed = false)
     : Object(std::move(transformation))
     , maximum_{maximum}
     , minimum_{minimum}
@@ -48,7 +50,7 @@ namespace sunray
     }
 
     Cone(Material material, Matrix44 transformation, bool casts_shadow = true,
-         double maximum = std::numeric_limits<double>::infinity(), double minimum = -std::numeric_limits<double>::infinity(),
+         Real maximum = std::numeric_limits<Real>::infinity(), Real minimum = -std::numeric_limits<Real>::infinity(),
          bool closed = false)
     : Object(std::move(material), std::move(transformation), casts_shadow)
     , maximum_{maximum}
@@ -64,27 +66,27 @@ namespace sunray
     Cone& operator=(const Cone&) = delete;
     Cone& operator=(Cone&&) = delete;
 
-    static ConePtr make_cone(double maximum = std::numeric_limits<double>::infinity(),
-                             double minimum = -std::numeric_limits<double>::infinity(), bool closed = false)
+    static ConePtr make_cone(Real maximum = std::numeric_limits<Real>::infinity(),
+                             Real minimum = -std::numeric_limits<Real>::infinity(), bool closed = false)
     {
       return std::make_shared<Cone>(maximum, minimum, closed);
     }
 
-    static ConePtr make_cone(Material material, double maximum = std::numeric_limits<double>::infinity(),
-                             double minimum = -std::numeric_limits<double>::infinity(), bool closed = false)
+    static ConePtr make_cone(Material material, Real maximum = std::numeric_limits<Real>::infinity(),
+                             Real minimum = -std::numeric_limits<Real>::infinity(), bool closed = false)
     {
       return std::make_shared<Cone>(std::move(material), maximum, minimum, closed);
     }
 
-    static ConePtr make_cone(const Matrix44& transformation, double maximum = std::numeric_limits<double>::infinity(),
-                             double minimum = -std::numeric_limits<double>::infinity(), bool closed = false)
+    static ConePtr make_cone(const Matrix44& transformation, Real maximum = std::numeric_limits<Real>::infinity(),
+                             Real minimum = -std::numeric_limits<Real>::infinity(), bool closed = false)
     {
       return std::make_shared<Cone>(transformation, maximum, minimum, closed);
     }
 
     static ConePtr make_cone(Material material, const Matrix44& transformation, bool casts_shadow = true,
-                             double maximum = std::numeric_limits<double>::infinity(),
-                             double minimum = -std::numeric_limits<double>::infinity(), bool closed = false)
+                             Real maximum = std::numeric_limits<Real>::infinity(),
+                             Real minimum = -std::numeric_limits<Real>::infinity(), bool closed = false)
     {
       return std::make_shared<Cone>(std::move(material), transformation, casts_shadow, maximum, minimum, closed);
     }
@@ -109,8 +111,9 @@ namespace sunray
       if (abs(a) >= epsilon) {
         const auto discriminant = pow<2>(b) - 4 * a * c;
 
-        if (discriminant >= 0) {
-          auto sr = sqrt(discriminant);
+        // Tangent rays round to a slightly negative discriminant in float
+        if (discriminant >= -rounding_tolerance) {
+          auto sr = sqrt(std::max(discriminant, Real{0}));
           auto a2 = 2 * a;
           auto t0 = (-b - sr) / a2;
           auto t1 = (-b + sr) / a2;
@@ -137,12 +140,12 @@ namespace sunray
       return result;
     }
 
-    inline bool check_caps(const Ray& ray, double t, double h) const
+    inline bool check_caps(const Ray& ray, Real t, Real h) const
     {
       const auto x = ray.origin().x() + t * ray.direction().x();
       const auto z = ray.origin().z() + t * ray.direction().z();
 
-      return (pow<2>(x) + pow<2>(z)) <= pow<2>(h);
+      return (pow<2>(x) + pow<2>(z)) <= pow<2>(h) + rounding_tolerance;
     }
 
     bool intersect_caps(const Ray& ray, Intersections& intersections) const
@@ -186,8 +189,14 @@ namespace sunray
       return create_vector(local_point.x(), y, local_point.z());
     }
 
-    double maximum_{std::numeric_limits<double>::infinity()};
-    double minimum_{-std::numeric_limits<double>::infinity()};
+    BoundingBox do_bounds() const override
+    {
+      const auto radius = std::max(abs(minimum_), abs(maximum_));
+      return BoundingBox{create_point(-radius, minimum_, -radius), create_point(radius, maximum_, radius)};
+    }
+
+    Real maximum_{std::numeric_limits<Real>::infinity()};
+    Real minimum_{-std::numeric_limits<Real>::infinity()};
     bool closed_{false};
   };
 }
@@ -0,0 +1,287 @@
+//
+//  cpu_topology.h
+//  sun_ray
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#ifdef __linux__
+  #include <sched.h>
+#endif
+
+
+namespace sunray
+{
+  // How the workers of a thread pool are pinned to the hardware threads
+  enum class AffinityPolicy {
+    // The operating system moves the workers around
+    none,
+    // Fills the NUMA nodes one after the other, the hardware threads of a core next to each other
+    compact,
+    // Alternates between the NUMA nodes and uses every core once before its further hardware threads
+    scatter
+  };
+
+  inline AffinityPolicy affinity_policy(const std::string& name)
+  {
+    if (name == "none") {
+      return AffinityPolicy::none;
+    }
+    if (name == "compact") {
+      return AffinityPolicy::compact;
+    }
+    if (name == "scatter") {
+      return AffinityPolicy::scatter;
+    }
+    throw std::invalid_argument{"unknown affinity policy '" + name + "'"};
+  }
+
+
+  // Hardware thread, as numbered by the operating system
+  struct Cpu {
+    uint32_t id_{0};
+    uint32_t node_{0};
+    uint32_t package_{0};
+    uint32_t core_{0};
+  };
+
+
+  // The hardware threads available to the process with their NUMA node, socket and core. On Linux, they are read from
+  // /sys/devices/system, anywhere else every hardware thread is a core of its own on a single node.
+  class CpuTopology
+  {
+  public:
+    explicit CpuTopology(std::vector<Cpu> cpus)
+    : cpus_{std::move(cpus)}
+    {
+      if (cpus_.empty()) {
+        throw std::invalid_argument{"a cpu topology needs at least one cpu"};
+      }
+    }
+
+    ~CpuTopology() = default;
+
+    CpuTopology(const CpuTopology&) = default;
+    CpuTopology(CpuTopology&&) = default;
+    CpuTopology& operator=(const CpuTopology&) = default;
+    CpuTopology& operator=(CpuTopology&&) = default;
+
+    // The hardware threads the process is allowed to run on
+    static CpuTopology detect()
+    {
+#ifdef __linux__
+      cpu_set_t allowed;
+      CPU_ZERO(&allowed);
+      const auto has_mask = ::sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+      auto cpus = read("/sys/devices/system").cpus_;
+      cpus.erase(std::remove_if(cpus.begin(), cpus.end(),
+                                [has_mask, &allowed](const Cpu& cpu) {
+                                  return has_mask && cpu.id_ < CPU_SETSIZE && !CPU_ISSET(cpu.id_, &allowed);
+                                }),
+                 cpus.end());
+      if (!cpus.empty()) {
+        return CpuTopology{std::move(cpus)};
+      }
+#endif
+      return uniform(std::thread::hardware_concurrency());
+    }
+
+    // Reads the online hardware threads from a sysfs tree like /sys/devices/system. Missing entries count as a single node
+    // and a core per hardware thread.
+    static CpuTopology read(const std::filesystem::path& root)
+    {
+      const auto online = parse_cpu_list(read_line(root / "cpu" / "online"));
+      if (online.empty()) {
+        return uniform(std::thread::hardware_concurrency());
+      }
+
+      std::map<uint32_t, uint32_t> nodes;
+      std::error_code error;
+      for (const auto& entry : std::filesystem::directory_iterator{root / "node", error}) {
+        const auto name = entry.path().filename().string();
+        if (name.rfind("node", 0) != 0 || !is_number(name.substr(4))) {
+          continue;
+        }
+        const auto node = static_cast<uint32_t>(std::stoul(name.substr(4)));
+        for (const auto id : parse_cpu_list(read_line(entry.path() / "cpulist"))) {
+          nodes[id] = node;
+        }
+      }
+
+      std::vector<Cpu> cpus;
+      cpus.reserve(online.size());
+      for (const auto id : online) {
+        const auto topology = root / "cpu" / ("cpu" + std::to_string(id)) / "topology";
+        const auto node = nodes.find(id);
+        cpus.push_back(Cpu{id, node != nodes.end() ? node->second : 0,
+                           read_number(topology / "physical_package_id").value_or(0),
+                           read_number(topology / "core_id").value_or(id)});
+      }
+      return CpuTopology{std::move(cpus)};
+    }
+
+    // Single node with the given number of cores
+    static CpuTopology uniform(uint32_t number_of_cpus)
+    {
+      std::vector<Cpu> cpus;
+      for (uint32_t id = 0; id < std::max(number_of_cpus, uint32_t{1}); ++id) {
+        cpus.push_back(Cpu{id, 0, 0, id});
+      }
+      return CpuTopology{std::move(cpus)};
+    }
+
+    inline const std::vector<Cpu>& cpus() const
+    {
+      return cpus_;
+    }
+
+    std::vector<uint32_t> nodes() const
+    {
+      std::set<uint32_t> nodes;
+      for (const auto& cpu : cpus_) {
+        nodes.insert(cpu.node_);
+      }
+      return std::vector<uint32_t>{nodes.begin(), nodes.end()};
+    }
+
+    // The hardware thread of each of the given number of workers, none for AffinityPolicy::none. With a node, only its
+    // hardware threads are used, if it has any. More workers than hardware threads start over with the first one.
+    std::vector<Cpu> placement(AffinityPolicy policy, size_t number_of_workers,
+                               std::optional<uint32_t> node = std::nullopt) const
+    {
+      if (policy == AffinityPolicy::none || number_of_workers == 0) {
+        return {};
+      }
+
+      auto candidates = cpus_;
+      if (node) {
+        candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                        [&node](const Cpu& cpu) {
+                                          return cpu.node_ != *node;
+                                        }),
+                         candidates.end());
+        if (candidates.empty()) {
+          candidates = cpus_;
+        }
+      }
+
+      // Rank of the hardware thread within its core
+      std::map<std::tuple<uint32_t, uint32_t, uint32_t>, uint32_t> threads_per_core;
+      std::sort(candidates.begin(), candidates.end(), [](const Cpu& lhs, const Cpu& rhs) {
+        return lhs.id_ < rhs.id_;
+      });
+      std::vector<std::pair<uint32_t, Cpu>> ranked;
+      for (const auto& cpu : candidates) {
+        ranked.emplace_back(threads_per_core[std::make_tuple(cpu.node_, cpu.package_, cpu.core_)]++, cpu);
+      }
+
+      std::vector<Cpu> order;
+      if (policy == AffinityPolicy::compact) {
+        std::sort(ranked.begin(), ranked.end(), [](const auto& lhs, const auto& rhs) {
+          return std::make_tuple(lhs.second.node_, lhs.second.package_, lhs.second.core_, lhs.first) <
+                 std::make_tuple(rhs.second.node_, rhs.second.package_, rhs.second.core_, rhs.first);
+        });
+        for (const auto& [rank, cpu] : ranked) {
+          order.push_back(cpu);
+        }
+      } else {
+        std::sort(ranked.begin(), ranked.end(), [](const auto& lhs, const auto& rhs) {
+          return std::make_tuple(lhs.first, lhs.second.package_, lhs.second.core_) <
+                 std::make_tuple(rhs.first, rhs.second.package_, rhs.second.core_);
+        });
+        std::map<uint32_t, std::vector<Cpu>> per_node;
+        for (const auto& [rank, cpu] : ranked) {
+          per_node[cpu.node_].push_back(cpu);
+        }
+        for (size_t n = 0; order.size() < ranked.size(); ++n) {
+          for (const auto& [id, cpus] : per_node) {
+            if (n < cpus.size()) {
+              order.push_back(cpus[n]);
+            }
+          }
+        }
+      }
+
+      std::vector<Cpu> result;
+      result.reserve(number_of_workers);
+      for (size_t n = 0; n < number_of_workers; ++n) {
+        result.push_back(order[n % order.size()]);
+      }
+      return result;
+    }
+
+    // Ranges like "0-3,8,10-11"
+    static std::vector<uint32_t> parse_cpu_list(const std::string& list)
+    {
+      std::vector<uint32_t> result;
+      size_t start{0};
+      while (start < list.size()) {
+        auto end = list.find(',', start);
+        if (end == std::string::npos) {
+          end = list.size();
+        }
+        const auto range = list.substr(start, end - start);
+        const auto dash = range.find('-');
+        try {
+          const auto first = static_cast<uint32_t>(std::stoul(range.substr(0, dash)));
+          const auto last = dash == std::string::npos ? first : static_cast<uint32_t>(std::stoul(range.substr(dash + 1)));
+          for (auto id = first; id <= last; ++id) {
+            result.push_back(id);
+          }
+        } catch (const std::logic_error&) {
+          throw std::invalid_argument{"invalid cpu list '" + list + "'"};
+        }
+        start = end + 1;
+      }
+      return result;
+    }
+
+  private:
+    static bool is_number(const std::string& value)
+    {
+      return !value.empty() && std::all_of(value.begin(), value.end(), [](unsigned char c) {
+        return std::isdigit(c) != 0;
+      });
+    }
+
+    static std::string read_line(const std::filesystem::path& path)
+    {
+      std::ifstream stream{path};
+      std::string line;
+      std::getline(stream, line);
+      line.erase(std::remove_if(line.begin(), line.end(),
+                                [](unsigned char c) {
+                                  return std::isspace(c) != 0;
+                                }),
+                 line.end());
+      return line;
+    }
+
+    static std::optional<uint32_t> read_number(const std::filesystem::path& path)
+    {
+      const auto line = read_line(path);
+      if (!is_number(line)) {
+        return std::nullopt;
+      }
+      return static_cast<uint32_t>(std::stoul(line));
+    }
+
+    std::vector<Cpu> cpus_;
+  };
+}
@@ -85,13 +85,13 @@ namespace sunray
       return true;
     }
 
-    std::pair<double, double> check_axis(double origin, double direction) const
+    std::pair<Real, Real> check_axis(Real origin, Real direction) const
     {
       auto tmin_num = -1 - origin;
       auto tmax_num = 1 - origin;
 
-      double tmin = 0.0;
-      double tmax = 0.0;
+      Real tmin = 0.0;
+      Real tmax = 0.0;
 
       if (abs(direction) >= epsilon) {
         tmin = tmin_num / direction;
@@ -122,5 +122,10 @@ namespace sunray
 
       return create_vector(0, 0, local_point.z());
     }
+
+    BoundingBox do_bounds() const override
+    {
+      return BoundingBox{create_point(-1, -1, -1), create_point(1, 1, 1)};
+    }
   };
 }
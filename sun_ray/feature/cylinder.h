@@ -21,7 +21,7 @@ namespace sunray
   , public std::enable_shared_from_this<Cylinder>
   {
   public:
-    Cylinder(double maximum = std::numeric_limits<double>::infinity(), double minimum = -std::numeric_limits<double>::infinity(),
+    Cylinder(Real maximum = std::numeric_limits<Real>::infinity(), Real minimum = -std::numeric_limits<Real>::infinity(),
              bool closed = false)
     : maximum_{maximum}
     , minimum_{minimum}
@@ -29,8 +29,8 @@ namespace sunray
     {
     }
 
-    explicit Cylinder(Material material, double maximum = std::numeric_limits<double>::infinity(),
-                      double minimum = -std::numeric_limits<double>::infinity(), bool closed = false)
+    explicit Cylinder(Material material, Real maximum = std::numeric_limits<Real>::infinity(),
+                      Real minimum = -std::numeric_limits<Real>::infinity(), bool closed = false)
     : Object(std::move(material))
     , maximum_{maximum}
     , minimum_{minimum}
@@ -38,8 +38,8 @@ namespace sunray
     {
     }
 
-    explicit Cylinder(Matrix44 transformation, double maximum = std::numeric_limits<double>::infinity(),
-                      double minimum = -std::numeric_limits<double>::infinity(), bool closed = false)
+    explicit Cylinder(Matrix44 transformation, Real maximum = std::numeric_limits<Real>::infinity(),
+                      Real minimum = -std::numeric_limits<Real>::infinity(), bool closed = false)
     : Object(std::move(transformation))
     , maximum_{maximum}
     , minimum_{minimum}
@@ -48,7 +48,7 @@ namespace sunray
     }
 
     Cylinder(Material material, Matrix44 transformation, bool casts_shadow = true,
-             double maximum = std::numeric_limits<double>::infinity(), double minimum = -std::numeric_limits<double>::infinity(),
+             Real maximum = std::numeric_limits<Real>::infinity(), Real minimum = -std::numeric_limits<Real>::infinity(),
              bool closed = false)
     : Object(std::move(material), std::move(transformation), casts_shadow)
     , maximum_{maximum}
@@ -64,27 +64,27 @@ namespace sunray
     Cylinder& operator=(const Cylinder&) = delete;
     Cylinder& operator=(Cylinder&&) = delete;
 
-    static CylinderPtr make_cylinder(double maximum = std::numeric_limits<double>::infinity(),
-                                     double minimum = -std::numeric_limits<double>::infinity(), bool closed = false)
+    static CylinderPtr make_cylinder(Real maximum = std::numeric_limits<Real>::infinity(),
+                                     Real minimum = -std::numeric_limits<Real>::infinity(), bool closed = false)
     {
       return std::make_shared<Cylinder>(maximum, minimum, closed);
     }
 
-    static CylinderPtr make_cylinder(Material material, double maximum = std::numeric_limits<double>::infinity(),
-                                     double minimum = -std::numeric_limits<double>::infinity(), bool closed = false)
+    static CylinderPtr make_cylinder(Material material, Real maximum = std::numeric_limits<Real>::infinity(),
+                                     Real minimum = -std::numeric_limits<Real>::infinity(), bool closed = false)
     {
       return std::make_shared<Cylinder>(std::move(material), maximum, minimum, closed);
     }
 
-    static CylinderPtr make_cylinder(const Matrix44& transformation, double maximum = std::numeric_limits<double>::infinity(),
-                                     double minimum = -std::numeric_limits<double>::infinity(), bool closed = false)
+    static CylinderPtr make_cylinder(const Matrix44& transformation, Real maximum = std::numeric_limits<Real>::infinity(),
+                                     Real minimum = -std::numeric_limits<Real>::infinity(), bool closed = false)
     {
       return std::make_shared<Cylinder>(transformation, maximum, minimum, closed);
     }
 
     static CylinderPtr make_cylinder(Material material, const Matrix44& transformation, bool casts_shadow = true,
-                                     double maximum = std::numeric_limits<double>::infinity(),
-                                     double minimum = -std::numeric_limits<double>::infinity(), bool closed = false)
+                                     Real maximum = std::numeric_limits<Real>::infinity(),
+                                     Real minimum = -std::numeric_limits<Real>::infinity(), bool closed = false)
     {
       return std::make_shared<Cylinder>(std::move(material), transformation, casts_shadow, maximum, minimum, closed);
     }
@@ -136,12 +136,13 @@ namespace sunray
       return result;
     }
 
-    inline bool check_caps(const Ray& ray, double t) const
+    inline bool check_caps(const Ray& ray, Real t) const
     {
       const auto x = ray.origin().x() + t * ray.direction().x();
       const auto z = ray.origin().z() + t * ray.direction().z();
 
-      return (pow<2>(x) + pow<2>(z)) <= 1;
+      // Includes the rim, which float misses by a rounding error
+      return (pow<2>(x) + pow<2>(z)) <= 1 + rounding_tolerance;
     }
 
     bool intersect_caps(const Ray& ray, Intersections& intersections) const
@@ -180,8 +181,13 @@ namespace sunray
       return create_vector(local_point.x(), 0, local_point.z());
     }
 
-    double maximum_{std::numeric_limits<double>::infinity()};
-    double minimum_{-std::numeric_limits<double>::infinity()};
+    BoundingBox do_bounds() const override
+    {
+      return BoundingBox{create_point(-1, minimum_, -1), create_point(1, maximum_, 1)};
+    }
+
+    Real maximum_{std::numeric_limits<Real>::infinity()};
+    Real minimum_{-std::numeric_limits<Real>::infinity()};
     bool closed_{false};
   };
 }
@@ -0,0 +1,282 @@
+//
+//  deadline_renderer.h
+//  sun_ray
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#pragma once
+
+#include <sun_ray/feature/camera.h>
+#include <sun_ray/feature/canvas.h>
+#include <sun_ray/feature/render_progress.h>
+#include <sun_ray/feature/thread_pool.h>
+#include <sun_ray/feature/world.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+
+namespace sunray
+{
+  // Settings a frame is rendered with, from the ones of the render context down to a quarter of the resolution
+  struct QualityLevel {
+    uint32_t samples_per_pixel_{1};
+    uint8_t maximum_depth_{5};
+    bool shadows_{true};
+    bool anti_aliasing_{false};
+    // The image is rendered with 1/scale of its width and height and upscaled afterwards
+    uint32_t scale_{1};
+
+    std::string to_string() const
+    {
+      return "samples: " + std::to_string(samples_per_pixel_) + " depth: " + std::to_string(maximum_depth_) +
+             " shadows: " + (shadows_ ? "on" : "off") + " anti aliasing: " + (anti_aliasing_ ? "on" : "off") +
+             " scale: 1/" + std::to_string(scale_);
+    }
+  };
+
+
+  // Renders a frame within the deadline of the render context. A probe render of the image at a fraction of its size
+  // estimates the time per sample for the settings of each quality level. The best level, which is expected to fit into
+  // the remaining time, is rendered. Several samples per pixel are added pass by pass, passes still missing at the
+  // deadline are dropped. With a single sample per pixel, the anti aliasing of the edges stops at the deadline. The
+  // context of the world is changed while rendering and restored afterwards.
+  class DeadlineRenderer
+  {
+  public:
+    DeadlineRenderer() = default;
+
+    ~DeadlineRenderer() = default;
+
+    DeadlineRenderer(const DeadlineRenderer&) = delete;
+    DeadlineRenderer(DeadlineRenderer&&) = delete;
+    DeadlineRenderer& operator=(const DeadlineRenderer&) = delete;
+    DeadlineRenderer& operator=(DeadlineRenderer&&) = delete;
+
+    // The level chosen by the last render
+    inline const QualityLevel& quality() const
+    {
+      return quality_;
+    }
+
+    // Only the final render is reported to the progress, not the probes
+    Canvas render(const Camera& camera, World& world, ThreadPool& pool, RenderStatistics& statistics,
+                  RenderProgress* progress = nullptr)
+    {
+      using Clock = std::chrono::steady_clock;
+      const auto start = Clock::now();
+      const ContextGuard guard{world};
+      const auto& context = guard.context();
+      const auto remaining = [&context, start]() {
+        return std::chrono::duration<double>(context.deadline_ - (Clock::now() - start)).count();
+      };
+
+      if (context.deadline_.count() > 0) {
+        Probe probe{camera, world, pool};
+        quality_ = choose(levels(context), [&camera, &probe, &remaining](const QualityLevel& level) {
+          const auto pixels = static_cast<double>(std::max(camera.horizontal_size() / level.scale_, uint32_t{1})) *
+                              std::max(camera.vertical_size() / level.scale_, uint32_t{1});
+          return std::make_pair(probe.seconds_per_sample(level) * pixels * level.samples_per_pixel_ *
+                                  (level.anti_aliasing_ ? anti_aliasing_cost : 1.0),
+                                remaining());
+        });
+      } else {
+        quality_ = levels(context).front();
+      }
+
+      const Camera scaled{std::max(camera.horizontal_size() / quality_.scale_, uint32_t{1}),
+                          std::max(camera.vertical_size() / quality_.scale_, uint32_t{1}), camera.field_of_view(),
+                          camera.transformation()};
+      world.context(settings(context, quality_));
+      Canvas canvas = [&]() {
+        if (quality_.samples_per_pixel_ == 1) {
+          if (context.deadline_.count() > 0) {
+            // The probe does not see the cost of anti aliasing, which is therefore stopped at the deadline
+            return scaled.render(world, statistics, pool, progress, start + context.deadline_);
+          }
+          return scaled.render(world, statistics, pool, progress);
+        }
+        ProgressiveSettings progressive;
+        progressive.max_samples_ = quality_.samples_per_pixel_;
+        progressive.min_samples_ = quality_.samples_per_pixel_;
+        progressive.noise_threshold_ = 0.0;
+        if (context.deadline_.count() > 0) {
+          const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(context.deadline_ - (Clock::now() - start));
+          progressive.time_budget_ = std::max(left, std::chrono::milliseconds{1});
+        }
+        return scaled.render_progressive(world, progressive, pool, statistics, {}, progress);
+      }();
+      if (quality_.scale_ == 1) {
+        return canvas;
+      }
+      return upscale(canvas, camera.horizontal_size(), camera.vertical_size());
+    }
+
+    // From the settings of the context down to the cheapest one: a single sample per pixel, no anti aliasing, two and one
+    // bounces of secondary rays, no shadows and at last half and a quarter of the resolution
+    static std::vector<QualityLevel> levels(const RenderContext& context)
+    {
+      std::vector<QualityLevel> result{QualityLevel{context.samples_per_pixel_, context.maximum_depth_, context.shadows_,
+                                                    context.anti_aliasing_ && context.samples_per_pixel_ == 1, 1}};
+      const auto lower = [&result](auto change) {
+        auto level = result.back();
+        if (change(level)) {
+          result.push_back(level);
+        }
+      };
+      lower([](QualityLevel& level) {
+        return std::exchange(level.samples_per_pixel_, 1) != 1;
+      });
+      lower([](QualityLevel& level) {
+        return std::exchange(level.anti_aliasing_, false);
+      });
+      for (uint8_t depth : {uint8_t{2}, uint8_t{1}}) {
+        lower([depth](QualityLevel& level) {
+          return std::exchange(level.maximum_depth_, std::min(level.maximum_depth_, depth)) > depth;
+        });
+      }
+      lower([](QualityLevel& level) {
+        return std::exchange(level.shadows_, false);
+      });
+      for (uint32_t scale : {2u, 4u}) {
+        lower([scale](QualityLevel& level) {
+          return std::exchange(level.scale_, scale) != scale;
+        });
+      }
+      return result;
+    }
+
+    // The first level, whose estimated time fits into the share of the remaining time, or else the last one. The estimate
+    // returns the expected and the remaining seconds.
+    template <typename Estimate>
+    static QualityLevel choose(const std::vector<QualityLevel>& candidates, const Estimate& estimate)
+    {
+      for (const auto& level : candidates) {
+        const auto [expected, remaining] = estimate(level);
+        if (expected <= remaining * budget_share) {
+          return level;
+        }
+      }
+      return candidates.back();
+    }
+
+    // Bilinear interpolation of the pixel centers
+    static Canvas upscale(const Canvas& canvas, uint32_t width, uint32_t height)
+    {
+      Canvas result{width, height};
+      const auto source = [](uint32_t position, uint32_t size, uint32_t source_size) {
+        const auto exact = std::clamp((position + 0.5) * source_size / size - 0.5, 0.0, source_size - 1.0);
+        const auto first = static_cast<uint32_t>(exact);
+        return std::make_tuple(first, std::min(first + 1, source_size - 1), static_cast<float>(exact - first));
+      };
+      for (uint32_t y = 0; y < height; ++y) {
+        const auto [top, bottom, v] = source(y, height, canvas.height());
+        for (uint32_t x = 0; x < width; ++x) {
+          const auto [left, right, u] = source(x, width, canvas.width());
+          const auto upper = canvas.pixel_at(left, top) * (1.0f - u) + canvas.pixel_at(right, top) * u;
+          const auto lower = canvas.pixel_at(left, bottom) * (1.0f - u) + canvas.pixel_at(right, bottom) * u;
+          result.pixel_at(x, y, upper * (1.0f - v) + lower * v);
+        }
+      }
+      return result;
+    }
+
+  private:
+    // Share of the remaining time a level may be estimated to take, the rest is left for errors of the estimate
+    static constexpr double budget_share = 0.8;
+    // Upper bound of the supersampling pass of anti aliasing relative to the first pass
+    static constexpr double anti_aliasing_cost = 2.0;
+    // Width and height of the probe render relative to the image
+    static constexpr uint32_t probe_scale = 8;
+
+    static RenderContext settings(const RenderContext& context, const QualityLevel& level)
+    {
+      auto result = context;
+      result.samples_per_pixel_ = level.samples_per_pixel_;
+      result.maximum_depth_ = level.maximum_depth_;
+      result.shadows_ = level.shadows_;
+      result.anti_aliasing_ = level.anti_aliasing_;
+      return result;
+    }
+
+    class ContextGuard
+    {
+    public:
+      explicit ContextGuard(World& world)
+      : world_{world}
+      , context_{world.context()}
+      {
+      }
+
+      ~ContextGuard()
+      {
+        world_.context(context_);
+      }
+
+      ContextGuard(const ContextGuard&) = delete;
+      ContextGuard(ContextGuard&&) = delete;
+      ContextGuard& operator=(const ContextGuard&) = delete;
+      ContextGuard& operator=(ContextGuard&&) = delete;
+
+      inline const RenderContext& context() const
+      {
+        return context_;
+      }
+
+    private:
+      World& world_;
+      RenderContext context_;
+    };
+
+    // Times a render of a small version of the image with one sample per pixel, once for each combination of depth and
+    // shadows
+    class Probe
+    {
+    public:
+      Probe(const Camera& camera, World& world, ThreadPool& pool)
+      : camera_{std::max(camera.horizontal_size() / probe_scale, uint32_t{1}),
+                std::max(camera.vertical_size() / probe_scale, uint32_t{1}), camera.field_of_view(),
+                camera.transformation()}
+      , world_{world}
+      , pool_{pool}
+      , context_{world.context()}
+      {
+      }
+
+      double seconds_per_sample(const QualityLevel& level)
+      {
+        const auto key = std::make_pair(level.maximum_depth_, level.shadows_);
+        const auto found = seconds_.find(key);
+        if (found != seconds_.end()) {
+          return found->second;
+        }
+
+        world_.context(settings(context_, QualityLevel{1, level.maximum_depth_, level.shadows_, false, 1}));
+        RenderStatistics statistics;
+        const auto start = std::chrono::steady_clock::now();
+        camera_.render(world_, statistics, pool_);
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() /
+                             (static_cast<double>(camera_.horizontal_size()) * camera_.vertical_size());
+        seconds_.emplace(key, seconds);
+        return seconds;
+      }
+
+    private:
+      Camera camera_;
+      World& world_;
+      ThreadPool& pool_;
+      RenderContext context_;
+      std::map<std::pair<uint8_t, bool>, double> seconds_;
+    };
+
+    QualityLevel quality_;
+  };
+}
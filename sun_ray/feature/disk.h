@@ -21,25 +21,25 @@ namespace sunray
   , public std::enable_shared_from_this<Disk>
   {
   public:
-    explicit Disk(double inner_radius)
+    explicit Disk(Real inner_radius)
     : Object()
     , inner_radius_{inner_radius}
     {
     }
 
-    explicit Disk(Material material, double inner_radius = 0.0)
+    explicit Disk(Material material, Real inner_radius = 0.0)
     : Object(std::move(material))
     , inner_radius_{inner_radius}
     {
     }
 
-    explicit Disk(Matrix44 transformation, double inner_radius = 0.0)
+    explicit Disk(Matrix44 transformation, Real inner_radius = 0.0)
     : Object(std::move(transformation))
     , inner_radius_{inner_radius}
     {
     }
 
-    Disk(Material material, Matrix44 transformation, bool casts_shadow = true, double inner_radius = 0.0)
+    Disk(Material material, Matrix44 transformation, bool casts_shadow = true, Real inner_radius = 0.0)
     : Object(std::move(material), std::move(transformation), casts_shadow)
     , inner_radius_{inner_radius}
     {
@@ -52,23 +52,23 @@ namespace sunray
     Disk& operator=(const Disk&) = delete;
     Disk& operator=(Disk&&) = delete;
 
-    static DiskPtr make_disk(double inner_radius = 0.0)
+    static DiskPtr make_disk(Real inner_radius = 0.0)
     {
       return std::make_shared<Disk>(inner_radius);
     }
 
-    static DiskPtr make_disk(Material material, double inner_radius = 0.0)
+    static DiskPtr make_disk(Material material, Real inner_radius = 0.0)
     {
       return std::make_shared<Disk>(std::move(material), inner_radius);
     }
 
-    static DiskPtr make_disk(const Matrix44& transformation, double inner_radius = 0.0)
+    static DiskPtr make_disk(const Matrix44& transformation, Real inner_radius = 0.0)
     {
       return std::make_shared<Disk>(transformation, inner_radius);
     }
 
     static DiskPtr make_disk(Material material, const Matrix44& transformation, bool casts_shadow = true,
-                             double inner_radius = 0.0)
+                             Real inner_radius = 0.0)
     {
       return std::make_shared<Disk>(std::move(material), transformation, casts_shadow, inner_radius);
     }
@@ -82,7 +82,7 @@ namespace sunray
 
       const auto t = -ray.origin().y() / ray.direction().y();
       const auto p = ray.point_at(t);
-      const double dist = create_vector(p.x(), p.y(), p.z()).magnitude();
+      const Real dist = create_vector(p.x(), p.y(), p.z()).magnitude();
 
       if (dist > radius_ * radius_ || dist < inner_radius_ * inner_radius_) {
         return false;
@@ -99,7 +99,12 @@ namespace sunray
       return create_vector(0, 1, 0);
     }
 
-    double radius_{1.0};
-    double inner_radius_{0.0};
+    BoundingBox do_bounds() const override
+    {
+      return BoundingBox{create_point(-radius_, 0, -radius_), create_point(radius_, 0, radius_)};
+    }
+
+    Real radius_{1.0};
+    Real inner_radius_{0.0};
   };
 }
@@ -0,0 +1,564 @@
+//
+//  distributed_renderer.h
+//  sun_ray
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#pragma once
+
+#include <sun_ray/feature/camera.h>
+#include <sun_ray/feature/canvas.h>
+#include <sun_ray/feature/cpu_topology.h>
+#include <sun_ray/feature/render_progress.h>
+#include <sun_ray/feature/thread_pool.h>
+#include <sun_ray/feature/tile_scheduler.h>
+#include <sun_ray/feature/world.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+  #include <poll.h>
+  #include <sys/socket.h>
+  #include <sys/types.h>
+  #include <sys/wait.h>
+  #include <unistd.h>
+#endif
+
+#ifdef __linux__
+  #include <sched.h>
+#endif
+
+
+namespace sunray
+{
+  // Renders the tiles of an image in several worker processes on the same host. The workers are forked by start(), which
+  // has to be called before the process starts any thread: the child of a process with several threads may only call
+  // async signal safe functions, while a worker allocates memory and starts threads of its own. Every worker runs the
+  // same scripts as the coordinator, so that it builds the same scenes and renders them with the same cameras, without
+  // any serialization. Instead of rendering an image by itself, a worker renders the tiles the coordinator sends it over a
+  // Unix domain socket and sends back their pixels. The coordinator hands out the next tile to whichever worker is done
+  // first and assembles the final canvas. Every tile comes with a fingerprint of the camera and the scene of the
+  // coordinator, a worker, which has built another scene, stops with an error instead of rendering it.
+  //
+  // A worker starts the threads rendering its tiles with its first render, the coordinator renders with none of its own.
+  //
+  // With anti aliasing, a worker renders the first pass of its tile together with a border of one pixel, so that it finds
+  // the edges at the border of the tile as well. The pixels are the same as the ones of a render in a single process.
+  //
+  // With an affinity policy, the workers are spread over the NUMA nodes, one after the other. A worker is restricted to the
+  // hardware threads of its node right after the fork, before it builds its scene, and its threads are pinned to them.
+  // The pages of its scene, canvases and buffers are first touched on the node, so every node renders from a replica of
+  // the scene in its own memory.
+  class DistributedRenderer
+  {
+  public:
+    // Runs in a worker process, which ends once the function returns or throws
+    using Work = std::function<void(DistributedRenderer&)>;
+
+    DistributedRenderer(uint32_t number_of_processes, uint32_t threads_per_process,
+                        AffinityPolicy affinity = AffinityPolicy::none)
+    : number_of_processes_{std::max(number_of_processes, uint32_t{1})}
+    , threads_per_process_{std::max(threads_per_process, uint32_t{1})}
+    , affinity_{affinity}
+    {
+    }
+
+    // The workers are stopped by closing their sockets
+    ~DistributedRenderer()
+    {
+#ifndef _WIN32
+      for (const auto socket : sockets_) {
+        ::close(socket);
+      }
+      for (const auto pid : pids_) {
+        int status{0};
+        while (::waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+        }
+      }
+#endif
+    }
+
+    DistributedRenderer(const DistributedRenderer&) = delete;
+    DistributedRenderer(DistributedRenderer&&) = delete;
+    DistributedRenderer& operator=(const DistributedRenderer&) = delete;
+    DistributedRenderer& operator=(DistributedRenderer&&) = delete;
+
+    inline uint32_t number_of_processes() const
+    {
+      return number_of_processes_;
+    }
+
+    // True in a worker process
+    inline bool worker() const
+    {
+      return socket_ >= 0;
+    }
+
+    // Forks the worker processes, each of them calls work with its copy of the renderer. The buffers of the standard
+    // streams are flushed before, so that the workers do not write them a second time.
+    void start(const Work& work)
+    {
+#ifdef _WIN32
+      (void)work;
+      throw std::runtime_error{"rendering in several processes is not supported on this platform"};
+#else
+      if (!sockets_.empty() || worker()) {
+        throw std::runtime_error{"the render processes have already been started"};
+      }
+      std::fflush(nullptr);
+      const auto topology =
+        affinity_ != AffinityPolicy::none ? std::optional<CpuTopology>{CpuTopology::detect()} : std::nullopt;
+      const auto nodes = topology ? topology->nodes() : std::vector<uint32_t>{};
+      for (uint32_t n = 0; n < number_of_processes_; ++n) {
+        start(work, topology, nodes.empty() ? std::nullopt : std::optional<uint32_t>{nodes[n % nodes.size()]});
+      }
+#endif
+    }
+
+    Canvas render(const Camera& camera, const World& world, RenderStatistics& statistics,
+                  RenderProgress* progress = nullptr)
+    {
+      return render(camera, world, Tile{0, 0, camera.horizontal_size(), camera.vertical_size()}, statistics, progress);
+    }
+
+    // The canvas has the size of the region, like the one of Camera::render. After a cancellation no further tiles are
+    // handed out, the ones in the workers are still collected. In a worker process, the tiles of the same render of the
+    // coordinator are rendered, the canvas returned is black.
+    Canvas render(const Camera& camera, const World& world, const Tile& region, RenderStatistics& statistics,
+                  RenderProgress* progress = nullptr)
+    {
+#ifdef _WIN32
+      (void)camera;
+      (void)world;
+      (void)region;
+      (void)statistics;
+      (void)progress;
+      throw std::runtime_error{"rendering in several processes is not supported on this platform"};
+#else
+      if (region.width_ == 0 || region.height_ == 0 || uint64_t{region.x_} + region.width_ > camera.horizontal_size() ||
+          uint64_t{region.y_} + region.height_ > camera.vertical_size()) {
+        throw std::out_of_range{"region is not inside of the image"};
+      }
+      if (worker()) {
+        if (!serve(camera, world, &region)) {
+          throw std::runtime_error{"the coordinating process has stopped"};
+        }
+        return Canvas{region.width_, region.height_};
+      }
+      if (sockets_.empty()) {
+        throw std::runtime_error{"the render processes have not been started"};
+      }
+
+      ++renders_;
+      const auto scene = fingerprint(camera, world);
+      Canvas canvas{region.width_, region.height_};
+      TileScheduler scheduler{region, world.context().tile_size_, 1};
+      if (progress) {
+        progress->add_tiles(scheduler.tile_count());
+      }
+      const auto next_job = [&]() {
+        const auto tile = progress && progress->cancelled() ? std::nullopt : scheduler.next(0);
+        return tile ? std::optional<Job>{Job{renders_, scene, region, *tile}} : std::nullopt;
+      };
+      std::vector<pollfd> busy;
+      for (const auto worker : sockets_) {
+        if (const auto job = next_job()) {
+          write_all(worker, &*job, sizeof(Job));
+          busy.push_back(pollfd{worker, POLLIN, 0});
+        }
+      }
+
+      std::vector<float> pixels;
+      while (!busy.empty()) {
+        if (::poll(busy.data(), static_cast<nfds_t>(busy.size()), -1) < 0) {
+          if (errno == EINTR) {
+            continue;
+          }
+          throw std::runtime_error{std::string{"waiting for the render processes failed: "} + std::strerror(errno)};
+        }
+        for (auto it = busy.begin(); it != busy.end();) {
+          if (it->revents == 0) {
+            ++it;
+            continue;
+          }
+          const auto samples = statistics.samples_;
+          const auto tile = receive_result(it->fd, pixels, statistics);
+          paste(canvas, region, tile, pixels);
+          if (progress) {
+            progress->tile_done(statistics.samples_ - samples);
+          }
+          if (const auto job = next_job()) {
+            write_all(it->fd, &*job, sizeof(Job));
+            it->revents = 0;
+            ++it;
+          } else {
+            it = busy.erase(it);
+          }
+        }
+      }
+
+      // A job without pixels ends the render in the workers
+      const Job end{renders_, scene, region, Tile{}};
+      for (const auto worker : sockets_) {
+        write_all(worker, &end, sizeof(Job));
+      }
+      statistics.passes_ += Camera::anti_aliasing(world) ? 2 : 1;
+      return canvas;
+#endif
+    }
+
+    // Renders the tiles of the next render of the coordinator in a worker process, whatever region it renders. For
+    // workers, which know the scene, but not the renders to come. False, once the coordinator has closed the socket.
+    bool serve(const Camera& camera, const World& world)
+    {
+#ifdef _WIN32
+      (void)camera;
+      (void)world;
+      throw std::runtime_error{"rendering in several processes is not supported on this platform"};
+#else
+      return serve(camera, world, nullptr);
+#endif
+    }
+
+  private:
+#ifndef _WIN32
+    // A tile of a render, the number of the render and the fingerprint of its scene tell the worker, whether it renders the
+    // same image as the coordinator
+    struct Job {
+      uint64_t render_;
+      uint64_t scene_;
+      Tile region_;
+      Tile tile_;
+    };
+
+    struct Result {
+      Tile tile_;
+      uint64_t samples_;
+      uint64_t shadow_rays_;
+      uint64_t shadow_cache_hits_;
+    };
+
+    void start(const Work& work, const std::optional<CpuTopology>& topology, std::optional<uint32_t> node)
+    {
+      int pair[2];
+      if (::socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0) {
+        throw std::runtime_error{std::string{"cannot create socket for render process: "} + std::strerror(errno)};
+      }
+#ifdef SO_NOSIGPIPE
+      // Platforms without MSG_NOSIGNAL
+      const int on{1};
+      ::setsockopt(pair[0], SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+      ::setsockopt(pair[1], SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+      const auto pid = ::fork();
+      if (pid < 0) {
+        ::close(pair[0]);
+        ::close(pair[1]);
+        throw std::runtime_error{std::string{"cannot start render process: "} + std::strerror(errno)};
+      }
+      if (pid == 0) {
+        if (topology && node) {
+          restrict_to_node(*topology, *node);
+        }
+        ::close(pair[0]);
+        for (const auto socket : sockets_) {
+          ::close(socket);
+        }
+        sockets_.clear();
+        pids_.clear();
+        socket_ = pair[1];
+        node_ = node;
+        // An interrupt of the terminal cancels the render of the coordinator, which then closes the sockets of its workers
+        std::signal(SIGINT, SIG_IGN);
+        int status{0};
+        try {
+          work(*this);
+        } catch (...) {
+          status = 1;
+        }
+        // The worker must not return into the code of the coordinator
+        ::_exit(status);
+      }
+      ::close(pair[1]);
+      sockets_.push_back(pair[0]);
+      pids_.push_back(pid);
+    }
+
+    // Moves the calling process to the hardware threads of the node. Only supported on Linux, elsewhere the process keeps
+    // running anywhere.
+    static void restrict_to_node(const CpuTopology& topology, uint32_t node)
+    {
+#ifdef __linux__
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      for (const auto& cpu : topology.cpus()) {
+        if (cpu.node_ == node && cpu.id_ < CPU_SETSIZE) {
+          CPU_SET(cpu.id_, &set);
+        }
+      }
+      if (CPU_COUNT(&set) > 0) {
+        ::sched_setaffinity(0, sizeof(set), &set);
+      }
+#else
+      (void)topology;
+      (void)node;
+#endif
+    }
+
+    // With a region, the coordinator has to render the same one
+    bool serve(const Camera& camera, const World& world, const Tile* region)
+    {
+      ++renders_;
+      if (!pool_) {
+        pool_ = std::make_unique<ThreadPool>(threads_per_process_, affinity_, node_);
+        workers_ = std::vector<Camera::Worker>(pool_->size());
+      }
+      for (auto& worker : workers_) {
+        // The cached occluders may belong to the world of an earlier render
+        worker.cache_.clear();
+      }
+
+      const auto scene = fingerprint(camera, world);
+      std::vector<float> pixels;
+      Job job;
+      while (read_all(socket_, &job, sizeof(job))) {
+        if (job.render_ != renders_ || job.scene_ != scene ||
+            (region && (job.region_.x_ != region->x_ || job.region_.y_ != region->y_ ||
+                        job.region_.width_ != region->width_ || job.region_.height_ != region->height_))) {
+          throw std::runtime_error{"the render process renders another image than the coordinating process"};
+        }
+        if (job.tile_.width_ == 0) {
+          return true;
+        }
+
+        const auto [lookups, hits] = shadow_rays();
+        const auto samples = render(camera, world, job.region_, job.tile_, pixels);
+        const auto [tile_lookups, tile_hits] = shadow_rays();
+        const Result result{job.tile_, samples, tile_lookups - lookups, tile_hits - hits};
+        write_all(socket_, &result, sizeof(result));
+        write_all(socket_, pixels.data(), pixels.size() * sizeof(float));
+      }
+      return false;
+    }
+
+    // Renders the tile with the threads of the worker process and returns the number of samples. With anti aliasing, the
+    // first pass covers a border of one pixel around the tile, as far as it lies inside of the region.
+    uint64_t render(const Camera& camera, const World& world, const Tile& region, const Tile& tile,
+                    std::vector<float>& pixels)
+    {
+      const auto anti_aliasing = Camera::anti_aliasing(world);
+      auto area = tile;
+      if (anti_aliasing) {
+        area.x_ = std::max(tile.x_, region.x_ + 1) - 1;
+        area.y_ = std::max(tile.y_, region.y_ + 1) - 1;
+        area.width_ = std::min(tile.x_ + tile.width_ + 1, region.x_ + region.width_) - area.x_;
+        area.height_ = std::min(tile.y_ + tile.height_ + 1, region.y_ + region.height_) - area.y_;
+      }
+
+      Canvas canvas{area.width_, area.height_, Canvas::uninitialized};
+      std::vector<const Object*> hit_objects(anti_aliasing ? static_cast<size_t>(area.width_) * area.height_ : 0);
+      auto samples = run(area, world.context().tile_size_, [&](const Tile& part, Camera::Worker& worker) {
+        return camera.render_tile(canvas, hit_objects, world, area, part, worker);
+      });
+      std::optional<Canvas> anti_aliased;
+      if (anti_aliasing) {
+        anti_aliased.emplace(canvas);
+        samples += run(tile, world.context().tile_size_, [&](const Tile& part, Camera::Worker& worker) {
+          return camera.anti_alias(*anti_aliased, canvas, hit_objects, world, area, part, worker);
+        });
+      }
+
+      const auto& result = anti_aliased ? *anti_aliased : canvas;
+      pixels.resize(static_cast<size_t>(tile.width_) * tile.height_ * 3);
+      auto pixel = pixels.begin();
+      for (uint32_t y = tile.y_; y < tile.y_ + tile.height_; ++y) {
+        for (uint32_t x = tile.x_; x < tile.x_ + tile.width_; ++x) {
+          const auto color = result.pixel_at(x - area.x_, y - area.y_);
+          *pixel++ = color.red();
+          *pixel++ = color.green();
+          *pixel++ = color.blue();
+        }
+      }
+      return samples;
+    }
+
+    // Hands out the parts of the area to the threads of the worker process
+    template <typename Render>
+    uint64_t run(const Tile& area, uint32_t tile_size, const Render& render)
+    {
+      TileScheduler scheduler{area, tile_size, static_cast<uint32_t>(pool_->size())};
+      std::atomic<uint64_t> samples{0};
+      pool_->run([&](size_t n) {
+        uint64_t taken{0};
+        while (const auto part = scheduler.next(n)) {
+          taken += render(*part, workers_[n]);
+        }
+        samples += taken;
+      });
+      return samples;
+    }
+
+    // Hash of the size of the image, the render settings and a grid of camera rays with their colors. It differs, if the
+    // processes have built different scenes or look at them from different places.
+    static uint64_t fingerprint(const Camera& camera, const World& world)
+    {
+      // FNV-1a
+      uint64_t hash{14695981039346656037ull};
+      const auto add = [&hash](const void* data, size_t size) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (size_t n = 0; n < size; ++n) {
+          hash = (hash ^ bytes[n]) * 1099511628211ull;
+        }
+      };
+      const auto add_value = [&add](const auto& value) {
+        add(&value, sizeof(value));
+      };
+
+      add_value(camera.horizontal_size());
+      add_value(camera.vertical_size());
+      const auto& context = world.context();
+      add_value(context.shadows_);
+      add_value(context.reflections_);
+      add_value(context.refractions_);
+      add_value(context.maximum_depth_);
+      add_value(context.minimum_weight_);
+      add_value(context.russian_roulette_);
+      add_value(context.russian_roulette_depth_);
+      add_value(context.tile_size_);
+      add_value(context.samples_per_pixel_);
+      add_value(context.filter_);
+      add_value(context.anti_aliasing_);
+      add_value(context.anti_aliasing_threshold_);
+      add_value(context.anti_aliasing_depth_);
+
+      constexpr uint32_t probes{4};
+      Intersections intersections;
+      for (uint32_t j = 0; j < probes; ++j) {
+        for (uint32_t i = 0; i < probes; ++i) {
+          const auto ray = camera.ray_for_pixel((2 * i + 1) * camera.horizontal_size() / (2 * probes),
+                                                (2 * j + 1) * camera.vertical_size() / (2 * probes));
+          add(static_cast<const Real*>(ray.origin()), 4 * sizeof(Real));
+          add(static_cast<const Real*>(ray.direction()), 4 * sizeof(Real));
+          add(static_cast<const float*>(world.color_at(ray, intersections)), 3 * sizeof(float));
+        }
+      }
+      return hash;
+    }
+
+    // Shadow rays and shadow cache hits of all threads of the worker process
+    std::pair<uint64_t, uint64_t> shadow_rays() const
+    {
+      uint64_t lookups{0};
+      uint64_t hits{0};
+      for (const auto& worker : workers_) {
+        lookups += worker.cache_.lookups();
+        hits += worker.cache_.hits();
+      }
+      return {lookups, hits};
+    }
+
+    static Tile receive_result(int socket, std::vector<float>& pixels, RenderStatistics& statistics)
+    {
+      Result result;
+      if (!read_all(socket, &result, sizeof(result))) {
+        throw std::runtime_error{"a render process has stopped unexpectedly"};
+      }
+      pixels.resize(static_cast<size_t>(result.tile_.width_) * result.tile_.height_ * 3);
+      if (!read_all(socket, pixels.data(), pixels.size() * sizeof(float))) {
+        throw std::runtime_error{"a render process has stopped unexpectedly"};
+      }
+      statistics.samples_ += result.samples_;
+      statistics.shadow_rays_ += result.shadow_rays_;
+      statistics.shadow_cache_hits_ += result.shadow_cache_hits_;
+      return result.tile_;
+    }
+
+    static void paste(Canvas& canvas, const Tile& region, const Tile& tile, const std::vector<float>& pixels)
+    {
+      auto pixel = pixels.begin();
+      for (uint32_t y = tile.y_; y < tile.y_ + tile.height_; ++y) {
+        for (uint32_t x = tile.x_; x < tile.x_ + tile.width_; ++x) {
+          canvas.pixel_at(x - region.x_, y - region.y_, Color{pixel[0], pixel[1], pixel[2]});
+          pixel += 3;
+        }
+      }
+    }
+
+    // False, if the socket has been closed before the first byte
+    static bool read_all(int socket, void* data, size_t size)
+    {
+      auto* bytes = static_cast<char*>(data);
+      size_t done{0};
+      while (done < size) {
+        const auto count = ::read(socket, bytes + done, size - done);
+        if (count < 0 && errno == EINTR) {
+          continue;
+        }
+        if (count < 0) {
+          throw std::runtime_error{std::string{"cannot read from render process: "} + std::strerror(errno)};
+        }
+        if (count == 0) {
+          if (done == 0) {
+            return false;
+          }
+          throw std::runtime_error{"incomplete message from render process"};
+        }
+        done += static_cast<size_t>(count);
+      }
+      return true;
+    }
+
+    static void write_all(int socket, const void* data, size_t size)
+    {
+#ifdef MSG_NOSIGNAL
+      constexpr int flags = MSG_NOSIGNAL;
+#else
+      constexpr int flags = 0;
+#endif
+      const auto* bytes = static_cast<const char*>(data);
+      size_t done{0};
+      while (done < size) {
+        const auto count = ::send(socket, bytes + done, size - done, flags);
+        if (count < 0 && errno == EINTR) {
+          continue;
+        }
+        if (count < 0) {
+          throw std::runtime_error{std::string{"cannot write to render process: "} + std::strerror(errno)};
+        }
+        done += static_cast<size_t>(count);
+      }
+    }
+#endif
+
+    uint32_t number_of_processes_;
+    uint32_t threads_per_process_;
+    AffinityPolicy affinity_;
+    // Renders started, in the coordinator and in every worker
+    uint64_t renders_{0};
+#ifndef _WIN32
+    // Sockets and process ids of the workers in the coordinator
+    std::vector<int> sockets_;
+    std::vector<pid_t> pids_;
+#endif
+    // Socket to the coordinator in a worker, together with the threads rendering the tiles
+    int socket_{-1};
+    std::optional<uint32_t> node_;
+    std::unique_ptr<ThreadPool> pool_;
+    std::vector<Camera::Worker> workers_;
+  };
+
+  using DistributedRendererPtr = std::shared_ptr<DistributedRenderer>;
+}
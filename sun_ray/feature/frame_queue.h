@@ -0,0 +1,382 @@
+//
+//  frame_queue.h
+//  sun_ray
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#pragma once
+
+#include <sun_ray/feature/camera.h>
+#include <sun_ray/feature/canvas.h>
+#include <sun_ray/feature/render_progress.h>
+#include <sun_ray/feature/thread_pool.h>
+#include <sun_ray/feature/tile_scheduler.h>
+#include <sun_ray/feature/world.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+namespace sunray
+{
+  // Keeps several frames of an animation in flight on one thread pool. The tiles of all frames are handed out by a single
+  // job, which takes them from the oldest frame first. Workers running out of tiles at the end of a frame continue with
+  // the next one, instead of waiting for the last tiles of the frame to be done.
+  //
+  // Frames are delivered in the order they were added: the continuations of a frame are called once it and all frames
+  // before it are done. The tiles are rendered straight into the canvas of the frame, every thread of the pool keeps its
+  // worker from frame to frame. Anti aliasing hands out the tiles of a frame a second time, once all tiles of its first
+  // pass are done, so that the pixels are the same as the ones of Camera::render.
+  //
+  // The tiles of both passes of a frame are added to the progress, when the frame is added. After a cancellation the
+  // remaining tiles are skipped, so that the frames are delivered with the pixels rendered so far.
+  class FrameQueue
+  {
+  public:
+    struct Frame;
+    using FramePtr = std::shared_ptr<Frame>;
+    using Continuation = std::function<void(const Canvas&)>;
+
+    FrameQueue(ThreadPoolPtr pool, uint32_t frames_in_flight, RenderProgressPtr progress = nullptr)
+    : pool_{std::move(pool)}
+    , frames_in_flight_{std::max(frames_in_flight, uint32_t{1})}
+    , progress_{std::move(progress)}
+    , threads_(pool_ ? pool_->size() : 0)
+    {
+      if (!pool_) {
+        throw std::invalid_argument{"a frame queue needs a thread pool"};
+      }
+      dispatcher_ = std::thread{[this]() {
+        dispatch();
+      }};
+    }
+
+    // Waits for all frames, errors are dropped
+    ~FrameQueue()
+    {
+      {
+        std::unique_lock<std::mutex> lock{mutex_};
+        delivered_.wait(lock, [this]() {
+          return frames_.empty();
+        });
+        stop_ = true;
+      }
+      pending_.notify_all();
+      dispatcher_.join();
+    }
+
+    FrameQueue(const FrameQueue&) = delete;
+    FrameQueue(FrameQueue&&) = delete;
+    FrameQueue& operator=(const FrameQueue&) = delete;
+    FrameQueue& operator=(FrameQueue&&) = delete;
+
+    inline uint32_t frames_in_flight() const
+    {
+      return frames_in_flight_;
+    }
+
+    // Starts to render the region of the camera image, after waiting for a free slot if the maximum number of frames is
+    // in flight. Camera and world are kept alive until the frame is delivered, they must not be changed before.
+    FramePtr add(std::shared_ptr<const Camera> camera, std::shared_ptr<const World> world, const Tile& region)
+    {
+      if (region.width_ == 0 || region.height_ == 0 || uint64_t{region.x_} + region.width_ > camera->horizontal_size() ||
+          uint64_t{region.y_} + region.height_ > camera->vertical_size()) {
+        throw std::out_of_range{"region is not inside of the image"};
+      }
+
+      auto frame = std::make_shared<Frame>(std::move(camera), std::move(world), region, pool_->size());
+      {
+        std::unique_lock<std::mutex> lock{mutex_};
+        delivered_.wait(lock, [this]() {
+          return frames_.size() < frames_in_flight_;
+        });
+        frame->number_ = ++frames_added_;
+        frames_.push_back(frame);
+        has_tiles_ = true;
+      }
+      if (progress_) {
+        progress_->add_tiles(frame->scheduler_.tile_count() * (frame->anti_aliasing_ ? 2 : 1));
+      }
+      pending_.notify_all();
+      return frame;
+    }
+
+    // Calls the continuation with the canvas of the frame, once the frame has been delivered, or right away for a frame,
+    // which is already delivered. Errors of the frame or the continuation are thrown by the next call to wait().
+    void then(const FramePtr& frame, Continuation continuation)
+    {
+      std::lock_guard<std::mutex> delivery{delivery_mutex_};
+      {
+        std::lock_guard<std::mutex> lock{mutex_};
+        if (!frame->delivered_) {
+          frame->continuations_.push_back(std::move(continuation));
+          return;
+        }
+      }
+      try {
+        call(*frame, continuation);
+      } catch (...) {
+        fail();
+      }
+    }
+
+    // Waits until the frame has been delivered, throws the error of its render
+    Canvas& canvas(const FramePtr& frame)
+    {
+      std::unique_lock<std::mutex> lock{mutex_};
+      delivered_.wait(lock, [&frame]() {
+        return frame->delivered_;
+      });
+      if (frame->error_) {
+        std::rethrow_exception(frame->error_);
+      }
+      return frame->canvas_;
+    }
+
+    // Waits until the frame has been delivered, the statistics sum up the tiles of both passes
+    RenderStatistics statistics(const FramePtr& frame)
+    {
+      std::unique_lock<std::mutex> lock{mutex_};
+      delivered_.wait(lock, [&frame]() {
+        return frame->delivered_;
+      });
+      return frame->statistics_;
+    }
+
+    // Waits until all frames have been delivered, throws the first error of a render or continuation since the last call
+    void wait()
+    {
+      std::unique_lock<std::mutex> lock{mutex_};
+      delivered_.wait(lock, [this]() {
+        return frames_.empty();
+      });
+      if (error_) {
+        const auto error = error_;
+        error_ = nullptr;
+        std::rethrow_exception(error);
+      }
+    }
+
+    struct Frame {
+      Frame(std::shared_ptr<const Camera> camera, std::shared_ptr<const World> world, const Tile& region,
+            size_t number_of_workers)
+      : camera_{std::move(camera)}
+      , world_{std::move(world)}
+      , region_{region}
+      , canvas_{region.width_, region.height_}
+      , anti_aliasing_{Camera::anti_aliasing(*world_)}
+      , hit_objects_(anti_aliasing_ ? canvas_.width() * canvas_.height() : 0)
+      , scheduler_{region, world_->context().tile_size_, static_cast<uint32_t>(number_of_workers)}
+      , edges_{region, world_->context().tile_size_, static_cast<uint32_t>(number_of_workers)}
+      , remaining_{scheduler_.tile_count()}
+      {
+        statistics_.passes_ = 1;
+      }
+
+      std::shared_ptr<const Camera> camera_;
+      std::shared_ptr<const World> world_;
+      Tile region_;
+      Canvas canvas_;
+      bool anti_aliasing_;
+      std::vector<const Object*> hit_objects_;
+      // Copy of the canvas after the first pass, which is read by anti aliasing while it writes the canvas
+      std::unique_ptr<const Canvas> first_pass_;
+      TileScheduler scheduler_;
+      TileScheduler edges_;
+      // Tiles of the current pass, which are not done yet
+      std::atomic<size_t> remaining_;
+      RenderStatistics statistics_;
+      uint64_t number_{0};
+      std::vector<Continuation> continuations_;
+      std::exception_ptr error_;
+      bool done_{false};
+      bool delivered_{false};
+    };
+
+  private:
+    // Worker of a thread of the pool together with the number of the frame it has rendered last
+    struct Thread {
+      Camera::Worker worker_;
+      uint64_t frame_{0};
+    };
+
+    // Runs the job handing out tiles whenever frames have been added
+    void dispatch()
+    {
+      std::unique_lock<std::mutex> lock{mutex_};
+      while (true) {
+        pending_.wait(lock, [this]() {
+          return stop_ || has_tiles_;
+        });
+        if (!has_tiles_) {
+          return;
+        }
+        has_tiles_ = false;
+        lock.unlock();
+        pool_->run([this](size_t worker) {
+          work(worker);
+        });
+        lock.lock();
+      }
+    }
+
+    void work(size_t n)
+    {
+      auto& thread = threads_[n];
+      while (true) {
+        FramePtr frame;
+        std::optional<Tile> tile;
+        bool edge{false};
+        {
+          std::lock_guard<std::mutex> lock{mutex_};
+          for (const auto& candidate : frames_) {
+            if ((tile = candidate->scheduler_.next(n))) {
+              frame = candidate;
+              break;
+            }
+            if (candidate->first_pass_ && (tile = candidate->edges_.next(n))) {
+              frame = candidate;
+              edge = true;
+              break;
+            }
+          }
+        }
+        if (!frame) {
+          return;
+        }
+
+        if (thread.frame_ != frame->number_) {
+          // The cached occluders belong to the world of another frame
+          thread.worker_.cache_.clear();
+          thread.frame_ = frame->number_;
+        }
+        const auto lookups = thread.worker_.cache_.lookups();
+        const auto hits = thread.worker_.cache_.hits();
+        uint64_t samples{0};
+        try {
+          if (!cancelled()) {
+            const auto& camera = *frame->camera_;
+            samples = edge ? camera.anti_alias(frame->canvas_, *frame->first_pass_, frame->hit_objects_, *frame->world_,
+                                               frame->region_, *tile, thread.worker_)
+                           : camera.render_tile(frame->canvas_, frame->hit_objects_, *frame->world_, frame->region_, *tile,
+                                                thread.worker_);
+            if (progress_) {
+              progress_->tile_done(samples);
+            }
+          }
+        } catch (...) {
+          std::lock_guard<std::mutex> lock{mutex_};
+          if (!frame->error_) {
+            frame->error_ = std::current_exception();
+          }
+        }
+        {
+          std::lock_guard<std::mutex> lock{mutex_};
+          frame->statistics_.samples_ += samples;
+          frame->statistics_.shadow_rays_ += thread.worker_.cache_.lookups() - lookups;
+          frame->statistics_.shadow_cache_hits_ += thread.worker_.cache_.hits() - hits;
+        }
+        if (--frame->remaining_ == 0) {
+          if (!edge && frame->anti_aliasing_ && !frame->error_ && !cancelled()) {
+            anti_alias(*frame);
+          } else {
+            complete(*frame);
+          }
+        }
+      }
+    }
+
+    // Hands out the tiles of the frame a second time for anti aliasing. The last tile of the first pass is done, so the
+    // canvas is not written by any thread while it is copied.
+    void anti_alias(Frame& frame)
+    {
+      auto first_pass = std::make_unique<const Canvas>(frame.canvas_);
+      {
+        std::lock_guard<std::mutex> lock{mutex_};
+        frame.remaining_ = frame.edges_.tile_count();
+        frame.first_pass_ = std::move(first_pass);
+        frame.statistics_.passes_ += 1;
+        has_tiles_ = true;
+      }
+      pending_.notify_all();
+    }
+
+    // Delivers the leading frames, which are done. Continuations are called outside of the lock, but one frame after the
+    // other, so that a continuation added by then() cannot overtake them.
+    void complete(Frame& frame)
+    {
+      std::lock_guard<std::mutex> delivery{delivery_mutex_};
+      std::unique_lock<std::mutex> lock{mutex_};
+      frame.done_ = true;
+      while (!frames_.empty() && frames_.front()->done_) {
+        const auto front = frames_.front();
+        const auto continuations = std::move(front->continuations_);
+        if (front->error_ && !error_) {
+          error_ = front->error_;
+        }
+        lock.unlock();
+        for (const auto& continuation : continuations) {
+          try {
+            call(*front, continuation);
+          } catch (...) {
+            fail();
+          }
+        }
+        lock.lock();
+        front->delivered_ = true;
+        frames_.pop_front();
+        delivered_.notify_all();
+      }
+    }
+
+    bool cancelled() const
+    {
+      return progress_ && progress_->cancelled();
+    }
+
+    void fail()
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      if (!error_) {
+        error_ = std::current_exception();
+      }
+    }
+
+    static void call(const Frame& frame, const Continuation& continuation)
+    {
+      if (frame.error_) {
+        std::rethrow_exception(frame.error_);
+      }
+      continuation(frame.canvas_);
+    }
+
+    ThreadPoolPtr pool_;
+    uint32_t frames_in_flight_;
+    RenderProgressPtr progress_;
+    std::vector<Thread> threads_;
+    std::thread dispatcher_;
+    std::mutex delivery_mutex_;
+    std::mutex mutex_;
+    std::condition_variable pending_;
+    std::condition_variable delivered_;
+    std::deque<FramePtr> frames_;
+    std::exception_ptr error_;
+    uint64_t frames_added_{0};
+    bool has_tiles_{false};
+    bool stop_{false};
+  };
+
+  using FrameQueuePtr = std::shared_ptr<FrameQueue>;
+}
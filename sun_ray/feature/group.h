@@ -0,0 +1,141 @@
+//
+//  group.h
+//  sun_ray
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#pragma once
+
+#include <sun_ray/feature/bvh.h>
+#include <sun_ray/feature/object.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_set>
+
+
+namespace sunray
+{
+  class Group;
+  using GroupPtr = std::shared_ptr<const Group>;
+
+  // A group has no surface of its own, it combines its children into a sub tree with a common transformation. The
+  // children are kept in their own bounding volume hierarchy, so a ray that misses the bounding box of the group never
+  // touches any of the children.
+  class Group : public Object
+  {
+  public:
+    explicit Group(std::vector<ObjectPtr> children)
+    : children_{std::move(children)}
+    {
+      init();
+    }
+
+    Group(const Matrix44& transformation, std::vector<ObjectPtr> children)
+    : Object(transformation)
+    , children_{std::move(children)}
+    {
+      init();
+    }
+
+    ~Group() override = default;
+
+    Group(const Group&) = delete;
+    Group(Group&&) = delete;
+    Group& operator=(const Group&) = delete;
+    Group& operator=(Group&&) = delete;
+
+    static GroupPtr make_group(std::vector<ObjectPtr> children)
+    {
+      return std::make_shared<Group>(std::move(children));
+    }
+
+    static GroupPtr make_group(const Matrix44& transformation, std::vector<ObjectPtr> children)
+    {
+      return std::make_shared<Group>(transformation, std::move(children));
+    }
+
+    inline const std::vector<ObjectPtr>& children() const
+    {
+      return children_;
+    }
+
+    inline bool empty() const
+    {
+      return children_.empty();
+    }
+
+  private:
+    void init()
+    {
+      // All children are checked before any of them is adopted, so that a failing group leaves no child pointing to it
+      std::unordered_set<const Object*> adopted;
+      for (const auto& child : children_) {
+        if (!child) {
+          throw std::invalid_argument{"a group must not contain an empty object"};
+        }
+        if (child->parent() || !adopted.insert(child.get()).second) {
+          throw std::invalid_argument{"an object can only be part of one group"};
+        }
+      }
+
+      std::vector<BoundingBox> bounds;
+      for (const auto& child : children_) {
+        child->parent(this);
+
+        const auto child_bounds = child->bounds();
+        bounds_.add(child_bounds);
+        if (child_bounds.is_bounded()) {
+          bounded_children_.push_back(child.get());
+          bounds.push_back(child_bounds);
+        } else {
+          unbounded_children_.push_back(child.get());
+        }
+      }
+      if (!unbounded_children_.empty()) {
+        bounds_ = BoundingBox::infinite();
+      }
+      hierarchy_ = Bvh{bounds};
+    }
+
+    bool do_intersected_by(const Ray& ray, Intersections& intersections) const override
+    {
+      bool is_intersected{false};
+      hierarchy_.traverse(ray, [&](uint32_t index) {
+        is_intersected |= bounded_children_[index]->is_intersected_by(ray, intersections);
+      });
+      for (const auto* child : unbounded_children_) {
+        is_intersected |= child->is_intersected_by(ray, intersections);
+      }
+      return is_intersected;
+    }
+
+    bool do_occluded_by(const Ray& ray, Real max_t) const override
+    {
+      const auto occludes = [&ray, max_t](const Object* child) {
+        return child->occludes(ray, max_t);
+      };
+      return hierarchy_.any_of(ray, max_t, [this, &occludes](uint32_t index) {
+        return occludes(bounded_children_[index]);
+      }) || std::any_of(unbounded_children_.begin(), unbounded_children_.end(), occludes);
+    }
+
+    Vector do_normal_at(const Point&) const override
+    {
+      throw std::runtime_error{"a group has no surface and therefore no normal"};
+    }
+
+    BoundingBox do_bounds() const override
+    {
+      return bounds_;
+    }
+
+    std::vector<ObjectPtr> children_;
+    std::vector<const Object*> bounded_children_;
+    std::vector<const Object*> unbounded_children_;
+    BoundingBox bounds_;
+    Bvh hierarchy_;
+  };
+}
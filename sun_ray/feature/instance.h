@@ -0,0 +1,154 @@
+//
+//  instance.h
+//  sun_ray
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#pragma once
+
+#include <sun_ray/feature/group.h>
+#include <sun_ray/feature/object.h>
+
+#include <optional>
+#include <stdexcept>
+
+
+namespace sunray
+{
+  class Instance;
+  using InstancePtr = std::shared_ptr<const Instance>;
+
+  // Places a shared prototype, e.g. a mesh or a group, into the scene with its own transformation and optionally its own
+  // material, without copying the geometry of the prototype. Intersections with the prototype remember the instance
+  // they have been found through, which is used to convert points and normals between world and object space and to
+  // look up the material. An instance of an instance is flattened into a single instance of the innermost prototype.
+  class Instance : public Object
+  {
+  public:
+    Instance(ObjectPtr prototype, const Matrix44& transformation, bool casts_shadow = true)
+    : Instance(prototype, inherited_material_override(prototype), transformation, casts_shadow)
+    {
+    }
+
+    Instance(ObjectPtr prototype, Material material, const Matrix44& transformation, bool casts_shadow = true)
+    : Instance(std::move(prototype), std::optional<Material>{std::move(material)}, transformation, casts_shadow)
+    {
+    }
+
+    ~Instance() override = default;
+
+    Instance(const Instance&) = delete;
+    Instance(Instance&&) = delete;
+    Instance& operator=(const Instance&) = delete;
+    Instance& operator=(Instance&&) = delete;
+
+    static InstancePtr make_instance(ObjectPtr prototype, const Matrix44& transformation, bool casts_shadow = true)
+    {
+      return std::make_shared<Instance>(std::move(prototype), transformation, casts_shadow);
+    }
+
+    static InstancePtr make_instance(ObjectPtr prototype, Material material, const Matrix44& transformation,
+                                     bool casts_shadow = true)
+    {
+      return std::make_shared<Instance>(std::move(prototype), std::move(material), transformation, casts_shadow);
+    }
+
+    inline const ObjectPtr& prototype() const
+    {
+      return prototype_;
+    }
+
+  private:
+    Instance(ObjectPtr prototype, std::optional<Material> material_override, const Matrix44& transformation,
+             bool casts_shadow)
+    : Object(material_override.value_or(Material{}), combined_transformation(prototype, transformation), casts_shadow)
+    , prototype_{innermost_prototype(std::move(prototype))}
+    , material_override_{std::move(material_override)}
+    {
+      init();
+    }
+
+    static Matrix44 combined_transformation(const ObjectPtr& prototype, const Matrix44& transformation)
+    {
+      if (const auto* instance = dynamic_cast<const Instance*>(prototype.get())) {
+        return transformation * instance->transformation();
+      }
+      return transformation;
+    }
+
+    static ObjectPtr innermost_prototype(ObjectPtr prototype)
+    {
+      if (const auto* instance = dynamic_cast<const Instance*>(prototype.get())) {
+        return instance->prototype_;
+      }
+      return prototype;
+    }
+
+    static bool contains_instance(const Object& object)
+    {
+      if (const auto* group = dynamic_cast<const Group*>(&object)) {
+        for (const auto& child : group->children()) {
+          if (dynamic_cast<const Instance*>(child.get()) || contains_instance(*child)) {
+            return true;
+          }
+        }
+      }
+      return false;
+    }
+
+    static std::optional<Material> inherited_material_override(const ObjectPtr& prototype)
+    {
+      if (const auto* instance = dynamic_cast<const Instance*>(prototype.get())) {
+        return instance->material_override_;
+      }
+      return std::nullopt;
+    }
+
+    void init()
+    {
+      if (!prototype_) {
+        throw std::invalid_argument{"an instance needs a prototype"};
+      }
+      if (prototype_->parent()) {
+        throw std::invalid_argument{"an object being part of a group can not be instanced"};
+      }
+      // The space of an instance is only known while walking up from a hit object, so there is no room for a second one
+      if (contains_instance(*prototype_)) {
+        throw std::invalid_argument{"a group containing instances can not be instanced"};
+      }
+    }
+
+    bool do_intersected_by(const Ray& ray, Intersections& intersections) const override
+    {
+      const auto first = intersections.size();
+      const bool is_intersected = prototype_->is_intersected_by(ray, intersections);
+      intersections.instance(first, this);
+      return is_intersected;
+    }
+
+    bool do_occluded_by(const Ray& ray, Real max_t) const override
+    {
+      return prototype_->occludes(ray, max_t);
+    }
+
+    Vector do_normal_at(const Point&) const override
+    {
+      throw std::runtime_error{"an instance has no surface of its own and therefore no normal"};
+    }
+
+    BoundingBox do_bounds() const override
+    {
+      return prototype_->bounds();
+    }
+
+    const Material* do_material_override() const override
+    {
+      return material_override_ ? &*material_override_ : nullptr;
+    }
+
+    ObjectPtr prototype_;
+    std::optional<Material> material_override_;
+  };
+}
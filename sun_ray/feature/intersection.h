@@ -11,6 +11,8 @@
 #include <sun_ray/feature/math_helper.h>
 
 #include <algorithm>
+#include <array>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -22,9 +24,18 @@ namespace sunray
   class Intersection
   {
   public:
-    Intersection(double t, const Object* object)
+    Intersection() = default;
+
+    Intersection(Real t, const Object* object)
+    : t_{t}
+    , object_{object}
+    {
+    }
+
+    Intersection(Real t, const Object* object, uint32_t face)
     : t_{t}
     , object_{object}
+    , face_{face}
     {
     }
 
@@ -38,7 +49,7 @@ namespace sunray
 
     friend bool operator==(const Intersection& lhs, const Intersection& rhs)
     {
-      return Approx(lhs.t_) == rhs.t_ && lhs.object_ == rhs.object_;
+      return Approx(lhs.t_) == rhs.t_ && lhs.object_ == rhs.object_ && lhs.instance_ == rhs.instance_;
     }
 
     bool operator<(const Intersection& other) const
@@ -46,7 +57,7 @@ namespace sunray
       return t_ < other.t_;
     }
 
-    inline double time() const
+    inline Real time() const
     {
       return t_;
     }
@@ -56,20 +67,95 @@ namespace sunray
       return object_;
     }
 
+    // Index of the face that has been hit, for objects made of several faces like triangle meshes
+    inline uint32_t face() const
+    {
+      return face_;
+    }
+
+    // Instance through which the object has been hit, nullptr if the object has been hit directly
+    inline const Object* instance() const
+    {
+      return instance_;
+    }
+
+    // Same object hit through the same instance
+    inline bool is_same_surface(const Intersection& other) const
+    {
+      return object_ == other.object_ && instance_ == other.instance_;
+    }
+
   private:
-    double t_;
-    const Object* object_;
+    friend class Intersections;
+
+    Real t_{0.0};
+    const Object* object_{nullptr};
+    uint32_t face_{0};
+    const Object* instance_{nullptr};
   };
 
 
-  class Intersections
+  // Read only view of a contiguous range of intersections
+  class IntersectionList
   {
   public:
-    Intersections()
+    IntersectionList(const Intersection* first, size_t size)
+    : first_{first}
+    , size_{size}
+    {
+    }
+
+    inline const Intersection* begin() const
+    {
+      return first_;
+    }
+
+    inline const Intersection* end() const
+    {
+      return first_ + size_;
+    }
+
+    inline size_t size() const
+    {
+      return size_;
+    }
+
+    inline bool empty() const
+    {
+      return size_ == 0;
+    }
+
+    inline const Intersection& operator[](size_t index) const
+    {
+      return first_[index];
+    }
+
+    inline const Intersection& front() const
     {
-      intersections_.reserve(20);
+      return first_[0];
     }
 
+    inline const Intersection& back() const
+    {
+      return first_[size_ - 1];
+    }
+
+  private:
+    const Intersection* first_;
+    size_t size_;
+  };
+
+
+  // Collects the intersections of a ray. The first intersections are kept in place, only rays crossing many surfaces move
+  // them to the heap. The closest intersection in front of the origin is tracked while adding, so looking up the hit
+  // needs no sorting. The intersections are only sorted, when the ordered list is requested.
+  class Intersections
+  {
+  public:
+    static constexpr size_t inline_capacity = 20;
+
+    Intersections() = default;
+
     ~Intersections() = default;
 
     Intersections(const Intersections&) = delete;
@@ -79,33 +165,77 @@ namespace sunray
 
     void clear()
     {
-      intersections_.clear();
+      heap_.clear();
+      size_ = 0;
+      closest_ = none;
+      is_sorted_ = true;
     }
 
     void add(Intersection&& intersection)
     {
-      intersections_.emplace_back(std::move(intersection));
+      if (intersection.time() > 0 && (closest_ == none || intersection.time() < data()[closest_].time())) {
+        closest_ = size_;
+      }
+      if (size_ < inline_capacity) {
+        inline_[size_] = std::move(intersection);
+      } else {
+        if (size_ == inline_capacity) {
+          heap_.reserve(2 * inline_capacity);
+          heap_.assign(inline_.begin(), inline_.end());
+        }
+        heap_.emplace_back(std::move(intersection));
+      }
+      ++size_;
+      is_sorted_ = false;
     }
 
-    const Intersection* hit() const
+    inline size_t size() const
+    {
+      return size_;
+    }
+
+    // Marks all intersections added since position from as hits through the given instance
+    void instance(size_t from, const Object* instance)
     {
-      std::sort(intersections_.begin(), intersections_.end());
-      auto it = std::find_if(intersections_.begin(), intersections_.end(), [](const auto& intersection) {
-        return intersection.time() > 0;
-      });
-      if (it != intersections_.end()) {
-        return &(*it);
+      auto* intersections = data();
+      for (auto n = from; n < size_; ++n) {
+        intersections[n].instance_ = instance;
       }
-      return nullptr;
     }
 
-    const std::vector<Intersection>& intersections() const
+    const Intersection* hit() const
     {
-      std::sort(intersections_.begin(), intersections_.end());
-      return intersections_;
+      return closest_ == none ? nullptr : &data()[closest_];
+    }
+
+    IntersectionList intersections() const
+    {
+      if (!is_sorted_) {
+        auto* intersections = data();
+        std::sort(intersections, intersections + size_);
+        if (closest_ != none) {
+          const auto it = std::find_if(intersections, intersections + size_, [](const auto& intersection) {
+            return intersection.time() > 0;
+          });
+          closest_ = static_cast<size_t>(it - intersections);
+        }
+        is_sorted_ = true;
+      }
+      return IntersectionList{data(), size_};
     }
 
   private:
-    mutable std::vector<Intersection> intersections_;
+    static constexpr size_t none = std::numeric_limits<size_t>::max();
+
+    Intersection* data() const
+    {
+      return size_ > inline_capacity ? heap_.data() : inline_.data();
+    }
+
+    mutable std::array<Intersection, inline_capacity> inline_;
+    mutable std::vector<Intersection> heap_;
+    size_t size_{0};
+    mutable size_t closest_{none};
+    mutable bool is_sorted_{true};
   };
 }
@@ -10,6 +10,10 @@
 
 #include <sun_ray/feature/object.h>
 
+#include <algorithm>
+#include <array>
+#include <vector>
+
 
 namespace sunray
 {
@@ -21,7 +25,7 @@ namespace sunray
     {
       point_ = ray.position(intersection_.time());
       eye_ = -ray.direction();
-      normal_ = intersection_.object()->normal_at(point_);
+      normal_ = intersection_.object()->normal_at(point_, intersection_);
       if (normal_.scalarProduct(eye_) < 0) {
         inside_ = true;
         normal_ = normal_.negate();
@@ -96,45 +100,57 @@ namespace sunray
 
       if (n1_ > n2_) {
         const auto n = n1_ / n2_;
-        const auto sin2_t = n * n * (1.0 - cos * cos);
+        const auto sin2_t = n * n * (1 - cos * cos);
         if (sin2_t > 1.0) {
           return 1.0;
         }
 
-        cos = sqrt(1.0 - sin2_t);
+        cos = sqrt(1 - sin2_t);
       }
 
       const auto r0 = pow<2>((n1_ - n2_) / (n1_ + n2_));
-      return static_cast<float>(r0 + (1.0 - r0) * pow<5>(1.0 - cos));
+      return static_cast<float>(r0 + (1.0 - r0) * pow<5>(1 - cos));
     }
 
   private:
     void calculate_refraction_indices(const Intersections& intersections)
     {
-      std::vector<const Object*> objects;
-      objects.reserve(20);
+      // Containers are identified by their intersection, as an object hit through several instances forms distinct surfaces.
+      // There are at most as many containers as intersections, which fit into the inline buffer, unless the intersections
+      // have been moved to the heap as well.
+      std::array<const Intersection*, Intersections::inline_capacity> inline_objects;
+      std::vector<const Intersection*> heap_objects;
+      auto* objects = inline_objects.data();
+      if (intersections.size() > inline_objects.size()) {
+        heap_objects.resize(intersections.size());
+        objects = heap_objects.data();
+      }
+      size_t count{0};
 
       for (const auto& intersection : intersections.intersections()) {
         if (intersection == intersection_) {
-          if (objects.empty()) {
+          if (count == 0) {
             n1_ = 1.0f;
           } else {
-            n1_ = objects.back()->material().refractive_index();
+            n1_ = material_of(*objects[count - 1]).refractive_index();
           }
         }
 
-        auto it = std::find(objects.begin(), objects.end(), intersection.object());
-        if (it != objects.end()) {
-          objects.erase(it);
+        auto* it = std::find_if(objects, objects + count, [&intersection](const auto* container) {
+          return container->is_same_surface(intersection);
+        });
+        if (it != objects + count) {
+          std::copy(it + 1, objects + count, it);
+          --count;
         } else {
-          objects.emplace_back(intersection.object());
+          objects[count++] = &intersection;
         }
 
         if (intersection == intersection_) {
-          if (objects.empty()) {
+          if (count == 0) {
             n2_ = 1.0;
           } else {
-            n2_ = objects.back()->material().refractive_index();
+            n2_ = material_of(*objects[count - 1]).refractive_index();
           }
 
           break;
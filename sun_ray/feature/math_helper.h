@@ -14,7 +14,22 @@
 
 namespace sunray
 {
-  static constexpr double epsilon = 0.0001f;
+  // Geometry is computed in double precision, unless SUNRAY_FLOAT is defined. Floats halve the size of tuples and
+  // matrices and fill twice as many lanes of a SIMD register. Both use the same epsilon to offset the points of shadow
+  // and reflection rays, a larger one moves the edges of shadows and reflections away from the double render.
+#ifdef SUNRAY_FLOAT
+  using Real = float;
+#else
+  using Real = double;
+#endif
+  static constexpr Real epsilon = 0.0001f;
+  // Single precision rounds the discriminant of tangent rays slightly below zero and misses hits on the rim of caps, which
+  // are accepted within this tolerance. Double precision keeps the exact tests.
+#ifdef SUNRAY_FLOAT
+  static constexpr Real rounding_tolerance = epsilon;
+#else
+  static constexpr Real rounding_tolerance = 0;
+#endif
   static constexpr double PI = 3.14159265358979323846;
   static constexpr double PIdiv180 = 0.017453292519943296;
   static constexpr double PIdiv180inv = 57.2957795130823229;
@@ -30,21 +45,21 @@ namespace sunray
     return angle * PIdiv180inv;
   }
 
-  inline double abs(double arg)
+  inline Real abs(Real arg)
   {
-    return ::fabs(arg);
+    return std::fabs(arg);
   }
-  inline double sqrt(double arg)
+  inline Real sqrt(Real arg)
   {
-    return ::sqrt(arg);
+    return std::sqrt(arg);
   }
-  inline double sin(double arg)
+  inline Real sin(Real arg)
   {
-    return ::sin(arg);
+    return std::sin(arg);
   }
-  inline double cos(double arg)
+  inline Real cos(Real arg)
   {
-    return ::cos(arg);
+    return std::cos(arg);
   }
   inline uint16_t round(float val)
   {
@@ -60,19 +75,19 @@ namespace sunray
   }
 
   template<int n>
-  double pow(double v)
+  Real pow(Real v)
   {
     static_assert(n > 0, "Power can’t be negative");
-    double n2 = pow<n / 2>(v);
+    Real n2 = pow<n / 2>(v);
     return n2 * n2 * pow<n & 1>(v);
   }
   template<>
-  inline double pow<1>(double v)
+  inline Real pow<1>(Real v)
   {
     return v;
   }
   template<>
-  inline double pow<0>(double)
+  inline Real pow<0>(Real)
   {
     return 1;
   }
@@ -10,6 +10,9 @@
 
 #include <sun_ray/feature/tuple.h>
 
+#include <cmath>
+#include <cstring>
+
 
 namespace sunray
 {
@@ -49,7 +52,7 @@ namespace sunray
   {
   public:
     static constexpr uint8_t elements = 4;
-    using Mat = std::array<double, elements>;
+    using Mat = std::array<Real, elements>;
 
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
     explicit Matrix22(const Mat& m)
@@ -80,12 +83,12 @@ namespace sunray
       return Approx(m_[0]) != rhs.m_[0] || Approx(m_[1]) != rhs.m_[1] || Approx(m_[2]) != rhs.m_[2] || Approx(m_[3]) != rhs.m_[3];
     }
 
-    double operator[](uint8_t n) const
+    Real operator[](uint8_t n) const
     {
       return m_.at(n);
     }
 
-    double determinant() const
+    Real determinant() const
     {
       return m_[0] * m_[3] - m_[1] * m_[2];
     }
@@ -106,7 +109,7 @@ namespace sunray
   {
   public:
     static constexpr uint8_t elements = 9;
-    using Mat = std::array<double, elements>;
+    using Mat = std::array<Real, elements>;
 
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
     explicit Matrix33(const Mat& m)
@@ -141,7 +144,7 @@ namespace sunray
              Approx(m_[6]) != rhs.m_[6] || Approx(m_[7]) != rhs.m_[7] || Approx(m_[8]) != rhs.m_[8];
     }
 
-    double operator[](uint8_t n) const
+    Real operator[](uint8_t n) const
     {
       return m_.at(n);
     }
@@ -169,18 +172,18 @@ namespace sunray
       return Matrix22{m};
     }
 
-    double minor(uint8_t row, uint8_t column) const
+    Real minor(uint8_t row, uint8_t column) const
     {
       return submatrix(row, column).determinant();
     }
 
-    double cofactor(uint8_t row, uint8_t column) const
+    Real cofactor(uint8_t row, uint8_t column) const
     {
       static Mat factors = {1, -1, 1, -1, 1, -1, 1, -1, 1};
       return minor(row, column) * factors[row * 3 + column];
     }
 
-    double determinant() const
+    Real determinant() const
     {
       return m_[0] * cofactor(0, 0) + m_[1] * cofactor(0, 1) + m_[2] * cofactor(0, 2);
     }
@@ -202,16 +205,18 @@ namespace sunray
   {
   public:
     static constexpr uint8_t elements = 16;
-    using Mat = std::array<double, elements>;
+    using Mat = std::array<Real, elements>;
 
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
     explicit Matrix44(const Mat& m)
     {
       std::copy(m.begin(), m.end(), m_.begin());
+      affine_ = has_affine_row(m_);
     }
 
     explicit Matrix44(Mat&& m) noexcept
     : m_{m}
+    , affine_{has_affine_row(m_)}
     {
     }
 
@@ -219,11 +224,13 @@ namespace sunray
     Matrix44(const Matrix44& m)
     {
       std::copy(m.m_.begin(), m.m_.end(), m_.begin());
+      affine_ = m.affine_;
     }
 
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
     Matrix44(Matrix44&& m) noexcept
     : m_{m.m_}
+    , affine_{m.affine_}
     {
     }
 
@@ -252,12 +259,12 @@ namespace sunray
              Approx(m_[15]) != rhs.m_[15];
     }
 
-    double operator[](uint8_t n) const
+    Real operator[](uint8_t n) const
     {
       return m_.at(n);
     }
 
-    double operator[](Index i) const
+    Real operator[](Index i) const
     {
       return m_[(i.row() * 4) + i.column()];
     }
@@ -280,6 +287,13 @@ namespace sunray
       m[10] = lhs[8] * rhs[2] + lhs[9] * rhs[6] + lhs[10] * rhs[10] + lhs[11] * rhs[14];
       m[11] = lhs[8] * rhs[3] + lhs[9] * rhs[7] + lhs[10] * rhs[11] + lhs[11] * rhs[15];
 
+      if (lhs.affine_ && rhs.affine_) {
+        m[12] = 0.0;
+        m[13] = 0.0;
+        m[14] = 0.0;
+        m[15] = 1.0;
+        return Matrix44{m};
+      }
       m[12] = lhs[12] * rhs[0] + lhs[13] * rhs[4] + lhs[14] * rhs[8] + lhs[15] * rhs[12];
       m[13] = lhs[12] * rhs[1] + lhs[13] * rhs[5] + lhs[14] * rhs[9] + lhs[15] * rhs[13];
       m[14] = lhs[12] * rhs[2] + lhs[13] * rhs[6] + lhs[14] * rhs[10] + lhs[15] * rhs[14];
@@ -287,13 +301,19 @@ namespace sunray
       return Matrix44{m};
     }
 
+    // The bottom row of an affine matrix is skipped, it keeps w
     friend Tuple operator*(const Matrix44& lhs, const Tuple& rhs)
     {
+      const Real* m = lhs.m_.data();
+      const Real x = rhs.x();
+      const Real y = rhs.y();
+      const Real z = rhs.z();
+      const Real w = rhs.w();
       Tuple::Vec v;
-      v[0] = lhs[0] * rhs[0] + lhs[1] * rhs[1] + lhs[2] * rhs[2] + lhs[3] * rhs[3];
-      v[1] = lhs[4] * rhs[0] + lhs[5] * rhs[1] + lhs[6] * rhs[2] + lhs[7] * rhs[3];
-      v[2] = lhs[8] * rhs[0] + lhs[9] * rhs[1] + lhs[10] * rhs[2] + lhs[11] * rhs[3];
-      v[3] = lhs[12] * rhs[0] + lhs[13] * rhs[1] + lhs[14] * rhs[2] + lhs[15] * rhs[3];
+      v[0] = m[0] * x + m[1] * y + m[2] * z + m[3] * w;
+      v[1] = m[4] * x + m[5] * y + m[6] * z + m[7] * w;
+      v[2] = m[8] * x + m[9] * y + m[10] * z + m[11] * w;
+      v[3] = lhs.affine_ ? w : m[12] * x + m[13] * y + m[14] * z + m[15] * w;
       return Tuple{v};
     }
 
@@ -330,12 +350,12 @@ namespace sunray
       return Matrix33{m};
     }
 
-    double minor(uint8_t row, uint8_t column) const
+    Real minor(uint8_t row, uint8_t column) const
     {
       return submatrix(row, column).determinant();
     }
 
-    double cofactor(uint8_t row, uint8_t column) const
+    Real cofactor(uint8_t row, uint8_t column) const
     {
       // clang-format off
       static Mat factors = {1,-1, 1,-1,
@@ -346,9 +366,14 @@ namespace sunray
       return minor(row, column) * factors[row * 4 + column];
     }
 
-    double determinant() const
+    Real determinant() const
     {
-      return m_[0] * cofactor(0, 0) + m_[1] * cofactor(0, 1) + m_[2] * cofactor(0, 2) + m_[3] * cofactor(0, 3);
+      if (affine_) {
+        return m_[0] * (m_[5] * m_[10] - m_[6] * m_[9]) - m_[1] * (m_[4] * m_[10] - m_[6] * m_[8]) +
+               m_[2] * (m_[4] * m_[9] - m_[5] * m_[8]);
+      }
+      const auto minors = Minors{m_};
+      return minors.determinant();
     }
 
     bool is_invertible() const
@@ -356,25 +381,85 @@ namespace sunray
       return determinant() != Approx(0.0);
     }
 
+    // The bottom row is 0, 0, 0, 1, as for all compositions of translations, scalings, rotations and shearings
+    inline bool is_affine() const
+    {
+      return affine_;
+    }
+
     Matrix44 inverse() const
     {
-      const auto det = determinant();
+      if (affine_) {
+        return affine_inverse();
+      }
+
+      // Closed form from the 2x2 minors of the upper and the lower two rows
+      const auto minors = Minors{m_};
+      const auto det = minors.determinant();
       if (det == Approx(0.0)) {
         throw std::runtime_error{"matrix is not inversible"};
       }
-      Matrix44::Mat mat;
+      const auto& [s0, s1, s2, s3, s4, s5, c0, c1, c2, c3, c4, c5] = minors;
+      const auto f = Real{1} / det;
 
-      for (uint8_t r = 0; r < 4; ++r) {
-        for (uint8_t c = 0; c < 4; ++c) {
-          auto co = cofactor(r, c);
-          mat[c * 4 + r] = co / det;
-        }
+      // clang-format off
+      return Matrix44{{( m_[5] * c5 - m_[6] * c4 + m_[7] * c3) * f,
+                       (-m_[1] * c5 + m_[2] * c4 - m_[3] * c3) * f,
+                       ( m_[13] * s5 - m_[14] * s4 + m_[15] * s3) * f,
+                       (-m_[9] * s5 + m_[10] * s4 - m_[11] * s3) * f,
+
+                       (-m_[4] * c5 + m_[6] * c2 - m_[7] * c1) * f,
+                       ( m_[0] * c5 - m_[2] * c2 + m_[3] * c1) * f,
+                       (-m_[12] * s5 + m_[14] * s2 - m_[15] * s1) * f,
+                       ( m_[8] * s5 - m_[10] * s2 + m_[11] * s1) * f,
+
+                       ( m_[4] * c4 - m_[5] * c2 + m_[7] * c0) * f,
+                       (-m_[0] * c4 + m_[1] * c2 - m_[3] * c0) * f,
+                       ( m_[12] * s4 - m_[13] * s2 + m_[15] * s0) * f,
+                       (-m_[8] * s4 + m_[9] * s2 - m_[11] * s0) * f,
+
+                       (-m_[4] * c3 + m_[5] * c1 - m_[6] * c0) * f,
+                       ( m_[0] * c3 - m_[1] * c1 + m_[2] * c0) * f,
+                       (-m_[12] * s3 + m_[13] * s1 - m_[14] * s0) * f,
+                       ( m_[8] * s3 - m_[9] * s1 + m_[10] * s0) * f }};
+      // clang-format on
+    }
+
+    // Inverts the upper 3x3 matrix and moves by the inverted translation, which is all an affine matrix needs
+    Matrix44 affine_inverse() const
+    {
+      if (!affine_) {
+        throw std::runtime_error{"matrix is not affine"};
+      }
+
+      const auto c00 = m_[5] * m_[10] - m_[6] * m_[9];
+      const auto c01 = m_[6] * m_[8] - m_[4] * m_[10];
+      const auto c02 = m_[4] * m_[9] - m_[5] * m_[8];
+      const auto det = m_[0] * c00 + m_[1] * c01 + m_[2] * c02;
+      if (det == Approx(0.0)) {
+        throw std::runtime_error{"matrix is not inversible"};
       }
+      const auto f = Real{1} / det;
+
+      const auto i00 = c00 * f;
+      const auto i01 = (m_[2] * m_[9] - m_[1] * m_[10]) * f;
+      const auto i02 = (m_[1] * m_[6] - m_[2] * m_[5]) * f;
+      const auto i10 = c01 * f;
+      const auto i11 = (m_[0] * m_[10] - m_[2] * m_[8]) * f;
+      const auto i12 = (m_[2] * m_[4] - m_[0] * m_[6]) * f;
+      const auto i20 = c02 * f;
+      const auto i21 = (m_[1] * m_[8] - m_[0] * m_[9]) * f;
+      const auto i22 = (m_[0] * m_[5] - m_[1] * m_[4]) * f;
 
-      return Matrix44{mat};
+      // clang-format off
+      return Matrix44{{ i00, i01, i02, -(i00 * m_[3] + i01 * m_[7] + i02 * m_[11]),
+                        i10, i11, i12, -(i10 * m_[3] + i11 * m_[7] + i12 * m_[11]),
+                        i20, i21, i22, -(i20 * m_[3] + i21 * m_[7] + i22 * m_[11]),
+                          0,   0,   0, 1 }};
+      // clang-format on
     }
 
-    static Matrix44 translation(double x, double y, double z)
+    static Matrix44 translation(Real x, Real y, Real z)
     {
       // clang-format off
       return Matrix44{{ 1, 0, 0, x,
@@ -384,7 +469,7 @@ namespace sunray
       // clang-format on
     }
 
-    static Matrix44 scaling(double x, double y, double z)
+    static Matrix44 scaling(Real x, Real y, Real z)
     {
       // clang-format off
       return Matrix44{{ x, 0, 0, 0,
@@ -394,7 +479,7 @@ namespace sunray
       // clang-format on
     }
 
-    static Matrix44 rotation_x(double radians)
+    static Matrix44 rotation_x(Real radians)
     {
       // clang-format off
       return Matrix44{{ 1,            0,            0, 0,
@@ -404,7 +489,7 @@ namespace sunray
       // clang-format on
     }
 
-    static Matrix44 rotation_y(double radians)
+    static Matrix44 rotation_y(Real radians)
     {
       // clang-format off
       return Matrix44{{ cos(radians), 0, sin(radians), 0,
@@ -414,7 +499,7 @@ namespace sunray
       // clang-format on
     }
 
-    static Matrix44 rotation_z(double radians)
+    static Matrix44 rotation_z(Real radians)
     {
       // clang-format off
       return Matrix44{{ cos(radians),-sin(radians), 0, 0,
@@ -424,7 +509,7 @@ namespace sunray
       // clang-format on
     }
 
-    static Matrix44 shearing(double xy, double xz, double yx, double yz, double zx, double zy)
+    static Matrix44 shearing(Real xy, Real xz, Real yx, Real yz, Real zx, Real zy)
     {
       // clang-format off
       return Matrix44{{  1, xy, xz, 0,
@@ -455,6 +540,43 @@ namespace sunray
     }
 
   private:
+    // The 2x2 minors of the upper two rows, s0 to s5, and of the lower two rows, c0 to c5, shared by the determinant and
+    // all cofactors
+    struct Minors {
+      explicit Minors(const Mat& m)
+      : s0{m[0] * m[5] - m[4] * m[1]}
+      , s1{m[0] * m[6] - m[4] * m[2]}
+      , s2{m[0] * m[7] - m[4] * m[3]}
+      , s3{m[1] * m[6] - m[5] * m[2]}
+      , s4{m[1] * m[7] - m[5] * m[3]}
+      , s5{m[2] * m[7] - m[6] * m[3]}
+      , c0{m[8] * m[13] - m[12] * m[9]}
+      , c1{m[8] * m[14] - m[12] * m[10]}
+      , c2{m[8] * m[15] - m[12] * m[11]}
+      , c3{m[9] * m[14] - m[13] * m[10]}
+      , c4{m[9] * m[15] - m[13] * m[11]}
+      , c5{m[10] * m[15] - m[14] * m[11]}
+      {
+      }
+
+      Real determinant() const
+      {
+        return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+      }
+
+      Real s0, s1, s2, s3, s4, s5;
+      Real c0, c1, c2, c3, c4, c5;
+    };
+
+    // Either sign of zero, but exactly one
+    static bool has_affine_row(const Mat& m)
+    {
+      static constexpr Real one{1.0};
+      return std::fpclassify(m[12]) == FP_ZERO && std::fpclassify(m[13]) == FP_ZERO && std::fpclassify(m[14]) == FP_ZERO &&
+             memcmp(&m[15], &one, sizeof(one)) == 0;
+    }
+
     Mat m_;
+    bool affine_{false};
   };
 }
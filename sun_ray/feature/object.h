@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <sun_ray/feature/affine_transform.h>
+#include <sun_ray/feature/bounding_box.h>
 #include <sun_ray/feature/intersection.h>
 #include <sun_ray/feature/material.h>
 #include <sun_ray/feature/ray.h>
@@ -15,6 +17,9 @@
 
 namespace sunray
 {
+  class Object;
+  using ObjectPtr = std::shared_ptr<const Object>;
+
   class Object
   {
   public:
@@ -30,18 +35,65 @@ namespace sunray
       return inverse_transformation_;
     }
 
+    // The kind of the inverse transformation, which is the same as the one of the transformation
+    inline TransformKind transform_kind() const
+    {
+      return inverse_.kind();
+    }
+
     bool is_intersected_by(const Ray& ray, Intersections& intersections) const
     {
-      return do_intersected_by(ray.transform(inverse_transformation()), intersections);
+      return with_local_ray(ray, [this, &intersections](const Ray& local_ray) {
+        return do_intersected_by(local_ray, intersections);
+      });
+    }
+
+    // Checks whether the object blocks the ray between its origin and max_t, e.g. on the way to a light. Objects not
+    // casting a shadow never block a ray.
+    bool occludes(const Ray& ray, Real max_t) const
+    {
+      return casts_shadow_ && with_local_ray(ray, [this, max_t](const Ray& local_ray) {
+               return do_occluded_by(local_ray, max_t);
+             });
     }
 
     Vector normal_at(const Point& world_point) const
     {
-      const auto& m = inverse_transformation();
-      const auto local_point = m * world_point;
-      const auto local_normal = do_normal_at(local_point);
-      const auto world_normal = m.transpose() * local_normal;
-      return Tuple(world_normal.x(), world_normal.y(), world_normal.z(), 0.0).normalize();
+      return normal_to_world(do_normal_at(world_to_object(world_point)));
+    }
+
+    Vector normal_at(const Point& world_point, const Intersection& hit) const
+    {
+      const auto local_point = world_to_object(world_point, hit.instance());
+      return normal_to_world(do_normal_at_face(local_point, hit.face()), hit.instance());
+    }
+
+    // Converts a point from world space into object space, passing through the spaces of all enclosing groups. An object
+    // hit through an instance additionally passes through the space of the instance, which takes the place of the parent
+    // of the topmost group.
+    Point world_to_object(const Point& world_point, const Object* instance = nullptr) const
+    {
+      if (parent_) {
+        return to_object(parent_->world_to_object(world_point, instance));
+      }
+      return to_object(instance ? instance->world_to_object(world_point) : world_point);
+    }
+
+    Vector normal_to_world(const Vector& object_normal, const Object* instance = nullptr) const
+    {
+      const auto normal = normal_matrix_ * object_normal;
+      const auto world_normal = Tuple(normal.x(), normal.y(), normal.z(), 0.0).normalize();
+      if (parent_) {
+        return parent_->normal_to_world(world_normal, instance);
+      }
+      return instance ? instance->normal_to_world(world_normal) : world_normal;
+    }
+
+    // Axis aligned bounding box of the object in the coordinate system of its parent, i.e. with the object transformation
+    // applied. Unbounded objects like planes return an infinite box.
+    BoundingBox bounds() const
+    {
+      return do_bounds().transform(transformation());
     }
 
     inline const Point& origin() const
@@ -64,6 +116,17 @@ namespace sunray
       return casts_shadow_;
     }
 
+    inline const Object* parent() const
+    {
+      return parent_;
+    }
+
+    // Material replacing the materials of all objects hit through this object, nullptr if there is none
+    const Material* material_override() const
+    {
+      return do_material_override();
+    }
+
   protected:
     Object() = default;
 
@@ -87,15 +150,76 @@ namespace sunray
     }
 
   private:
+    friend class Group;
+
+    // Objects are immutable once created, only the group adopting an object sets its parent
+    void parent(const Object* parent) const
+    {
+      parent_ = parent;
+    }
+
+    // Calls the function with the ray in object space, which is the ray itself without a transformation. The compact
+    // inverse applies all affine transformations, only a general one needs the full matrix.
+    template <typename Function>
+    bool with_local_ray(const Ray& ray, const Function& function) const
+    {
+      switch (inverse_.kind()) {
+        case TransformKind::identity:
+          return function(ray);
+        case TransformKind::general:
+          return function(ray.transform(inverse_transformation_));
+        default:
+          return function(inverse_.transform(ray));
+      }
+    }
+
+    Point to_object(const Point& point) const
+    {
+      if (inverse_.kind() == TransformKind::general) {
+        return inverse_transformation_ * point;
+      }
+      return inverse_ * point;
+    }
+
     virtual bool do_intersected_by(const Ray& ray, Intersections& intersections) const = 0;
 
+    // Objects able to stop at the first hit override this, by default all intersections are collected
+    virtual bool do_occluded_by(const Ray& ray, Real max_t) const
+    {
+      Intersections intersections;
+      do_intersected_by(ray, intersections);
+      const auto* hit = intersections.hit();
+      return hit && hit->time() < max_t;
+    }
+
     virtual Vector do_normal_at(const Point& point) const = 0;
 
+    // Objects made of several faces override this to look up the normal of the face that has been hit
+    virtual Vector do_normal_at_face(const Point& point, uint32_t face) const
+    {
+      (void)face;
+      return do_normal_at(point);
+    }
+
+    virtual BoundingBox do_bounds() const
+    {
+      return BoundingBox::infinite();
+    }
+
+    virtual const Material* do_material_override() const
+    {
+      return nullptr;
+    }
+
     Point origin_{create_point(0, 0, 0)};
     Material material_;
     const Matrix44 transformation_{Matrix44::identity()};
     const Matrix44 inverse_transformation_{Matrix44::identity().inverse()};
+    // Upper three rows of the inverse transformation and the inverse transposed without translation for the normals
+    const AffineTransform inverse_{inverse_transformation_};
+    const AffineTransform normal_matrix_{AffineTransform::normal_matrix(inverse_transformation_)};
     bool casts_shadow_{true};
+    mutable const Object* parent_{nullptr};
   };
 
   inline Intersections intersect(const Ray& ray, const Object& object)
@@ -105,35 +229,59 @@ namespace sunray
     return intersections;
   }
 
-  inline Color apply_pattern(const Pattern& pattern, const Object& object, const Point& position)
+  inline Color apply_pattern(const Pattern& pattern, const Object& object, const Point& position,
+                             const Object* instance = nullptr)
   {
-    auto object_point = object.inverse_transformation() * position;
+    auto object_point = object.world_to_object(position, instance);
     auto pattern_point = pattern.inverse_transformation() * object_point;
     return pattern.pattern_at(pattern_point);
   }
 
-  inline Color lighting(const Object& object, const PointLight& light, const Point& position, const Vector& eye,
-                        const Vector& normal, bool is_in_shadow)
+  // Material of the surface hit, which is the override of the instance the object has been hit through, if any
+  inline const Material& material_of(const Intersection& hit)
+  {
+    if (hit.instance()) {
+      if (const auto* material = hit.instance()->material_override()) {
+        return *material;
+      }
+    }
+    return hit.object()->material();
+  }
+
+  inline Color lighting(const Material& material, const Object& object, const PointLight& light, const Point& position,
+                        const Vector& eye, const Vector& normal, bool is_in_shadow, const Object* instance = nullptr)
   {
-    Color color{object.material().color()};
-    if (object.material().pattern()) {
-      color = apply_pattern(*object.material().pattern(), object, position);
+    Color color{material.color()};
+    if (material.pattern()) {
+      color = apply_pattern(*material.pattern(), object, position, instance);
     }
     const auto effective_color = color * light.intensity();
     const auto lightv = (light.position() - position).normalize();
-    const auto effective_ambient = effective_color * object.material().ambient();
+    const auto effective_ambient = effective_color * material.ambient();
     const auto light_dot_normal = static_cast<float>(lightv.scalarProduct(normal));
     if (light_dot_normal < 0.0 || is_in_shadow) {
       return effective_ambient;
     }
-    const auto effective_diffuse = effective_color * object.material().diffuse() * light_dot_normal;
+    const auto effective_diffuse = effective_color * material.diffuse() * light_dot_normal;
     const auto reflectv = lightv.negate().reflect(normal);
     const auto reflect_dot_eye = static_cast<float>(reflectv.scalarProduct(eye));
     if (reflect_dot_eye <= 0.0) {
       return effective_ambient + effective_diffuse;
     }
-    const auto factor = powf(reflect_dot_eye, object.material().shininess());
-    const auto effective_specular = light.intensity() * object.material().specular() * factor;
+    const auto factor = powf(reflect_dot_eye, material.shininess());
+    const auto effective_specular = light.intensity() * material.specular() * factor;
     return effective_ambient + effective_diffuse + effective_specular;
   }
+
+  inline Color lighting(const Object& object, const PointLight& light, const Point& position, const Vector& eye,
+                        const Vector& normal, bool is_in_shadow)
+  {
+    return lighting(object.material(), object, light, position, eye, normal, is_in_shadow);
+  }
+
+  inline Color lighting(const Intersection& hit, const PointLight& light, const Point& position, const Vector& eye,
+                        const Vector& normal, bool is_in_shadow)
+  {
+    return lighting(material_of(hit), *hit.object(), light, position, eye, normal, is_in_shadow, hit.instance());
+  }
 }
@@ -0,0 +1,100 @@
+//
+//  pixel_sampler.h
+//  sun_ray
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#pragma once
+
+#include <cmath>
+#include <utility>
+
+
+namespace sunray
+{
+  enum class ReconstructionFilter { BOX, GAUSSIAN };
+
+
+  // Sub-pixel sample positions of a single pixel. The positions follow the R2 low discrepancy sequence, which is shifted by
+  // a random offset per pixel to avoid patterns across the image. The offset is derived from the pixel coordinates only,
+  // so a pixel gets the same samples regardless of the thread or the order it is rendered in.
+  class PixelSampler
+  {
+  public:
+    struct Sample {
+      // Position relative to the top left corner of the pixel
+      double x_;
+      double y_;
+      float weight_;
+    };
+
+    PixelSampler(uint32_t x, uint32_t y, ReconstructionFilter filter)
+    : filter_{filter}
+    {
+      const auto seed = hash((static_cast<uint64_t>(y) << 32) | x);
+      rotation_x_ = to_unit(seed);
+      rotation_y_ = to_unit(hash(seed));
+    }
+
+    ~PixelSampler() = default;
+
+    PixelSampler(const PixelSampler&) = delete;
+    PixelSampler(PixelSampler&&) = delete;
+    PixelSampler& operator=(const PixelSampler&) = delete;
+    PixelSampler& operator=(PixelSampler&&) = delete;
+
+    // The box filter spreads the samples evenly over the pixel. The gaussian filter samples a square of twice the size
+    // around the center of the pixel and weights each sample by its distance to the center.
+    Sample sample(uint32_t index) const
+    {
+      const auto offset = r2(index);
+      const auto u = fraction(offset.first + rotation_x_);
+      const auto v = fraction(offset.second + rotation_y_);
+      if (filter_ == ReconstructionFilter::BOX) {
+        return Sample{u, v, 1.0f};
+      }
+
+      const auto dx = 2.0 * u - 1.0;
+      const auto dy = 2.0 * v - 1.0;
+      const auto weight = std::exp(-(dx * dx + dy * dy) / (2.0 * gaussian_sigma * gaussian_sigma));
+      return Sample{0.5 + dx, 0.5 + dy, static_cast<float>(weight)};
+    }
+
+    // The n-th point of the R2 sequence, the first one is the center of the unit square
+    static std::pair<double, double> r2(uint32_t index)
+    {
+      constexpr double alpha_x = 0.7548776662466927;
+      constexpr double alpha_y = 0.5698402909980532;
+      return std::make_pair(fraction(0.5 + alpha_x * index), fraction(0.5 + alpha_y * index));
+    }
+
+    // SplitMix64 finalizer
+    static uint64_t hash(uint64_t value)
+    {
+      value += 0x9e3779b97f4a7c15;
+      value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9;
+      value = (value ^ (value >> 27)) * 0x94d049bb133111eb;
+      return value ^ (value >> 31);
+    }
+
+    // Maps a hash to [0, 1)
+    static double to_unit(uint64_t value)
+    {
+      return static_cast<double>(value >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+  private:
+    static constexpr double gaussian_sigma = 0.5;
+
+    static double fraction(double value)
+    {
+      return value - std::floor(value);
+    }
+
+    ReconstructionFilter filter_;
+    double rotation_x_{0.0};
+    double rotation_y_{0.0};
+  };
+}
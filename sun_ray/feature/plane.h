@@ -82,5 +82,11 @@ namespace sunray
       (void)local_point;
       return create_vector(0, 1, 0);
     }
+
+    BoundingBox do_bounds() const override
+    {
+      static constexpr Real inf = std::numeric_limits<Real>::infinity();
+      return BoundingBox{create_point(-inf, 0, -inf), create_point(inf, 0, inf)};
+    }
   };
 }
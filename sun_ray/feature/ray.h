@@ -30,7 +30,7 @@ namespace sunray
     Ray& operator=(const Ray&) = delete;
     Ray& operator=(Ray&&) = delete;
 
-    Point point_at(double t) const
+    Point point_at(Real t) const
     {
       return origin_ + direction_ * t;
     }
@@ -50,7 +50,7 @@ namespace sunray
       return direction_;
     }
 
-    Point position(double t) const
+    Point position(Real t) const
     {
       return origin_ + direction_ * t;
     }
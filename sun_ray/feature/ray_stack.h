@@ -0,0 +1,130 @@
+//
+//  ray_stack.h
+//  sun_ray
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#pragma once
+
+#include <sun_ray/feature/color.h>
+#include <sun_ray/feature/intersection.h>
+#include <sun_ray/feature/tuple.h>
+
+#include <array>
+#include <vector>
+
+
+namespace sunray
+{
+  // Takes the place of the call stack when following reflected and refracted rays. Every surface hit along the current
+  // path of secondary rays has a frame with its direct light and the rays leaving it. A frame is combined with the colors
+  // of its rays once both have been shaded, in the same order of operations as a recursion, so that the colors are the
+  // same to the last bit.
+  //
+  // The frames are allocated for the maximum depth before shading starts and never grow while shading. A stack is meant
+  // to be owned by a single render thread and reused for all of its pixels, so that shading does not allocate memory once
+  // the buffers have grown to their working size.
+  class RayStack
+  {
+  public:
+    // A secondary ray leaving the surface of a frame
+    struct Branch {
+      Point origin_;
+      Vector direction_;
+      // Share of the pixel color, which decides whether the ray is followed
+      float weight_{0};
+      // Factor of the color of the ray in the color of the surface
+      float scale_{0};
+      bool follow_{false};
+      // Black, unless the ray is followed and hits a surface
+      Color color_{0, 0, 0};
+    };
+
+    struct Frame {
+      static constexpr size_t reflected = 0;
+      static constexpr size_t refracted = 1;
+
+      Color surface_{0, 0, 0};
+      // The reflected ray is followed first
+      std::array<Branch, 2> branches_;
+      // Fresnel share of the reflected ray of a surface, which is reflective and transparent at the same time
+      float reflectance_{0};
+      bool fresnel_{false};
+      // Depth of the rays leaving the surface
+      uint8_t depth_{0};
+      // Index of the next ray to follow, the one before is being shaded
+      uint8_t next_{0};
+    };
+
+    RayStack() = default;
+    ~RayStack() = default;
+
+    RayStack(const RayStack&) = delete;
+    RayStack(RayStack&&) = default;
+    RayStack& operator=(const RayStack&) = delete;
+    RayStack& operator=(RayStack&&) = delete;
+
+    // Empties the stack and makes room for the frames of all surfaces down to the given depth
+    void reset(uint8_t depth)
+    {
+      const auto capacity = size_t{depth} + 1;
+      if (frames_.size() < capacity) {
+        frames_.resize(capacity);
+      }
+      size_ = 0;
+    }
+
+    // Returns the new top frame, which is reset except for the surface color and depth, which are up to the caller
+    Frame& push()
+    {
+      auto& frame = frames_.at(size_++);
+      for (auto& branch : frame.branches_) {
+        branch.follow_ = false;
+        branch.color_ = Color{0, 0, 0};
+      }
+      frame.reflectance_ = 0;
+      frame.fresnel_ = false;
+      frame.next_ = 0;
+      return frame;
+    }
+
+    void pop()
+    {
+      --size_;
+    }
+
+    inline Frame& top()
+    {
+      return frames_[size_ - 1];
+    }
+
+    inline bool empty() const
+    {
+      return size_ == 0;
+    }
+
+    inline size_t size() const
+    {
+      return size_;
+    }
+
+    // Number of frames allocated, one per level of depth
+    inline size_t capacity() const
+    {
+      return frames_.size();
+    }
+
+    // Shared by all secondary rays, the intersections are only valid until the next ray is intersected
+    inline Intersections& intersections()
+    {
+      return intersections_;
+    }
+
+  private:
+    std::vector<Frame> frames_;
+    size_t size_{0};
+    Intersections intersections_;
+  };
+}
@@ -0,0 +1,108 @@
+//
+//  render_progress.h
+//  sun_ray
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+
+namespace sunray
+{
+  // Shared between renders and the threads watching them. A render adds its tiles to the total and counts them once they
+  // are done, observers read the counters at any time. Cancelling stops all renders using the progress at the next tile,
+  // they return the canvas rendered so far. Cancelling only sets an atomic flag, so it can be called from a signal
+  // handler.
+  class RenderProgress
+  {
+  public:
+    RenderProgress()
+    {
+      reset();
+    }
+
+    ~RenderProgress() = default;
+
+    RenderProgress(const RenderProgress&) = delete;
+    RenderProgress(RenderProgress&&) = delete;
+    RenderProgress& operator=(const RenderProgress&) = delete;
+    RenderProgress& operator=(RenderProgress&&) = delete;
+
+    // Clears the counters and restarts the clock, but keeps a cancellation
+    void reset()
+    {
+      tiles_total_ = 0;
+      tiles_done_ = 0;
+      samples_ = 0;
+      start_ = Clock::now().time_since_epoch().count();
+    }
+
+    void add_tiles(uint64_t count)
+    {
+      tiles_total_ += count;
+    }
+
+    void tile_done(uint64_t samples)
+    {
+      samples_ += samples;
+      ++tiles_done_;
+    }
+
+    inline uint64_t tiles_total() const
+    {
+      return tiles_total_;
+    }
+
+    inline uint64_t tiles_done() const
+    {
+      return tiles_done_;
+    }
+
+    // Camera rays traced so far
+    inline uint64_t samples() const
+    {
+      return samples_;
+    }
+
+    // Share of the tiles done, between 0 and 1
+    double fraction() const
+    {
+      const uint64_t total = tiles_total_;
+      return total > 0 ? static_cast<double>(tiles_done_) / static_cast<double>(total) : 0.0;
+    }
+
+    double samples_per_second() const
+    {
+      const auto elapsed =
+        std::chrono::duration<double>(Clock::now() - Clock::time_point{Clock::duration{start_.load()}}).count();
+      return elapsed > 0.0 ? static_cast<double>(samples_) / elapsed : 0.0;
+    }
+
+    void cancel()
+    {
+      cancelled_ = true;
+    }
+
+    inline bool cancelled() const
+    {
+      return cancelled_;
+    }
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    std::atomic<uint64_t> tiles_total_{0};
+    std::atomic<uint64_t> tiles_done_{0};
+    std::atomic<uint64_t> samples_{0};
+    std::atomic<Clock::rep> start_{0};
+    std::atomic<bool> cancelled_{false};
+  };
+
+  using RenderProgressPtr = std::shared_ptr<RenderProgress>;
+}
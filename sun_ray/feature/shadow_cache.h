@@ -0,0 +1,96 @@
+//
+//  shadow_cache.h
+//  sun_ray
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#pragma once
+
+#include <sun_ray/feature/light.h>
+
+#include <algorithm>
+#include <vector>
+
+
+namespace sunray
+{
+  class Object;
+
+  // Remembers for every light the object which blocked the last shadow ray towards it. Shadow rays of neighbouring pixels
+  // are mostly blocked by the same object, so testing it first often saves the query against the whole scene. A cache is
+  // not synchronized and meant to be owned by a single render thread.
+  class ShadowCache
+  {
+  public:
+    ShadowCache() = default;
+
+    ~ShadowCache() = default;
+
+    ShadowCache(const ShadowCache&) = delete;
+    ShadowCache(ShadowCache&&) = default;
+    ShadowCache& operator=(const ShadowCache&) = delete;
+    ShadowCache& operator=(ShadowCache&&) = default;
+
+    const Object* occluder(const PointLight& light) const
+    {
+      const auto it = find(light);
+      return it != occluders_.end() ? it->second : nullptr;
+    }
+
+    void occluder(const PointLight& light, const Object* object)
+    {
+      const auto it = find(light);
+      if (it != occluders_.end()) {
+        it->second = object;
+      } else {
+        occluders_.emplace_back(&light, object);
+      }
+    }
+
+    // Forgets the occluders before rendering another world, the counters are kept
+    void clear()
+    {
+      occluders_.clear();
+    }
+
+    // Counts a shadow ray, which has been answered by the cached occluder if hit is true
+    void count(bool hit)
+    {
+      ++lookups_;
+      hits_ += hit ? 1 : 0;
+    }
+
+    inline uint64_t lookups() const
+    {
+      return lookups_;
+    }
+
+    inline uint64_t hits() const
+    {
+      return hits_;
+    }
+
+  private:
+    using Entry = std::pair<const PointLight*, const Object*>;
+
+    std::vector<Entry>::const_iterator find(const PointLight& light) const
+    {
+      return std::find_if(occluders_.begin(), occluders_.end(), [&light](const auto& entry) {
+        return entry.first == &light;
+      });
+    }
+
+    std::vector<Entry>::iterator find(const PointLight& light)
+    {
+      return std::find_if(occluders_.begin(), occluders_.end(), [&light](const auto& entry) {
+        return entry.first == &light;
+      });
+    }
+
+    std::vector<Entry> occluders_;
+    uint64_t lookups_{0};
+    uint64_t hits_{0};
+  };
+}
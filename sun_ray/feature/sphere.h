@@ -86,9 +86,31 @@ namespace sunray
       return true;
     }
 
+    bool do_occluded_by(const Ray& ray, Real max_t) const override
+    {
+      const auto sphere_to_ray = ray.origin() - origin();
+      const auto a = ray.direction().scalarProduct(ray.direction());
+      const auto b = 2 * ray.direction().scalarProduct(sphere_to_ray);
+      const auto c = sphere_to_ray.scalarProduct(sphere_to_ray) - 1;
+      const auto discriminant = pow<2>(b) - 4 * a * c;
+
+      if (discriminant < 0.0) {
+        return false;
+      }
+
+      const auto t1 = (-b - sqrt(discriminant)) / (2 * a);
+      const auto t2 = (-b + sqrt(discriminant)) / (2 * a);
+      return (t1 > 0 && t1 < max_t) || (t2 > 0 && t2 < max_t);
+    }
+
     Vector do_normal_at(const Point& local_point) const override
     {
       return local_point - origin();
     }
+
+    BoundingBox do_bounds() const override
+    {
+      return BoundingBox{create_point(-1, -1, -1), create_point(1, 1, 1)};
+    }
   };
 }
@@ -0,0 +1,360 @@
+//
+//  sphere_set.h
+//  sun_ray
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#pragma once
+
+#include <sun_ray/feature/object.h>
+
+#include <array>
+#include <stdexcept>
+
+
+namespace sunray
+{
+  class SphereSet;
+  using SphereSetPtr = std::shared_ptr<const SphereSet>;
+
+  // A large number of spheres sharing one material and one transformation, e.g. a cloud of particles. Centers and radii
+  // are kept in separate arrays and the spheres are sorted into a uniform grid, whose resolution depends on the number
+  // of spheres and the volume they occupy. A ray walks the grid cell by cell (3D-DDA) and only tests the spheres of the
+  // cells it passes. An intersection records the index of the sphere as face.
+  class SphereSet : public Object
+  {
+  public:
+    SphereSet(std::vector<Point> centers, std::vector<Real> radii)
+    {
+      init(centers, std::move(radii));
+    }
+
+    SphereSet(Material material, std::vector<Point> centers, std::vector<Real> radii)
+    : Object(std::move(material))
+    {
+      init(centers, std::move(radii));
+    }
+
+    SphereSet(Material material, Matrix44 transformation, std::vector<Point> centers, std::vector<Real> radii,
+              bool casts_shadow = true)
+    : Object(std::move(material), std::move(transformation), casts_shadow)
+    {
+      init(centers, std::move(radii));
+    }
+
+    ~SphereSet() override = default;
+
+    SphereSet(const SphereSet&) = delete;
+    SphereSet(SphereSet&&) = delete;
+    SphereSet& operator=(const SphereSet&) = delete;
+    SphereSet& operator=(SphereSet&&) = delete;
+
+    static SphereSetPtr make_sphere_set(std::vector<Point> centers, std::vector<Real> radii)
+    {
+      return std::make_shared<SphereSet>(std::move(centers), std::move(radii));
+    }
+
+    static SphereSetPtr make_sphere_set(Material material, std::vector<Point> centers, std::vector<Real> radii)
+    {
+      return std::make_shared<SphereSet>(std::move(material), std::move(centers), std::move(radii));
+    }
+
+    static SphereSetPtr make_sphere_set(Material material, const Matrix44& transformation, std::vector<Point> centers,
+                                        std::vector<Real> radii, bool casts_shadow = true)
+    {
+      return std::make_shared<SphereSet>(std::move(material), transformation, std::move(centers), std::move(radii),
+                                         casts_shadow);
+    }
+
+    inline uint32_t size() const
+    {
+      return static_cast<uint32_t>(radii_.size());
+    }
+
+    Point center(uint32_t index) const
+    {
+      return create_point(x_.at(index), y_.at(index), z_.at(index));
+    }
+
+    Real radius(uint32_t index) const
+    {
+      return radii_.at(index);
+    }
+
+    inline const std::array<uint32_t, 3>& resolution() const
+    {
+      return resolution_;
+    }
+
+  private:
+    // Number of grid cells per sphere the resolution of the grid aims for
+    static constexpr Real cell_density = 2.0;
+    static constexpr uint32_t maximum_resolution = 128;
+
+    void init(const std::vector<Point>& centers, std::vector<Real> radii)
+    {
+      if (centers.size() != radii.size()) {
+        throw std::invalid_argument{"a sphere set needs exactly one radius per center"};
+      }
+
+      radii_ = std::move(radii);
+      x_.reserve(centers.size());
+      y_.reserve(centers.size());
+      z_.reserve(centers.size());
+      for (size_t n = 0; n < centers.size(); ++n) {
+        if (!(radii_[n] > 0.0)) {
+          throw std::invalid_argument{"the radius of a sphere has to be positive"};
+        }
+        x_.push_back(centers[n].x());
+        y_.push_back(centers[n].y());
+        z_.push_back(centers[n].z());
+        bounds_.add(sphere_bounds(static_cast<uint32_t>(n)));
+      }
+
+      if (radii_.empty()) {
+        return;
+      }
+
+      const auto extent = bounds_.maximum() - bounds_.minimum();
+      const auto volume = extent.x() * extent.y() * extent.z();
+      const auto cells_per_unit = std::cbrt(cell_density * static_cast<Real>(radii_.size()) / volume);
+      for (uint8_t axis = 0; axis < 3; ++axis) {
+        const auto cells = std::clamp(std::round(extent[axis] * cells_per_unit), Real{1}, Real{maximum_resolution});
+        resolution_[axis] = static_cast<uint32_t>(cells);
+        cell_size_[axis] = extent[axis] / cells;
+      }
+
+      // Count the spheres per cell first, so that the cells can be stored as ranges of one flat index array
+      cell_offsets_.assign(static_cast<size_t>(resolution_[0]) * resolution_[1] * resolution_[2] + 1, 0);
+      for_each_cell_of_sphere([this](uint32_t, size_t cell) {
+        ++cell_offsets_[cell + 1];
+      });
+      for (size_t n = 1; n < cell_offsets_.size(); ++n) {
+        cell_offsets_[n] += cell_offsets_[n - 1];
+      }
+      cell_spheres_.resize(cell_offsets_.back());
+      auto insert_positions = cell_offsets_;
+      for_each_cell_of_sphere([this, &insert_positions](uint32_t sphere, size_t cell) {
+        cell_spheres_[insert_positions[cell]++] = sphere;
+      });
+    }
+
+    BoundingBox sphere_bounds(uint32_t index) const
+    {
+      const auto r = radii_[index];
+      return BoundingBox{create_point(x_[index] - r, y_[index] - r, z_[index] - r),
+                         create_point(x_[index] + r, y_[index] + r, z_[index] + r)};
+    }
+
+    uint32_t cell_coordinate(Real value, uint8_t axis) const
+    {
+      const auto cell = std::floor((value - bounds_.minimum()[axis]) / cell_size_[axis]);
+      return static_cast<uint32_t>(std::clamp(cell, Real{0}, static_cast<Real>(resolution_[axis] - 1)));
+    }
+
+    inline size_t cell_index(uint32_t x, uint32_t y, uint32_t z) const
+    {
+      return (static_cast<size_t>(z) * resolution_[1] + y) * resolution_[0] + x;
+    }
+
+    template<typename F>
+    void for_each_cell_of_sphere(F&& f) const
+    {
+      for (uint32_t sphere = 0; sphere < size(); ++sphere) {
+        // The box is enlarged slightly, so that a sphere touching a cell border is found from both sides
+        const auto box = sphere_bounds(sphere);
+        std::array<uint32_t, 3> from;
+        std::array<uint32_t, 3> to;
+        for (uint8_t axis = 0; axis < 3; ++axis) {
+          from[axis] = cell_coordinate(box.minimum()[axis] - epsilon, axis);
+          to[axis] = cell_coordinate(box.maximum()[axis] + epsilon, axis);
+        }
+        for (auto z = from[2]; z <= to[2]; ++z) {
+          for (auto y = from[1]; y <= to[1]; ++y) {
+            for (auto x = from[0]; x <= to[0]; ++x) {
+              f(sphere, cell_index(x, y, z));
+            }
+          }
+        }
+      }
+    }
+
+    // Adds the intersections of the ray with the sphere, which lie between from and to. Every cell of the grid covers a
+    // distinct part of the ray, which avoids reporting a sphere spanning several cells more than once.
+    bool intersect_sphere(const Ray& ray, uint32_t sphere, Real from, Real to, Intersections& intersections) const
+    {
+      const auto sphere_to_ray = ray.origin() - create_point(x_[sphere], y_[sphere], z_[sphere]);
+      const auto a = ray.direction().scalarProduct(ray.direction());
+      const auto b = 2 * ray.direction().scalarProduct(sphere_to_ray);
+      const auto c = sphere_to_ray.scalarProduct(sphere_to_ray) - radii_[sphere] * radii_[sphere];
+      const auto discriminant = b * b - 4 * a * c;
+      if (discriminant < 0) {
+        return false;
+      }
+
+      // Spheres lying completely behind the origin of the ray are of no interest
+      const auto root = std::sqrt(discriminant);
+      const auto t1 = (-b - root) / (2 * a);
+      const auto t2 = (-b + root) / (2 * a);
+      if (t2 < 0) {
+        return false;
+      }
+
+      bool is_intersected{false};
+      for (const auto t : {t1, t2}) {
+        if (t >= from && t < to) {
+          intersections.add(Intersection{t, this, sphere});
+          is_intersected = true;
+        }
+      }
+      return is_intersected;
+    }
+
+    bool occludes_sphere(const Ray& ray, uint32_t sphere, Real max_t) const
+    {
+      const auto sphere_to_ray = ray.origin() - create_point(x_[sphere], y_[sphere], z_[sphere]);
+      const auto a = ray.direction().scalarProduct(ray.direction());
+      const auto b = 2 * ray.direction().scalarProduct(sphere_to_ray);
+      const auto c = sphere_to_ray.scalarProduct(sphere_to_ray) - radii_[sphere] * radii_[sphere];
+      const auto discriminant = b * b - 4 * a * c;
+      if (discriminant < 0) {
+        return false;
+      }
+
+      const auto root = std::sqrt(discriminant);
+      const auto t1 = (-b - root) / (2 * a);
+      const auto t2 = (-b + root) / (2 * a);
+      return (t1 > 0 && t1 < max_t) || (t2 > 0 && t2 < max_t);
+    }
+
+    // Walks the cells pierced by the ray in order (3D-DDA) and calls visitor with the index of every cell and the part of
+    // the ray owned by it, until the visitor returns true.
+    template<typename Visitor>
+    void walk_cells(const Ray& ray, Visitor&& visitor) const
+    {
+      if (radii_.empty()) {
+        return;
+      }
+
+      const auto& origin = ray.origin();
+      const auto& direction = ray.direction();
+      const auto inverse_direction = create_vector(Real{1} / direction.x(), Real{1} / direction.y(), Real{1} / direction.z());
+
+      // Find the part of the ray in front of the origin that lies within the grid
+      Real t_enter{0.0};
+      Real t_exit{std::numeric_limits<Real>::infinity()};
+      for (uint8_t axis = 0; axis < 3; ++axis) {
+        auto t0 = (bounds_.minimum()[axis] - origin[axis]) * inverse_direction[axis];
+        auto t1 = (bounds_.maximum()[axis] - origin[axis]) * inverse_direction[axis];
+        if (t0 > t1) {
+          std::swap(t0, t1);
+        }
+        t_enter = t0 > t_enter ? t0 : t_enter;
+        t_exit = t1 < t_exit ? t1 : t_exit;
+      }
+      if (t_enter > t_exit) {
+        return;
+      }
+
+      const auto start = ray.position(t_enter);
+      std::array<uint32_t, 3> cell;
+      std::array<int32_t, 3> step;
+      std::array<Real, 3> t_next;
+      std::array<Real, 3> t_delta;
+      for (uint8_t axis = 0; axis < 3; ++axis) {
+        cell[axis] = cell_coordinate(start[axis], axis);
+        const auto cell_minimum = bounds_.minimum()[axis] + static_cast<Real>(cell[axis]) * cell_size_[axis];
+        if (direction[axis] > 0) {
+          step[axis] = 1;
+          t_next[axis] = (cell_minimum + cell_size_[axis] - origin[axis]) * inverse_direction[axis];
+          t_delta[axis] = cell_size_[axis] * inverse_direction[axis];
+        } else if (direction[axis] < 0) {
+          step[axis] = -1;
+          t_next[axis] = (cell_minimum - origin[axis]) * inverse_direction[axis];
+          t_delta[axis] = -cell_size_[axis] * inverse_direction[axis];
+        } else {
+          step[axis] = 0;
+          t_next[axis] = std::numeric_limits<Real>::infinity();
+          t_delta[axis] = std::numeric_limits<Real>::infinity();
+        }
+      }
+
+      // The first cell also owns everything before the grid, including the part behind the origin of the ray
+      auto cell_enter = -std::numeric_limits<Real>::infinity();
+      while (true) {
+        uint8_t axis = 0;
+        if (t_next[1] < t_next[axis]) {
+          axis = 1;
+        }
+        if (t_next[2] < t_next[axis]) {
+          axis = 2;
+        }
+        const auto next = static_cast<int64_t>(cell[axis]) + step[axis];
+        const bool is_last = step[axis] == 0 || next < 0 || next >= resolution_[axis];
+        const auto cell_exit = is_last ? std::numeric_limits<Real>::infinity() : t_next[axis];
+
+        if (visitor(cell_index(cell[0], cell[1], cell[2]), cell_enter, cell_exit) || is_last) {
+          return;
+        }
+        cell_enter = cell_exit;
+        cell[axis] = static_cast<uint32_t>(next);
+        t_next[axis] += t_delta[axis];
+      }
+    }
+
+    bool do_intersected_by(const Ray& ray, Intersections& intersections) const override
+    {
+      bool is_intersected{false};
+      walk_cells(ray, [&](size_t index, Real cell_enter, Real cell_exit) {
+        for (auto n = cell_offsets_[index]; n < cell_offsets_[index + 1]; ++n) {
+          is_intersected |= intersect_sphere(ray, cell_spheres_[n], cell_enter, cell_exit, intersections);
+        }
+        return false;
+      });
+      return is_intersected;
+    }
+
+    bool do_occluded_by(const Ray& ray, Real max_t) const override
+    {
+      bool is_occluded{false};
+      walk_cells(ray, [&](size_t index, Real cell_enter, Real) {
+        if (cell_enter >= max_t) {
+          return true;
+        }
+        for (auto n = cell_offsets_[index]; n < cell_offsets_[index + 1] && !is_occluded; ++n) {
+          is_occluded = occludes_sphere(ray, cell_spheres_[n], max_t);
+        }
+        return is_occluded;
+      });
+      return is_occluded;
+    }
+
+    Vector do_normal_at(const Point& local_point) const override
+    {
+      return do_normal_at_face(local_point, 0);
+    }
+
+    Vector do_normal_at_face(const Point& local_point, uint32_t face) const override
+    {
+      const auto normal = (local_point - center(face)) / radii_[face];
+      return create_vector(normal.x(), normal.y(), normal.z());
+    }
+
+    BoundingBox do_bounds() const override
+    {
+      return bounds_;
+    }
+
+    std::vector<Real> x_;
+    std::vector<Real> y_;
+    std::vector<Real> z_;
+    std::vector<Real> radii_;
+    BoundingBox bounds_;
+    std::array<uint32_t, 3> resolution_{0, 0, 0};
+    std::array<Real, 3> cell_size_{0.0, 0.0, 0.0};
+    std::vector<uint32_t> cell_offsets_;
+    std::vector<uint32_t> cell_spheres_;
+  };
+}
@@ -0,0 +1,202 @@
+//
+//  thread_pool.h
+//  sun_ray
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#pragma once
+
+#include <sun_ray/feature/cpu_topology.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+  #include <sched.h>
+#endif
+
+
+namespace sunray
+{
+  // A fixed set of worker threads, which is started once and reused for every render. A job passed to run() is executed
+  // by all workers at the same time, each one called with its own worker index. Callers of run() are served one after the
+  // other, a job must not call run() of the same pool itself.
+  //
+  // With an affinity policy, every worker pins itself to a hardware thread of the placement of the policy, before it runs
+  // its first job. Memory touched first by a worker is then allocated on its NUMA node. With a node, only the hardware
+  // threads of this node are used. Pinning is only supported on Linux, elsewhere the workers are not pinned.
+  class ThreadPool
+  {
+  public:
+    using Job = std::function<void(size_t)>;
+
+    explicit ThreadPool(uint32_t number_of_threads, AffinityPolicy affinity = AffinityPolicy::none,
+                        std::optional<uint32_t> node = std::nullopt)
+    : affinity_{affinity}
+    {
+      const auto size = std::max(number_of_threads, uint32_t{1});
+      if (affinity_ != AffinityPolicy::none) {
+        placement_ = CpuTopology::detect().placement(affinity_, size, node);
+      }
+      pinned_.assign(size, false);
+      threads_.reserve(size);
+      try {
+        for (size_t n = 0; n < size; ++n) {
+          threads_.emplace_back([this, n]() {
+            work(n);
+          });
+        }
+      } catch (...) {
+        // The destructor is not called, the workers started so far have to be joined here
+        stop();
+        throw;
+      }
+    }
+
+    ~ThreadPool()
+    {
+      stop();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    inline size_t size() const
+    {
+      return threads_.size();
+    }
+
+    inline AffinityPolicy affinity() const
+    {
+      return affinity_;
+    }
+
+    // The hardware thread the worker is placed on, nothing without an affinity policy
+    std::optional<Cpu> cpu(size_t worker) const
+    {
+      if (placement_.empty()) {
+        return std::nullopt;
+      }
+      return placement_.at(worker);
+    }
+
+    // Whether the worker has been pinned to its hardware thread, valid once the worker ran a job
+    bool pinned(size_t worker) const
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      return pinned_.at(worker);
+    }
+
+    // Runs the job on every worker and returns once all of them are done. The first exception thrown by the job is
+    // rethrown to the caller.
+    void run(const Job& job)
+    {
+      std::lock_guard<std::mutex> run_lock{run_mutex_};
+      std::unique_lock<std::mutex> lock{mutex_};
+      job_ = &job;
+      error_ = nullptr;
+      running_ = threads_.size();
+      ++generation_;
+      start_.notify_all();
+      done_.wait(lock, [this]() {
+        return running_ == 0;
+      });
+      job_ = nullptr;
+      if (error_) {
+        std::rethrow_exception(error_);
+      }
+    }
+
+  private:
+    void stop()
+    {
+      {
+        std::lock_guard<std::mutex> lock{mutex_};
+        stop_ = true;
+      }
+      start_.notify_all();
+      for (auto& thread : threads_) {
+        if (thread.joinable()) {
+          thread.join();
+        }
+      }
+    }
+
+    void work(size_t worker)
+    {
+      const auto pinned = !placement_.empty() && pin(placement_[worker].id_);
+      uint64_t generation{0};
+      std::unique_lock<std::mutex> lock{mutex_};
+      pinned_[worker] = pinned;
+      while (true) {
+        start_.wait(lock, [this, generation]() {
+          return stop_ || generation_ != generation;
+        });
+        if (stop_) {
+          return;
+        }
+        generation = generation_;
+        const auto* job = job_;
+
+        lock.unlock();
+        std::exception_ptr error;
+        try {
+          (*job)(worker);
+        } catch (...) {
+          error = std::current_exception();
+        }
+        lock.lock();
+
+        if (error && !error_) {
+          error_ = error;
+        }
+        if (--running_ == 0) {
+          done_.notify_all();
+        }
+      }
+    }
+
+    static bool pin(uint32_t cpu)
+    {
+#ifdef __linux__
+      if (cpu >= CPU_SETSIZE) {
+        return false;
+      }
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      CPU_SET(cpu, &set);
+      return ::sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+      (void)cpu;
+      return false;
+#endif
+    }
+
+    AffinityPolicy affinity_;
+    std::vector<Cpu> placement_;
+    std::vector<bool> pinned_;
+    std::vector<std::thread> threads_;
+    std::mutex run_mutex_;
+    mutable std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable done_;
+    const Job* job_{nullptr};
+    std::exception_ptr error_;
+    uint64_t generation_{0};
+    size_t running_{0};
+    bool stop_{false};
+  };
+
+  using ThreadPoolPtr = std::shared_ptr<ThreadPool>;
+}
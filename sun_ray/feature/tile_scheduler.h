@@ -0,0 +1,156 @@
+//
+//  tile_scheduler.h
+//  sun_ray
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+
+namespace sunray
+{
+  // Rectangle of pixels in image coordinates
+  struct Tile {
+    uint32_t x_{0};
+    uint32_t y_{0};
+    uint32_t width_{0};
+    uint32_t height_{0};
+  };
+
+
+  // Splits an image into square tiles and hands them out to a number of workers. The tiles are ordered along a Morton
+  // (Z-order) curve, so that consecutive tiles lie close together in the scene. Every worker starts with its own run of
+  // the curve and, once it is done, takes tiles from the end of the runs of the other workers. Each tile is handed out
+  // exactly once, the tiles at the right and bottom border are cut to the size of the image or region.
+  class TileScheduler
+  {
+  public:
+    static constexpr uint32_t default_tile_size = 16;
+
+    TileScheduler(uint32_t width, uint32_t height, uint32_t tile_size, uint32_t number_of_workers)
+    : TileScheduler{Tile{0, 0, width, height}, tile_size, number_of_workers}
+    {
+    }
+
+    // Only the given region of the image is split into tiles, which start at its top left corner
+    TileScheduler(const Tile& region, uint32_t tile_size, uint32_t number_of_workers)
+    : queues_(std::max(number_of_workers, uint32_t{1}))
+    {
+      if (tile_size == 0) {
+        throw std::invalid_argument{"the tile size has to be positive"};
+      }
+
+      const auto columns = (region.width_ + tile_size - 1) / tile_size;
+      const auto rows = (region.height_ + tile_size - 1) / tile_size;
+      std::vector<std::pair<uint64_t, Tile>> tiles;
+      tiles.reserve(static_cast<size_t>(columns) * rows);
+      for (uint32_t row = 0; row < rows; ++row) {
+        for (uint32_t column = 0; column < columns; ++column) {
+          const auto x = column * tile_size;
+          const auto y = row * tile_size;
+          tiles.emplace_back(morton_code(column, row),
+                             Tile{region.x_ + x, region.y_ + y, std::min(tile_size, region.width_ - x),
+                                  std::min(tile_size, region.height_ - y)});
+        }
+      }
+      std::sort(tiles.begin(), tiles.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first < rhs.first;
+      });
+
+      // Contiguous runs of the curve keep the tiles of one worker close together
+      tile_count_ = tiles.size();
+      const auto per_worker = (tiles.size() + queues_.size() - 1) / queues_.size();
+      for (size_t n = 0; n < tiles.size(); ++n) {
+        queues_[n / per_worker].tiles_.push_back(tiles[n].second);
+      }
+    }
+
+    ~TileScheduler() = default;
+
+    TileScheduler(const TileScheduler&) = delete;
+    TileScheduler(TileScheduler&&) = delete;
+    TileScheduler& operator=(const TileScheduler&) = delete;
+    TileScheduler& operator=(TileScheduler&&) = delete;
+
+    inline size_t number_of_workers() const
+    {
+      return queues_.size();
+    }
+
+    inline size_t tile_count() const
+    {
+      return tile_count_;
+    }
+
+    // Next tile for the given worker, nothing once all tiles have been handed out
+    std::optional<Tile> next(size_t worker)
+    {
+      if (auto tile = queues_.at(worker).pop_front()) {
+        return tile;
+      }
+      for (size_t n = 1; n < queues_.size(); ++n) {
+        if (auto tile = queues_[(worker + n) % queues_.size()].pop_back()) {
+          return tile;
+        }
+      }
+      return std::nullopt;
+    }
+
+    // Interleaves the bits of x and y
+    static uint64_t morton_code(uint32_t x, uint32_t y)
+    {
+      return spread_bits(x) | (spread_bits(y) << 1);
+    }
+
+  private:
+    struct Queue {
+      std::optional<Tile> pop_front()
+      {
+        std::lock_guard<std::mutex> lock{mutex_};
+        if (tiles_.empty()) {
+          return std::nullopt;
+        }
+        const auto tile = tiles_.front();
+        tiles_.pop_front();
+        return tile;
+      }
+
+      std::optional<Tile> pop_back()
+      {
+        std::lock_guard<std::mutex> lock{mutex_};
+        if (tiles_.empty()) {
+          return std::nullopt;
+        }
+        const auto tile = tiles_.back();
+        tiles_.pop_back();
+        return tile;
+      }
+
+      std::mutex mutex_;
+      std::deque<Tile> tiles_;
+    };
+
+    static uint64_t spread_bits(uint32_t value)
+    {
+      uint64_t bits = value;
+      bits = (bits | (bits << 16)) & 0x0000ffff0000ffff;
+      bits = (bits | (bits << 8)) & 0x00ff00ff00ff00ff;
+      bits = (bits | (bits << 4)) & 0x0f0f0f0f0f0f0f0f;
+      bits = (bits | (bits << 2)) & 0x3333333333333333;
+      bits = (bits | (bits << 1)) & 0x5555555555555555;
+      return bits;
+    }
+
+    std::vector<Queue> queues_;
+    size_t tile_count_{0};
+  };
+}
@@ -57,37 +57,37 @@ namespace sunray
       return *this;
     }
 
-    Transformation& translate(double x, double y, double z)
+    Transformation& translate(Real x, Real y, Real z)
     {
       matrices_.emplace(Matrix44::translation(x, y, z));
       return *this;
     }
 
-    Transformation& scale(double x, double y, double z)
+    Transformation& scale(Real x, Real y, Real z)
     {
       matrices_.emplace(Matrix44::scaling(x, y, z));
       return *this;
     }
 
-    Transformation& rotate_x(double radians)
+    Transformation& rotate_x(Real radians)
     {
       matrices_.emplace(Matrix44::rotation_x(radians));
       return *this;
     }
 
-    Transformation& rotate_y(double radians)
+    Transformation& rotate_y(Real radians)
     {
       matrices_.emplace(Matrix44::rotation_y(radians));
       return *this;
     }
 
-    Transformation& rotate_z(double radians)
+    Transformation& rotate_z(Real radians)
     {
       matrices_.emplace(Matrix44::rotation_z(radians));
       return *this;
     }
 
-    Transformation& shear(double xy, double xz, double yx, double yz, double zx, double zy)
+    Transformation& shear(Real xy, Real xz, Real yx, Real yz, Real zx, Real zy)
     {
       matrices_.emplace(Matrix44::shearing(xy, xz, yx, yz, zx, zy));
       return *this;
@@ -153,6 +153,15 @@ namespace sunray
       return normal_;
     }
 
+    BoundingBox do_bounds() const override
+    {
+      BoundingBox box;
+      box.add(p1_);
+      box.add(p2_);
+      box.add(p3_);
+      return box;
+    }
+
     Point p1_;
     Point p2_;
     Point p3_;
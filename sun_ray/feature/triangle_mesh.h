@@ -0,0 +1,204 @@
+//
+//  triangle_mesh.h
+//  sun_ray
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#pragma once
+
+#include <sun_ray/feature/bvh.h>
+#include <sun_ray/feature/object.h>
+
+#include <optional>
+#include <stdexcept>
+
+
+namespace sunray
+{
+  class TriangleMesh;
+  using TriangleMeshPtr = std::shared_ptr<const TriangleMesh>;
+
+  // A mesh of triangles sharing one transformation and one material. The vertices are stored once in a contiguous
+  // buffer and every face references three of them by index. The faces are kept in their own bounding volume hierarchy
+  // and an intersection records the face that has been hit, so that the normal can be looked up later on.
+  class TriangleMesh : public Object
+  {
+  public:
+    TriangleMesh(std::vector<Point> vertices, std::vector<uint32_t> indices)
+    : vertices_{std::move(vertices)}
+    , indices_{std::move(indices)}
+    {
+      init();
+    }
+
+    TriangleMesh(Material material, std::vector<Point> vertices, std::vector<uint32_t> indices)
+    : Object(std::move(material))
+    , vertices_{std::move(vertices)}
+    , indices_{std::move(indices)}
+    {
+      init();
+    }
+
+    TriangleMesh(Material material, Matrix44 transformation, std::vector<Point> vertices, std::vector<uint32_t> indices,
+                 bool casts_shadow = true)
+    : Object(std::move(material), std::move(transformation), casts_shadow)
+    , vertices_{std::move(vertices)}
+    , indices_{std::move(indices)}
+    {
+      init();
+    }
+
+    ~TriangleMesh() override = default;
+
+    TriangleMesh(const TriangleMesh&) = delete;
+    TriangleMesh(TriangleMesh&&) = delete;
+    TriangleMesh& operator=(const TriangleMesh&) = delete;
+    TriangleMesh& operator=(TriangleMesh&&) = delete;
+
+    static TriangleMeshPtr make_triangle_mesh(std::vector<Point> vertices, std::vector<uint32_t> indices)
+    {
+      return std::make_shared<TriangleMesh>(std::move(vertices), std::move(indices));
+    }
+
+    static TriangleMeshPtr make_triangle_mesh(Material material, std::vector<Point> vertices, std::vector<uint32_t> indices)
+    {
+      return std::make_shared<TriangleMesh>(std::move(material), std::move(vertices), std::move(indices));
+    }
+
+    static TriangleMeshPtr make_triangle_mesh(Material material, const Matrix44& transformation, std::vector<Point> vertices,
+                                              std::vector<uint32_t> indices, bool casts_shadow = true)
+    {
+      return std::make_shared<TriangleMesh>(std::move(material), transformation, std::move(vertices), std::move(indices),
+                                            casts_shadow);
+    }
+
+    inline const std::vector<Point>& vertices() const
+    {
+      return vertices_;
+    }
+
+    inline const std::vector<uint32_t>& indices() const
+    {
+      return indices_;
+    }
+
+    inline uint32_t face_count() const
+    {
+      return static_cast<uint32_t>(indices_.size() / 3);
+    }
+
+    Vector face_normal(uint32_t face) const
+    {
+      if (face >= face_count()) {
+        throw std::out_of_range{"face index out of range"};
+      }
+      const auto& p1 = vertex(face, 0);
+      const auto e1 = vertex(face, 1) - p1;
+      const auto e2 = vertex(face, 2) - p1;
+      return e2.crossProduct(e1).normalize();
+    }
+
+  private:
+    void init()
+    {
+      if (indices_.size() % 3 != 0) {
+        throw std::invalid_argument{"the number of triangle mesh indices has to be a multiple of three"};
+      }
+      for (const auto index : indices_) {
+        if (index >= vertices_.size()) {
+          throw std::invalid_argument{"triangle mesh index references a nonexistent vertex"};
+        }
+      }
+
+      std::vector<BoundingBox> bounds;
+      bounds.reserve(face_count());
+      for (uint32_t face = 0; face < face_count(); ++face) {
+        BoundingBox box;
+        box.add(vertex(face, 0));
+        box.add(vertex(face, 1));
+        box.add(vertex(face, 2));
+        bounds_.add(box);
+        bounds.push_back(box);
+      }
+      hierarchy_ = Bvh{bounds};
+    }
+
+    inline const Point& vertex(uint32_t face, uint32_t corner) const
+    {
+      return vertices_[indices_[3 * face + corner]];
+    }
+
+    bool do_intersected_by(const Ray& ray, Intersections& intersections) const override
+    {
+      bool is_intersected{false};
+      hierarchy_.traverse(ray, [&](uint32_t face) {
+        if (const auto t = intersect_face(ray, face)) {
+          intersections.add(Intersection{*t, this, face});
+          is_intersected = true;
+        }
+      });
+      return is_intersected;
+    }
+
+    bool do_occluded_by(const Ray& ray, Real max_t) const override
+    {
+      return hierarchy_.any_of(ray, max_t, [&](uint32_t face) {
+        const auto t = intersect_face(ray, face);
+        return t && *t > 0 && *t < max_t;
+      });
+    }
+
+    // Distance along the ray to the face, if the ray hits it
+    std::optional<Real> intersect_face(const Ray& ray, uint32_t face) const
+    {
+      const auto& p1 = vertex(face, 0);
+      const auto e1 = vertex(face, 1) - p1;
+      const auto e2 = vertex(face, 2) - p1;
+
+      const auto dir_cross_e2 = ray.direction().crossProduct(e2);
+      const auto det = e1.scalarProduct(dir_cross_e2);
+      if (abs(det) < epsilon) {
+        return std::nullopt;
+      }
+
+      const auto f = 1.0 / det;
+
+      const auto p1_to_origin = ray.origin() - p1;
+      const auto u = f * p1_to_origin.scalarProduct(dir_cross_e2);
+      if (u < 0 || u > 1) {
+        return std::nullopt;
+      }
+
+      const auto origin_cross_e1 = p1_to_origin.crossProduct(e1);
+      const auto v = f * ray.direction().scalarProduct(origin_cross_e1);
+      if (v < 0 || (u + v) > 1) {
+        return std::nullopt;
+      }
+
+      return f * e2.scalarProduct(origin_cross_e1);
+    }
+
+    Vector do_normal_at(const Point& local_point) const override
+    {
+      return do_normal_at_face(local_point, 0);
+    }
+
+    Vector do_normal_at_face(const Point& local_point, uint32_t face) const override
+    {
+      (void)local_point;
+      return face_normal(face);
+    }
+
+    BoundingBox do_bounds() const override
+    {
+      return bounds_;
+    }
+
+    std::vector<Point> vertices_;
+    std::vector<uint32_t> indices_;
+    BoundingBox bounds_;
+    Bvh hierarchy_;
+  };
+}
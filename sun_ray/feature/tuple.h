@@ -9,6 +9,7 @@
 #pragma once
 
 #include <sun_ray/feature/math_helper.h>
+#include <sun_ray/feature/tuple_kernel.h>
 
 #include <array>
 #include <cstring>
@@ -17,11 +18,12 @@
 
 namespace sunray
 {
-  class Tuple
+  // The arithmetic is done by the SIMD kernel the compiler targets, see kernel::TupleKernel
+  class alignas(kernel::TupleKernel::alignment) Tuple
   {
   public:
     static constexpr uint8_t elements = 4;
-    using Vec = std::array<double, elements>;
+    using Vec = std::array<Real, elements>;
 
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
     Tuple()
@@ -33,7 +35,7 @@ namespace sunray
     }
 
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
-    Tuple(double x, double y, double z, double w)
+    Tuple(Real x, Real y, Real z, Real w)
     : x_{x}
     , y_{y}
     , z_{z}
@@ -67,22 +69,22 @@ namespace sunray
 
     ~Tuple() = default;
 
-    double x() const
+    Real x() const
     {
       return x_;
     }
 
-    double y() const
+    Real y() const
     {
       return y_;
     }
 
-    double z() const
+    Real z() const
     {
       return z_;
     }
 
-    double w() const
+    Real w() const
     {
       return w_;
     }
@@ -109,45 +111,33 @@ namespace sunray
       return Approx(x_) != rhs.x_ || Approx(y_) != rhs.y_ || Approx(z_) != rhs.z_ || Approx(w_) != rhs.w_;
     }
 
-    operator const double*() const
+    operator const Real*() const
     {
       return v_.data();
     }
 
     friend Tuple operator+(const Tuple& lhs, const Tuple& rhs)
     {
-      Tuple t;
-      t.x_ = lhs.x_ + rhs.x_;
-      t.y_ = lhs.y_ + rhs.y_;
-      t.z_ = lhs.z_ + rhs.z_;
-      t.w_ = lhs.w_ + rhs.w_;
-
+      Tuple t{uninitialized};
+      kernel::TupleKernel::add(lhs.v_.data(), rhs.v_.data(), t.v_.data());
       return t;
     }
 
     friend Tuple operator-(const Tuple& lhs, const Tuple& rhs)
     {
-      Tuple t;
-      t.x_ = lhs.x_ - rhs.x_;
-      t.y_ = lhs.y_ - rhs.y_;
-      t.z_ = lhs.z_ - rhs.z_;
-      t.w_ = lhs.w_ - rhs.w_;
-
+      Tuple t{uninitialized};
+      kernel::TupleKernel::subtract(lhs.v_.data(), rhs.v_.data(), t.v_.data());
       return t;
     }
 
-    friend Tuple operator*(const Tuple& lhs, double scale)
+    friend Tuple operator*(const Tuple& lhs, Real scale)
     {
-      Tuple t;
-      t.x_ = lhs.x_ * scale;
-      t.y_ = lhs.y_ * scale;
-      t.z_ = lhs.z_ * scale;
-      t.w_ = lhs.w_ * scale;
-
+      Tuple t{uninitialized};
+      kernel::TupleKernel::scale(lhs.v_.data(), scale, t.v_.data());
       return t;
     }
 
-    friend Tuple operator/(const Tuple& lhs, double scale)
+    friend Tuple operator/(const Tuple& lhs, Real scale)
     {
       if (Approx(scale) == 0.0) {
         throw std::invalid_argument{"devide by zero"};
@@ -161,9 +151,9 @@ namespace sunray
       return t;
     }
 
-    double magnitude() const
+    Real magnitude() const
     {
-      return sqrt(x_ * x_ + y_ * y_ + z_ * z_ + w_ * w_);
+      return sqrt(kernel::TupleKernel::dot(v_.data(), v_.data()));
     }
 
     Tuple normalize() const
@@ -171,38 +161,33 @@ namespace sunray
       Tuple t{*this};
       const auto mag = magnitude();
       if (mag != Approx(0.0)) {
-        const auto m = (double{1.0} / mag);
-        t.x_ = t.x_ * m;
-        t.y_ = t.y_ * m;
-        t.z_ = t.z_ * m;
-        t.w_ = t.w_ * m;
+        kernel::TupleKernel::scale(v_.data(), Real{1} / mag, t.v_.data());
       }
       return t;
     }
 
-    double scalarProduct(const Tuple& rhs) const
+    Real scalarProduct(const Tuple& rhs) const
     {
-      return x_ * rhs.x_ + y_ * rhs.y_ + z_ * rhs.z_ + w_ * rhs.w_;
+      return kernel::TupleKernel::dot(v_.data(), rhs.v_.data());
     }
 
     Tuple crossProduct(const Tuple& rhs) const
     {
-      Tuple t;
-      t.x_ = (y_ * rhs.z_) - (z_ * rhs.y_);
-      t.y_ = (z_ * rhs.x_) - (x_ * rhs.z_);
-      t.z_ = (x_ * rhs.y_) - (y_ * rhs.x_);
-
+      Tuple t{uninitialized};
+      kernel::TupleKernel::cross(v_.data(), rhs.v_.data(), t.v_.data());
       return t;
     }
 
     Tuple operator-() const
     {
-      return Tuple(-x_, -y_, -z_, -w_);
+      return negate();
     }
 
     Tuple negate() const
     {
-      return Tuple(-x_, -y_, -z_, -w_);
+      Tuple t{uninitialized};
+      kernel::TupleKernel::negate(v_.data(), t.v_.data());
+      return t;
     }
 
     Tuple reflect(const Tuple& normal) const
@@ -217,12 +202,22 @@ namespace sunray
     }
 
   private:
+    struct Uninitialized {
+    };
+    static constexpr Uninitialized uninitialized{};
+
+    // For results written by a kernel
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
+    explicit Tuple(Uninitialized)
+    {
+    }
+
     union {
       struct {
-        double x_;
-        double y_;
-        double z_;
-        double w_;
+        Real x_;
+        Real y_;
+        Real z_;
+        Real w_;
       };
       Vec v_;
     };
@@ -242,12 +237,12 @@ namespace sunray
   using Vector = Tuple;
   using Point = Tuple;
 
-  inline Vector create_vector(double x, double y, double z)
+  inline Vector create_vector(Real x, Real y, Real z)
   {
     return Vector{x, y, z, 0.0};
   }
 
-  inline Point create_point(double x, double y, double z)
+  inline Point create_point(Real x, Real y, Real z)
   {
     return Point{x, y, z, 1.0};
   }
@@ -0,0 +1,249 @@
+//
+//  tuple_kernel.h
+//  sun_ray
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#pragma once
+
+#include <sun_ray/feature/math_helper.h>
+
+#include <cmath>
+#include <cstddef>
+
+#if !defined(SUNRAY_SCALAR_TUPLE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+  #if defined(SUNRAY_FLOAT)
+    #define SUNRAY_TUPLE_SSE
+    #include <emmintrin.h>
+  #elif defined(__AVX2__)
+    #define SUNRAY_TUPLE_AVX2
+    #include <immintrin.h>
+  #else
+    #define SUNRAY_TUPLE_SSE2
+    #include <emmintrin.h>
+  #endif
+#endif
+
+
+namespace sunray
+{
+  namespace kernel
+  {
+    // Arithmetic on the four elements of a tuple. The results are written to r, which may be one of the arguments. The sums
+    // of the products are added pairwise, (x + z) + (y + w), by all kernels, so that they return the same results. Where
+    // the compiler fuses the scalar products and sums into FMA instructions, they differ in the last bits.
+    struct ScalarTuple {
+      static constexpr const char* name = "scalar";
+      static constexpr size_t alignment = alignof(Real);
+
+      static inline void add(const Real* a, const Real* b, Real* r)
+      {
+        r[0] = a[0] + b[0];
+        r[1] = a[1] + b[1];
+        r[2] = a[2] + b[2];
+        r[3] = a[3] + b[3];
+      }
+
+      static inline void subtract(const Real* a, const Real* b, Real* r)
+      {
+        r[0] = a[0] - b[0];
+        r[1] = a[1] - b[1];
+        r[2] = a[2] - b[2];
+        r[3] = a[3] - b[3];
+      }
+
+      static inline void scale(const Real* a, Real s, Real* r)
+      {
+        r[0] = a[0] * s;
+        r[1] = a[1] * s;
+        r[2] = a[2] * s;
+        r[3] = a[3] * s;
+      }
+
+      static inline void negate(const Real* a, Real* r)
+      {
+        r[0] = -a[0];
+        r[1] = -a[1];
+        r[2] = -a[2];
+        r[3] = -a[3];
+      }
+
+      static inline Real dot(const Real* a, const Real* b)
+      {
+        return (a[0] * b[0] + a[2] * b[2]) + (a[1] * b[1] + a[3] * b[3]);
+      }
+
+      // The w of the result is 0
+      static inline void cross(const Real* a, const Real* b, Real* r)
+      {
+        const Real x = a[1] * b[2] - a[2] * b[1];
+        const Real y = a[2] * b[0] - a[0] * b[2];
+        const Real z = a[0] * b[1] - a[1] * b[0];
+        r[0] = x;
+        r[1] = y;
+        r[2] = z;
+        r[3] = 0;
+      }
+    };
+
+#ifdef SUNRAY_TUPLE_SSE
+    // All four floats in one register
+    struct SseTuple {
+      static constexpr const char* name = "sse";
+      static constexpr size_t alignment = 16;
+
+      static inline void add(const float* a, const float* b, float* r)
+      {
+        _mm_storeu_ps(r, _mm_add_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+      }
+
+      static inline void subtract(const float* a, const float* b, float* r)
+      {
+        _mm_storeu_ps(r, _mm_sub_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+      }
+
+      static inline void scale(const float* a, float s, float* r)
+      {
+        _mm_storeu_ps(r, _mm_mul_ps(_mm_loadu_ps(a), _mm_set1_ps(s)));
+      }
+
+      static inline void negate(const float* a, float* r)
+      {
+        _mm_storeu_ps(r, _mm_xor_ps(_mm_loadu_ps(a), _mm_set1_ps(-0.0f)));
+      }
+
+      static inline float dot(const float* a, const float* b)
+      {
+        const auto products = _mm_mul_ps(_mm_loadu_ps(a), _mm_loadu_ps(b));
+        // (x * x + z * z, y * y + w * w)
+        const auto sums = _mm_add_ps(products, _mm_movehl_ps(products, products));
+        return _mm_cvtss_f32(_mm_add_ss(sums, _mm_shuffle_ps(sums, sums, _MM_SHUFFLE(1, 1, 1, 1))));
+      }
+
+      static inline void cross(const float* a, const float* b, float* r)
+      {
+        const auto lhs = _mm_loadu_ps(a);
+        const auto rhs = _mm_loadu_ps(b);
+        // (y, z, x, w) and (z, x, y, w)
+        const auto lhs_yzx = _mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(3, 0, 2, 1));
+        const auto lhs_zxy = _mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(3, 1, 0, 2));
+        const auto rhs_yzx = _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(3, 0, 2, 1));
+        const auto rhs_zxy = _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(3, 1, 0, 2));
+        const auto result = _mm_sub_ps(_mm_mul_ps(lhs_yzx, rhs_zxy), _mm_mul_ps(lhs_zxy, rhs_yzx));
+        // Clears w
+        const auto mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+        _mm_storeu_ps(r, _mm_and_ps(result, mask));
+      }
+    };
+#endif
+
+#ifdef SUNRAY_TUPLE_SSE2
+    // Two doubles per register
+    struct Sse2Tuple {
+      static constexpr const char* name = "sse2";
+      static constexpr size_t alignment = 16;
+
+      static inline void add(const double* a, const double* b, double* r)
+      {
+        _mm_storeu_pd(r, _mm_add_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)));
+        _mm_storeu_pd(r + 2, _mm_add_pd(_mm_loadu_pd(a + 2), _mm_loadu_pd(b + 2)));
+      }
+
+      static inline void subtract(const double* a, const double* b, double* r)
+      {
+        _mm_storeu_pd(r, _mm_sub_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)));
+        _mm_storeu_pd(r + 2, _mm_sub_pd(_mm_loadu_pd(a + 2), _mm_loadu_pd(b + 2)));
+      }
+
+      static inline void scale(const double* a, double s, double* r)
+      {
+        const auto factor = _mm_set1_pd(s);
+        _mm_storeu_pd(r, _mm_mul_pd(_mm_loadu_pd(a), factor));
+        _mm_storeu_pd(r + 2, _mm_mul_pd(_mm_loadu_pd(a + 2), factor));
+      }
+
+      static inline void negate(const double* a, double* r)
+      {
+        const auto sign = _mm_set1_pd(-0.0);
+        _mm_storeu_pd(r, _mm_xor_pd(_mm_loadu_pd(a), sign));
+        _mm_storeu_pd(r + 2, _mm_xor_pd(_mm_loadu_pd(a + 2), sign));
+      }
+
+      static inline double dot(const double* a, const double* b)
+      {
+        // (x * x + z * z, y * y + w * w)
+        const auto sums = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)),
+                                     _mm_mul_pd(_mm_loadu_pd(a + 2), _mm_loadu_pd(b + 2)));
+        return _mm_cvtsd_f64(_mm_add_sd(sums, _mm_unpackhi_pd(sums, sums)));
+      }
+
+      static inline void cross(const double* a, const double* b, double* r)
+      {
+        ScalarTuple::cross(a, b, r);
+      }
+    };
+#endif
+
+#ifdef SUNRAY_TUPLE_AVX2
+    // All four doubles in one register
+    struct Avx2Tuple {
+      static constexpr const char* name = "avx2";
+      static constexpr size_t alignment = 32;
+
+      static inline void add(const double* a, const double* b, double* r)
+      {
+        _mm256_storeu_pd(r, _mm256_add_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b)));
+      }
+
+      static inline void subtract(const double* a, const double* b, double* r)
+      {
+        _mm256_storeu_pd(r, _mm256_sub_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b)));
+      }
+
+      static inline void scale(const double* a, double s, double* r)
+      {
+        _mm256_storeu_pd(r, _mm256_mul_pd(_mm256_loadu_pd(a), _mm256_set1_pd(s)));
+      }
+
+      static inline void negate(const double* a, double* r)
+      {
+        _mm256_storeu_pd(r, _mm256_xor_pd(_mm256_loadu_pd(a), _mm256_set1_pd(-0.0)));
+      }
+
+      static inline double dot(const double* a, const double* b)
+      {
+        const auto products = _mm256_mul_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b));
+        // (x * x + z * z, y * y + w * w)
+        const auto sums = _mm_add_pd(_mm256_castpd256_pd128(products), _mm256_extractf128_pd(products, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(sums, _mm_unpackhi_pd(sums, sums)));
+      }
+
+      static inline void cross(const double* a, const double* b, double* r)
+      {
+        const auto lhs = _mm256_loadu_pd(a);
+        const auto rhs = _mm256_loadu_pd(b);
+        // (y, z, x, w) and (z, x, y, w)
+        const auto lhs_yzx = _mm256_permute4x64_pd(lhs, _MM_SHUFFLE(3, 0, 2, 1));
+        const auto lhs_zxy = _mm256_permute4x64_pd(lhs, _MM_SHUFFLE(3, 1, 0, 2));
+        const auto rhs_yzx = _mm256_permute4x64_pd(rhs, _MM_SHUFFLE(3, 0, 2, 1));
+        const auto rhs_zxy = _mm256_permute4x64_pd(rhs, _MM_SHUFFLE(3, 1, 0, 2));
+        const auto result = _mm256_sub_pd(_mm256_mul_pd(lhs_yzx, rhs_zxy), _mm256_mul_pd(lhs_zxy, rhs_yzx));
+        _mm256_storeu_pd(r, _mm256_blend_pd(result, _mm256_setzero_pd(), 0x8));
+      }
+    };
+#endif
+
+    // The widest kernel the compiler targets for Real, unless SUNRAY_SCALAR_TUPLE is defined
+#if defined(SUNRAY_TUPLE_SSE)
+    using TupleKernel = SseTuple;
+#elif defined(SUNRAY_TUPLE_AVX2)
+    using TupleKernel = Avx2Tuple;
+#elif defined(SUNRAY_TUPLE_SSE2)
+    using TupleKernel = Sse2Tuple;
+#else
+    using TupleKernel = ScalarTuple;
+#endif
+  }
+}
@@ -8,24 +8,59 @@
 
 #pragma once
 
+#include <sun_ray/feature/bvh.h>
 #include <sun_ray/feature/intersection_state.h>
 #include <sun_ray/feature/light.h>
+#include <sun_ray/feature/pixel_sampler.h>
+#include <sun_ray/feature/ray_stack.h>
+#include <sun_ray/feature/shadow_cache.h>
+#include <sun_ray/feature/tile_scheduler.h>
 
+#include <chrono>
+#include <cstring>
 #include <numeric>
+#include <optional>
 #include <thread>
 
 
 namespace sunray
 {
   class Object;
-  using ObjectPtr = std::shared_ptr<const Object>;
 
   struct RenderContext {
     bool shadows_{true};
     bool reflections_{true};
     bool refractions_{true};
     uint8_t maximum_depth_{5};
+    // Reflected and refracted rays, which contribute less than this share to the pixel, are not followed
+    float minimum_weight_{0.001f};
+    // Instead of being cut off, rays below the minimum weight survive by chance after the given number of bounces
+    bool russian_roulette_{false};
+    uint8_t russian_roulette_depth_{2};
     uint32_t number_of_threads_{std::thread::hardware_concurrency()};
+    uint32_t tile_size_{TileScheduler::default_tile_size};
+    uint32_t samples_per_pixel_{1};
+    ReconstructionFilter filter_{ReconstructionFilter::BOX};
+    // Supersamples the pixels, which differ from a neighbour in color or hit object, if there is one sample per pixel
+    bool anti_aliasing_{false};
+    float anti_aliasing_threshold_{0.1f};
+    // Subdivision levels of an anti aliased pixel, 1 results in 4 samples, 2 in up to 16
+    uint8_t anti_aliasing_depth_{2};
+    // Time for a frame, the quality is lowered to fit into it. No limit, if zero
+    std::chrono::milliseconds deadline_{0};
+  };
+
+
+  struct RenderStatistics {
+    uint64_t shadow_rays_{0};
+    uint64_t shadow_cache_hits_{0};
+    uint64_t samples_{0};
+    uint32_t passes_{0};
+
+    double shadow_cache_hit_rate() const
+    {
+      return shadow_rays_ > 0 ? static_cast<double>(shadow_cache_hits_) / static_cast<double>(shadow_rays_) : 0.0;
+    }
   };
 
 
@@ -58,13 +93,59 @@ namespace sunray
 
     void add_object(const ObjectPtr& object)
     {
-      has_non_shadowed_object_ |= object->casts_shadow();
       objects_.emplace_back(object);
+      hierarchy_built_ = false;
+    }
+
+    // Builds the bounding volume hierarchy over all bounded objects. Has to be called once the scene is complete, as
+    // adding further objects falls back to testing every object until the hierarchy is built again.
+    void build_hierarchy()
+    {
+      std::vector<BoundingBox> bounds;
+      bounded_objects_.clear();
+      unbounded_objects_.clear();
+
+      for (const auto& object : objects_) {
+        auto box = object->bounds();
+        if (box.is_bounded()) {
+          bounds.emplace_back(std::move(box));
+          bounded_objects_.emplace_back(object.get());
+        } else {
+          unbounded_objects_.emplace_back(object.get());
+        }
+      }
+
+      hierarchy_ = Bvh{bounds};
+      hierarchy_built_ = true;
+    }
+
+    bool has_hierarchy() const
+    {
+      return hierarchy_built_;
     }
 
     inline Color color_at(const Ray& ray, Intersections& intersections) const
     {
-      return internal_color_at(ray, intersections, context_.maximum_depth_);
+      ShadowCache cache;
+      return color_at(ray, intersections, cache);
+    }
+
+    inline Color color_at(const Ray& ray, Intersections& intersections, ShadowCache& cache) const
+    {
+      RayStack stack;
+      return color_at(ray, intersections, cache, stack);
+    }
+
+    // Afterwards, the intersections are the ones of the given ray, secondary rays use the buffer of the stack
+    inline Color color_at(const Ray& ray, Intersections& intersections, ShadowCache& cache, RayStack& stack) const
+    {
+      intersections.clear();
+      intersect(ray, intersections);
+      const auto hit = intersections.hit();
+      if (hit == nullptr) {
+        return Color{0, 0, 0};
+      }
+      return shade_hit(IntersectionState{*hit, ray, intersections}, context_.maximum_depth_, cache, stack);
     }
 
     bool contains(const ObjectPtr object) const
@@ -77,52 +158,63 @@ namespace sunray
 
     void intersect(const Ray& ray, Intersections& intersections) const
     {
-      std::for_each(objects_.begin(), objects_.end(), [&intersections, &ray](const auto& object) {
+      if (!hierarchy_built_) {
+        std::for_each(objects_.begin(), objects_.end(), [&intersections, &ray](const auto& object) {
+          object->is_intersected_by(ray, intersections);
+        });
+        return;
+      }
+
+      hierarchy_.traverse(ray, [this, &intersections, &ray](uint32_t index) {
+        bounded_objects_[index]->is_intersected_by(ray, intersections);
+      });
+      std::for_each(unbounded_objects_.begin(), unbounded_objects_.end(), [&intersections, &ray](const auto& object) {
         object->is_intersected_by(ray, intersections);
       });
     }
 
     Color shade_hit(const IntersectionState& state, uint8_t depth) const
     {
-      Color surface{0, 0, 0};
-      Color reflected{0, 0, 0};
-      Color refracted{0, 0, 0};
-
-      std::for_each(lights_.begin(), lights_.end(), [this, &surface, &state](const auto& light) {
-        surface = surface + lighting(*state.intersection().object(), *light, state.over_point(), state.eye(), state.normal(),
-                                     is_shadowed(*light, state.over_point()));
-      });
-
-      if (context_.reflections_) {
-        reflected = reflect_color(state, depth);
-      }
-      if (context_.refractions_) {
-        refracted = refracted_color(state, depth);
-      }
+      ShadowCache cache;
+      return shade_hit(state, depth, cache);
+    }
 
-      if (state.intersection().object()->material().reflective() > 0.0 &&
-          state.intersection().object()->material().transparency() > 0.0) {
-        const auto reflectance = state.schlick();
-        return surface + reflected * reflectance + refracted * (1 - reflectance);
-      }
+    Color shade_hit(const IntersectionState& state, uint8_t depth, ShadowCache& cache) const
+    {
+      RayStack stack;
+      return shade_hit(state, depth, cache, stack);
+    }
 
-      return surface + reflected + refracted;
+    // The reflected and refracted rays are not followed recursively, the surfaces they hit are put onto the stack instead
+    Color shade_hit(const IntersectionState& state, uint8_t depth, ShadowCache& cache, RayStack& stack) const
+    {
+      return shade(state, depth, 1.0f, cache, stack);
     }
 
     bool is_shadowed(const PointLight& light, const Point& point) const
+    {
+      ShadowCache cache;
+      return is_shadowed(light, point, cache);
+    }
+
+    // The object which blocked the last shadow ray towards the light is tested first, before querying the whole scene
+    bool is_shadowed(const PointLight& light, const Point& point, ShadowCache& cache) const
     {
       if (context_.shadows_) {
-        auto v = light.position() - point;
-        auto distance = v.magnitude();
-        auto direction = v.normalize();
-        auto ray = Ray{point, direction};
-        Intersections intersections;
-        intersect(ray, intersections);
-        const auto* hit = intersections.hit();
-        if (hit && hit->time() < distance) {
-          if (has_non_shadowed_object_) {
-            return has_shadowed_object(intersections);
-          }
+        const auto v = light.position() - point;
+        const auto distance = v.magnitude();
+        const Ray ray{point, v.normalize()};
+
+        const auto* last_occluder = cache.occluder(light);
+        if (last_occluder && last_occluder->occludes(ray, distance)) {
+          cache.count(true);
+          return true;
+        }
+        cache.count(false);
+
+        const auto* occluder = find_occluder(ray, distance, last_occluder);
+        if (occluder) {
+          cache.occluder(light, occluder);
           return true;
         }
       }
@@ -130,74 +222,243 @@ namespace sunray
       return false;
     }
 
+    // Checks whether a shadow casting object blocks the ray before max_t. The search stops at the first such object.
+    bool occluded(const Ray& ray, Real max_t) const
+    {
+      return find_occluder(ray, max_t) != nullptr;
+    }
+
     Color reflect_color(const IntersectionState& state, uint8_t depth) const
     {
-      if (depth <= 0 || state.intersection().object()->material().reflective() == Approx(0.0)) {
+      ShadowCache cache;
+      return reflect_color(state, depth, cache);
+    }
+
+    Color reflect_color(const IntersectionState& state, uint8_t depth, ShadowCache& cache) const
+    {
+      const auto reflective = material_of(state.intersection()).reflective();
+      if (depth <= 0 || reflective == Approx(0.0)) {
         return Color{0.0f, 0.0f, 0.0f};
       }
 
-      Intersections intersections;
-      auto color = internal_color_at(Ray{state.over_point(), state.reflect()}, intersections, static_cast<uint8_t>(depth - 1));
-
-      return color * state.intersection().object()->material().reflective();
+      RayStack stack;
+      return trace(Ray{state.over_point(), state.reflect()}, static_cast<uint8_t>(depth - 1), reflective, cache, stack) *
+             reflective;
     }
 
     Color refracted_color(const IntersectionState& state, uint8_t depth) const
+    {
+      ShadowCache cache;
+      return refracted_color(state, depth, cache);
+    }
+
+    Color refracted_color(const IntersectionState& state, uint8_t depth, ShadowCache& cache) const
     {
       static Color white{1, 1, 1};
       static Color black{0, 0, 0};
 
-      if (depth == 0 || Approx(0.0) == state.intersection().object()->material().transparency()) {
+      const auto transparency = material_of(state.intersection()).transparency();
+      if (depth == 0 || Approx(0.0) == transparency) {
         return black;
       }
 
-      auto n_ratio = state.n1() / state.n2();
-      auto cos_i = state.eye().scalarProduct(state.normal());
-      auto sin2_t = (n_ratio * n_ratio) * (1 - cos_i * cos_i);
-
-      if (sin2_t > 1.0) {
+      const auto direction = refraction_direction(state);
+      if (!direction) {
         return black;
       }
 
-      auto cos_t = sqrt(1.0 - sin2_t);
-      auto direction = state.normal() * (n_ratio * cos_i - cos_t) - state.eye() * n_ratio;
-
-      Intersections intersections;
-      return internal_color_at(Ray{state.under_point(), direction}, intersections, static_cast<uint8_t>(depth - 1)) *
-             state.intersection().object()->material().transparency();
+      RayStack stack;
+      return trace(Ray{state.under_point(), *direction}, static_cast<uint8_t>(depth - 1), transparency, cache, stack) *
+             transparency;
     }
 
   private:
-    bool has_shadowed_object(const Intersections& intersections) const
+    // Returns the first shadow casting object found, which blocks the ray before max_t. The object given as skip has
+    // already been tested.
+    const Object* find_occluder(const Ray& ray, Real max_t, const Object* skip = nullptr) const
     {
-      auto it =
-        std::find_if(intersections.intersections().begin(), intersections.intersections().end(), [](const auto& intersection) {
-          return intersection.time() > 0;
+      const auto occludes = [&ray, max_t, skip](const Object* object) {
+        return object != skip && object->occludes(ray, max_t);
+      };
+      if (!hierarchy_built_) {
+        const auto it = std::find_if(objects_.begin(), objects_.end(), [&occludes](const auto& object) {
+          return occludes(object.get());
         });
-      while (it != intersections.intersections().end()) {
-        if (it->object()->casts_shadow()) {
-          return true;
+        return it != objects_.end() ? it->get() : nullptr;
+      }
+
+      const Object* occluder{nullptr};
+      hierarchy_.any_of(ray, max_t, [this, &occludes, &occluder](uint32_t index) {
+        if (occludes(bounded_objects_[index])) {
+          occluder = bounded_objects_[index];
         }
-        ++it;
+        return occluder != nullptr;
+      });
+      if (occluder) {
+        return occluder;
       }
-      return false;
+      const auto it = std::find_if(unbounded_objects_.begin(), unbounded_objects_.end(), occludes);
+      return it != unbounded_objects_.end() ? *it : nullptr;
     }
 
-    Color internal_color_at(const Ray& ray, Intersections& intersections, uint8_t depth) const
+    // Color of a secondary ray, which contributes the given weight to the pixel
+    Color trace(const Ray& ray, uint8_t depth, float weight, ShadowCache& cache, RayStack& stack) const
     {
+      auto& intersections = stack.intersections();
       intersections.clear();
       intersect(ray, intersections);
       const auto hit = intersections.hit();
       if (hit == nullptr) {
-        static Color black{0, 0, 0};
-        return black;
+        return Color{0, 0, 0};
+      }
+      return shade(IntersectionState{*hit, ray, intersections}, depth, weight, cache, stack);
+    }
+
+    // Follows the rays leaving the surface depth first, the reflected before the refracted one, as the recursion did.
+    // The color of a surface is complete once both of its rays have returned, it is then scaled into the color of the
+    // surface the ray came from.
+    Color shade(const IntersectionState& state, uint8_t depth, float weight, ShadowCache& cache, RayStack& stack) const
+    {
+      stack.reset(depth);
+      push_surface(state, depth, weight, cache, stack);
+      while (true) {
+        auto& frame = stack.top();
+        if (frame.next_ < frame.branches_.size()) {
+          const auto& branch = frame.branches_[frame.next_++];
+          if (!branch.follow_) {
+            continue;
+          }
+          const Ray ray{branch.origin_, branch.direction_};
+          auto& intersections = stack.intersections();
+          intersections.clear();
+          intersect(ray, intersections);
+          const auto hit = intersections.hit();
+          if (hit != nullptr) {
+            push_surface(IntersectionState{*hit, ray, intersections}, frame.depth_, branch.weight_, cache, stack);
+          }
+          continue;
+        }
+
+        auto color = surface_color(frame);
+        stack.pop();
+        if (stack.empty()) {
+          return color;
+        }
+        auto& parent = stack.top();
+        auto& branch = parent.branches_[parent.next_ - 1];
+        branch.color_ = color * branch.scale_;
+      }
+    }
+
+    // Pushes the frame of a surface with its direct light and the reflected and refracted rays, as long as depth allows
+    void push_surface(const IntersectionState& state, uint8_t depth, float weight, ShadowCache& cache, RayStack& stack) const
+    {
+      auto& frame = stack.push();
+      frame.surface_ = Color{0, 0, 0};
+      std::for_each(lights_.begin(), lights_.end(), [this, &frame, &state, &cache](const auto& light) {
+        frame.surface_ = frame.surface_ + lighting(state.intersection(), *light, state.over_point(), state.eye(),
+                                                   state.normal(), is_shadowed(*light, state.over_point(), cache));
+      });
+
+      const auto& material = material_of(state.intersection());
+      const auto reflective = material.reflective();
+      const auto transparency = material.transparency();
+      auto reflected = reflective;
+      auto refracted = transparency;
+      if (reflective > 0.0f && transparency > 0.0f) {
+        frame.fresnel_ = true;
+        frame.reflectance_ = state.schlick();
+        reflected *= frame.reflectance_;
+        refracted *= 1 - frame.reflectance_;
+      }
+      if (depth == 0) {
+        return;
+      }
+
+      frame.depth_ = static_cast<uint8_t>(depth - 1);
+      if (context_.reflections_ && Approx(0.0) != reflective) {
+        follow(frame.branches_[RayStack::Frame::reflected], state.over_point(), state.reflect(), weight * reflected,
+               reflective, frame.depth_);
+      }
+      if (context_.refractions_ && Approx(0.0) != transparency) {
+        if (const auto direction = refraction_direction(state)) {
+          follow(frame.branches_[RayStack::Frame::refracted], state.under_point(), *direction, weight * refracted,
+                 transparency, frame.depth_);
+        }
+      }
+    }
+
+    // The surface color plus the colors of its rays, a surface which is reflective and transparent at the same time
+    // weighs them by the Fresnel term
+    static Color surface_color(const RayStack::Frame& frame)
+    {
+      const auto& reflected = frame.branches_[RayStack::Frame::reflected].color_;
+      const auto& refracted = frame.branches_[RayStack::Frame::refracted].color_;
+      if (frame.fresnel_) {
+        return frame.surface_ + reflected * frame.reflectance_ + refracted * (1 - frame.reflectance_);
       }
-      return shade_hit(IntersectionState{*hit, ray, intersections}, depth);
+      return frame.surface_ + reflected + refracted;
+    }
+
+    // Follows a secondary ray, unless its weight is below the minimum weight. With Russian roulette, such a ray is only
+    // dropped after the first bounces. Beyond them, it survives with a probability of its weight divided by the minimum
+    // weight and then counts with the minimum weight, so that the expected color stays the same.
+    void follow(RayStack::Branch& branch, const Point& origin, const Vector& direction, float weight, float scale,
+                uint8_t depth) const
+    {
+      const auto minimum = context_.minimum_weight_;
+      if (weight < minimum) {
+        if (!context_.russian_roulette_) {
+          return;
+        }
+        const auto bounce = static_cast<int>(context_.maximum_depth_) - static_cast<int>(depth);
+        if (bounce > static_cast<int>(context_.russian_roulette_depth_)) {
+          if (random_number(origin, direction) * minimum >= weight) {
+            return;
+          }
+          scale *= minimum / weight;
+          weight = minimum;
+        }
+      }
+      branch.origin_ = origin;
+      branch.direction_ = direction;
+      branch.weight_ = weight;
+      branch.scale_ = scale;
+      branch.follow_ = true;
+    }
+
+    // Random number in [0, 1) derived from the ray only, so that images do not depend on the thread rendering a pixel
+    static double random_number(const Point& origin, const Vector& direction)
+    {
+      uint64_t seed{0};
+      for (const auto value : {origin.x(), origin.y(), origin.z(), direction.x(), direction.y(), direction.z()}) {
+        uint64_t bits{0};
+        std::memcpy(&bits, &value, sizeof(value));
+        seed = PixelSampler::hash(seed ^ bits);
+      }
+      return PixelSampler::to_unit(seed);
+    }
+
+    // Direction of the refracted ray, nothing in case of total internal reflection
+    static std::optional<Vector> refraction_direction(const IntersectionState& state)
+    {
+      const auto n_ratio = state.n1() / state.n2();
+      const auto cos_i = state.eye().scalarProduct(state.normal());
+      const auto sin2_t = (n_ratio * n_ratio) * (1 - cos_i * cos_i);
+      if (sin2_t > 1.0) {
+        return std::nullopt;
+      }
+
+      const auto cos_t = sqrt(1 - sin2_t);
+      return state.normal() * (n_ratio * cos_i - cos_t) - state.eye() * n_ratio;
     }
 
     std::vector<LightPtr> lights_;
     std::vector<ObjectPtr> objects_;
+    std::vector<const Object*> bounded_objects_;
+    std::vector<const Object*> unbounded_objects_;
+    Bvh hierarchy_;
+    bool hierarchy_built_{false};
     RenderContext context_;
-    bool has_non_shadowed_object_{false};
   };
 }
@@ -8,4 +8,5 @@
 
 #pragma once
 
+#include <stb_image.h>
 #include <stb_image_write.h>
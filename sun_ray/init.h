@@ -8,6 +8,10 @@
 
 #pragma once
 
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+#undef STB_IMAGE_IMPLEMENTATION
+
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include <stb_image_write.h>
 #undef STB_IMAGE_WRITE_IMPLEMENTATION
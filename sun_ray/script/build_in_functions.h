@@ -102,6 +102,12 @@ namespace sunray
       BuildInFunctions& operator=(const BuildInFunctions&) = delete;
       BuildInFunctions& operator=(BuildInFunctions&&) = delete;
 
+      // Random number in [-1, 1) from the generator behind random(), so that it follows the seed set by the script
+      static double random_number()
+      {
+        return random();
+      }
+
     private:
       static double seed(double seed)
       {
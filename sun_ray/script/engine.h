@@ -45,6 +45,8 @@
 #include <sun_ray/script/objects/cylinder.h>
 #include <sun_ray/script/objects/disk.h>
 #include <sun_ray/script/objects/gradient_pattern.h>
+#include <sun_ray/script/objects/group.h>
+#include <sun_ray/script/objects/instance.h>
 #include <sun_ray/script/objects/light.h>
 #include <sun_ray/script/objects/material.h>
 #include <sun_ray/script/objects/measurement.h>
@@ -52,6 +54,7 @@
 #include <sun_ray/script/objects/point.h>
 #include <sun_ray/script/objects/ring_pattern.h>
 #include <sun_ray/script/objects/sphere.h>
+#include <sun_ray/script/objects/sphere_set.h>
 #include <sun_ray/script/objects/stripe_pattern.h>
 #include <sun_ray/script/objects/triangle.h>
 #include <sun_ray/script/objects/vector.h>
@@ -69,14 +72,35 @@ namespace sunray
     class Engine
     {
     public:
-      Engine(std::ostream& output, std::ostream& diagnostic_output, bool dump_script, bool dump_instructions)
+      // All renders of the engine share one pool of number_of_threads workers, 0 uses one worker per hardware thread. With a
+      // region, cameras render only this part of their images. With worker processes, the images are rendered by them and
+      // the engine starts neither a pool nor a frame queue. In a worker process, the engine runs the scripts to build the
+      // same scenes as the coordinating process and writes no canvases, see DistributedRenderer. With more than one frame
+      // in flight, renders are started in the background and
+      // the canvases are written in order, while the script continues with the next frame. A deadline is the default time
+      // for every frame of a world, see World.deadline. All renders report to the progress, cancelling it stops them and
+      // the scripts continue with the canvases rendered so far. The affinity policy pins the workers of the pool to
+      // hardware threads.
+      Engine(std::ostream& output, std::ostream& diagnostic_output, bool dump_script, bool dump_instructions,
+             uint32_t number_of_threads = 0, std::optional<Tile> region = std::nullopt,
+             DistributedRendererPtr processes = nullptr, uint32_t frames_in_flight = 1,
+             std::chrono::milliseconds deadline = std::chrono::milliseconds{0}, RenderProgressPtr progress = nullptr,
+             AffinityPolicy affinity = AffinityPolicy::none)
       : output_{output}
       , diagnostic_output_{diagnostic_output}
       , dump_script_{dump_script}
       , dump_instructions_{dump_instructions}
+      , thread_pool_{!processes ? std::make_shared<ThreadPool>(
+                                    number_of_threads != 0 ? number_of_threads : std::thread::hardware_concurrency(), affinity)
+                                : nullptr}
+      , frame_queue_{thread_pool_ && frames_in_flight > 1
+                       ? std::make_shared<FrameQueue>(thread_pool_, frames_in_flight, progress)
+                       : nullptr}
       {
-        meta_class_registry_.add_meta_class(std::make_shared<CameraMetaClass>());
-        meta_class_registry_.add_meta_class(std::make_shared<CanvasMetaClass>());
+        const auto write_files = !processes || !processes->worker();
+        meta_class_registry_.add_meta_class(
+          std::make_shared<CameraMetaClass>(thread_pool_, region, std::move(processes), frame_queue_, std::move(progress)));
+        meta_class_registry_.add_meta_class(std::make_shared<CanvasMetaClass>(write_files));
         meta_class_registry_.add_meta_class(std::make_shared<CheckerPatternMetaClass>());
         meta_class_registry_.add_meta_class(std::make_shared<ColorMetaClass>());
         meta_class_registry_.add_meta_class(std::make_shared<ConeMetaClass>());
@@ -84,6 +108,8 @@ namespace sunray
         meta_class_registry_.add_meta_class(std::make_shared<CylinderMetaClass>());
         meta_class_registry_.add_meta_class(std::make_shared<DiskMetaClass>());
         meta_class_registry_.add_meta_class(std::make_shared<GradientPatternMetaClass>());
+        meta_class_registry_.add_meta_class(std::make_shared<GroupMetaClass>());
+        meta_class_registry_.add_meta_class(std::make_shared<InstanceMetaClass>());
         meta_class_registry_.add_meta_class(std::make_shared<LightMetaClass>());
         meta_class_registry_.add_meta_class(std::make_shared<MaterialMetaClass>());
         meta_class_registry_.add_meta_class(std::make_shared<MeasurementMetaClass>());
@@ -91,10 +117,11 @@ namespace sunray
         meta_class_registry_.add_meta_class(std::make_shared<PointMetaClass>());
         meta_class_registry_.add_meta_class(std::make_shared<RingPatternMetaClass>());
         meta_class_registry_.add_meta_class(std::make_shared<SphereMetaClass>());
+        meta_class_registry_.add_meta_class(std::make_shared<SphereSetMetaClass>());
         meta_class_registry_.add_meta_class(std::make_shared<StripePatternMetaClass>());
         meta_class_registry_.add_meta_class(std::make_shared<TriangleMetaClass>());
         meta_class_registry_.add_meta_class(std::make_shared<VectorMetaClass>());
-        meta_class_registry_.add_meta_class(std::make_shared<WorldMetaClass>());
+        meta_class_registry_.add_meta_class(std::make_shared<WorldMetaClass>(deadline));
       }
 
       bool process(std::istream& input_stream)
@@ -133,16 +160,27 @@ namespace sunray
 
             sm.run();
           }
+          if (frame_queue_) {
+            frame_queue_->wait();
+          }
         }
 
         return true;
       }
 
+      // None with worker processes
+      inline const ThreadPool* thread_pool() const
+      {
+        return thread_pool_.get();
+      }
+
     private:
       std::ostream& output_;
       std::ostream& diagnostic_output_;
       bool dump_script_{false};
       bool dump_instructions_{false};
+      ThreadPoolPtr thread_pool_;
+      FrameQueuePtr frame_queue_;
       FunctionRegistry function_registry_;
       BuildInFunctions buildin_functions_{function_registry_, output_};
       MetaClassRegistry meta_class_registry_{function_registry_};
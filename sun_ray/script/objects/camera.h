@@ -9,6 +9,10 @@
 #pragma once
 
 #include <sun_ray/feature/camera.h>
+#include <sun_ray/feature/deadline_renderer.h>
+#include <sun_ray/feature/distributed_renderer.h>
+#include <sun_ray/feature/frame_queue.h>
+#include <sun_ray/feature/render_progress.h>
 #include <sun_ray/script/class.h>
 #include <sun_ray/script/meta_class.h>
 #include <sun_ray/script/objects/canvas.h>
@@ -16,6 +20,9 @@
 #include <sun_ray/script/objects/vector.h>
 #include <sun_ray/script/objects/world.h>
 
+#include <optional>
+#include <utility>
+
 
 namespace sunray
 {
@@ -26,8 +33,14 @@ namespace sunray
     , public std::enable_shared_from_this<Camera>
     {
     public:
-      Camera(MetaClassPtr meta_class)
+      Camera(MetaClassPtr meta_class, ThreadPoolPtr thread_pool = nullptr, std::optional<Tile> region = std::nullopt,
+             DistributedRendererPtr processes = nullptr, FrameQueuePtr frames = nullptr, RenderProgressPtr progress = nullptr)
       : Class(meta_class)
+      , thread_pool_{std::move(thread_pool)}
+      , region_{region}
+      , processes_{std::move(processes)}
+      , frames_{std::move(frames)}
+      , progress_{std::move(progress)}
       {
       }
 
@@ -84,20 +97,130 @@ namespace sunray
                            ss_from.str(), ss_to.str(), ss_up.str());
       }
 
+      // With a region, only its pixels are rendered. Writing the canvas patches them into an existing image. With worker
+      // processes, they render the tiles of the image. A cancelled render returns the canvas rendered so far.
       MutableClassPtr render(const sunray::World& world) const
       {
         sunray::Camera camera{horizontal_, vertical_, field_of_view_, sunray::view_transformation(from_, to_, up_)};
-        sunray::Canvas canvas = camera.render(world);
-        return std::make_shared<Canvas>(std::make_shared<CanvasMetaClass>(), std::move(canvas));
+        if (!region_ && !processes_) {
+          sunray::RenderStatistics statistics;
+          sunray::Canvas canvas =
+            thread_pool_ ? camera.render(world, statistics, *thread_pool_, progress_.get()) : camera.render(world);
+          return std::make_shared<Canvas>(canvas_meta_class(), std::move(canvas));
+        }
+
+        const auto region = region_ ? *region_ : Tile{0, 0, horizontal_, vertical_};
+        sunray::RenderStatistics statistics;
+        sunray::Canvas canvas = [&]() {
+          if (processes_) {
+            return processes_->render(camera, world, region, statistics, progress_.get());
+          }
+          std::unique_ptr<ThreadPool> local_pool;
+          return camera.render(world, region, statistics, pool(world, local_pool), progress_.get());
+        }();
+        if (!region_) {
+          return std::make_shared<Canvas>(canvas_meta_class(), std::move(canvas));
+        }
+        return std::make_shared<Canvas>(canvas_meta_class(), std::move(canvas), region, horizontal_,
+                                        vertical_);
+      }
+
+      // With a deadline of the world, the quality is lowered until the frame is expected to be done in time. The canvas
+      // tells the quality it has been rendered with. A deadline is not applied to regions and renders in several processes.
+      //
+      // With a frame queue, the render is only started and the canvas is returned right away, unless the images are
+      // rendered with a deadline or by worker processes. The world must not change until the frame is done, changing it
+      // waits for the frame.
+      MutableClassPtr render(const std::shared_ptr<World>& world) const
+      {
+        const auto deadline = !region_ && !processes_ && world->world().context().deadline_.count() > 0;
+        if (deadline) {
+          sunray::Camera camera{horizontal_, vertical_, field_of_view_, sunray::view_transformation(from_, to_, up_)};
+          std::unique_ptr<ThreadPool> local_pool;
+          sunray::RenderStatistics statistics;
+          sunray::DeadlineRenderer renderer;
+          auto& render_pool = pool(world->world(), local_pool);
+          auto canvas =
+            std::make_shared<Canvas>(canvas_meta_class(),
+                                     renderer.render(camera, world->world(), render_pool, statistics, progress_.get()));
+          canvas->quality(renderer.quality().to_string());
+          return canvas;
+        }
+        if (!frames_ || processes_) {
+          return render(std::as_const(*world).world());
+        }
+
+        auto camera = std::make_shared<const sunray::Camera>(horizontal_, vertical_, field_of_view_,
+                                                             sunray::view_transformation(from_, to_, up_));
+        const auto region = region_ ? *region_ : Tile{0, 0, horizontal_, vertical_};
+        auto frame = frames_->add(std::move(camera), std::shared_ptr<const sunray::World>{world, &world->world()}, region);
+        world->in_flight([frames = frames_, weak_frame = std::weak_ptr<FrameQueue::Frame>{frame}]() {
+          // The queue keeps the frame until it is delivered
+          if (const auto in_flight = weak_frame.lock()) {
+            frames->canvas(in_flight);
+          }
+        });
+        return std::make_shared<Canvas>(canvas_meta_class(), frames_, std::move(frame), region_, horizontal_,
+                                        vertical_);
+      }
+
+      MutableClassPtr render_progressive(const sunray::World& world, const std::string& filename, double seconds,
+                                         double interval) const
+      {
+        if (seconds < 0.0 || interval < 0.0) {
+          throw std::runtime_error{
+            fmt::format("Camera render_progressive called with negative time {} or interval {}.", seconds, interval)};
+        }
+        if (processes_ && processes_->worker()) {
+          // The coordinating process renders progressively by itself, a worker process only keeps up with its script
+          return std::make_shared<Canvas>(canvas_meta_class(), sunray::Canvas{horizontal_, vertical_});
+        }
+        sunray::Camera camera{horizontal_, vertical_, field_of_view_, sunray::view_transformation(from_, to_, up_)};
+        sunray::ProgressiveSettings settings;
+        settings.time_budget_ = std::chrono::milliseconds{static_cast<int64_t>(seconds * 1000.0)};
+        settings.snapshot_interval_ = std::chrono::milliseconds{static_cast<int64_t>(interval * 1000.0)};
+
+        const sunray::CanvasFileWriter writer{sunray::ImageFormat::PNG, filename};
+        std::unique_ptr<ThreadPool> local_pool;
+        sunray::RenderStatistics statistics;
+        sunray::Canvas canvas = camera.render_progressive(
+          world, settings, pool(world, local_pool), statistics,
+          [&writer](const sunray::Canvas& snapshot, uint32_t) {
+            writer.write(snapshot);
+          },
+          progress_.get());
+        writer.write(canvas);
+        return std::make_shared<Canvas>(canvas_meta_class(), std::move(canvas));
       }
 
     private:
+      // The canvases of a worker process are not written
+      std::shared_ptr<CanvasMetaClass> canvas_meta_class() const
+      {
+        return std::make_shared<CanvasMetaClass>(!processes_ || !processes_->worker());
+      }
+
+      // The shared pool, or else a pool started for a single render
+      ThreadPool& pool(const sunray::World& world, std::unique_ptr<ThreadPool>& local_pool) const
+      {
+        if (thread_pool_) {
+          return *thread_pool_;
+        }
+        local_pool = std::make_unique<ThreadPool>(world.context().number_of_threads_);
+        return *local_pool;
+      }
+
       uint32_t horizontal_{500};
       uint32_t vertical_{250};
       double field_of_view_{sunray::PI / 3};
-      sunray::Point from_{sunray::create_point(0, 1.5, 0.7)};
+      sunray::Point from_{sunray::create_point(0, 1.5, static_cast<sunray::Real>(0.7))};
       sunray::Point to_{sunray::create_point(0, 1, 0)};
       sunray::Vector up_{sunray::create_vector(0, 1, 0)};
+      ThreadPoolPtr thread_pool_;
+      std::optional<Tile> region_;
+      DistributedRendererPtr processes_;
+      FrameQueuePtr frames_;
+      RenderProgressPtr progress_;
     };
 
 
@@ -106,6 +229,21 @@ namespace sunray
     public:
       CameraMetaClass() = default;
 
+      // All cameras constructed by this meta class render with the given pool instead of starting threads of their own. If
+      // a region is given, they render only this part of their image. With worker processes, the tiles are rendered by
+      // them. With a frame queue, several renders are kept in flight on its pool. Renders report their tiles to the
+      // progress and stop, once it is cancelled.
+      explicit CameraMetaClass(ThreadPoolPtr thread_pool, std::optional<Tile> region = std::nullopt,
+                               DistributedRendererPtr processes = nullptr, FrameQueuePtr frames = nullptr,
+                               RenderProgressPtr progress = nullptr)
+      : thread_pool_{std::move(thread_pool)}
+      , region_{region}
+      , processes_{std::move(processes)}
+      , frames_{std::move(frames)}
+      , progress_{std::move(progress)}
+      {
+      }
+
       const std::string& name() const override
       {
         static const std::string name = "Camera";
@@ -123,6 +261,7 @@ namespace sunray
           return self->construct();
         });
         registry.add_function("Camera_render", render);
+        registry.add_function("Camera_render_progressive", render_progressive);
         registry.add_function("Camera_set_from", from);
         registry.add_function("Camera_set_to", to);
         registry.add_function("Camera_set_up", up);
@@ -134,14 +273,20 @@ namespace sunray
 
       std::shared_ptr<Camera> construct() const
       {
-        return std::make_shared<Camera>(shared_from_this());
+        return std::make_shared<Camera>(shared_from_this(), thread_pool_, region_, processes_, frames_, progress_);
       }
 
     private:
       static MutableClassPtr render(MutableClassPtr& c, const MutableClassPtr& world)
+      {
+        cast_object<World, WorldMetaClass>(world, "world");
+        return get_class(c)->render(std::dynamic_pointer_cast<World>(world));
+      }
+      static MutableClassPtr render_progressive(MutableClassPtr& c, const MutableClassPtr& world, const std::string& filename,
+                                                double seconds, double interval)
       {
         const auto& w = cast_object<World, WorldMetaClass>(world, "world");
-        return get_class(c)->render(w.world());
+        return get_class(c)->render_progressive(w.world(), filename, seconds, interval);
       }
       static MutableClassPtr from(MutableClassPtr& c, const MutableClassPtr& point)
       {
@@ -174,6 +319,12 @@ namespace sunray
       {
         return get_class(c)->vertical(v);
       }
+
+      ThreadPoolPtr thread_pool_;
+      std::optional<Tile> region_;
+      DistributedRendererPtr processes_;
+      FrameQueuePtr frames_;
+      RenderProgressPtr progress_;
     };
   }
 }
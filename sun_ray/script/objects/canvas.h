@@ -8,12 +8,18 @@
 
 #pragma once
 
+#include <sun_ray/canvas_file_reader.h>
 #include <sun_ray/canvas_file_writer.h>
 #include <sun_ray/feature/canvas.h>
+#include <sun_ray/feature/frame_queue.h>
+#include <sun_ray/feature/tile_scheduler.h>
 #include <sun_ray/script/class.h>
 #include <sun_ray/script/meta_class.h>
 #include <sun_ray/script/objects/color.h>
 
+#include <filesystem>
+#include <optional>
+
 
 namespace sunray
 {
@@ -24,37 +30,78 @@ namespace sunray
     public:
       Canvas(MetaClassPtr meta_class, double width, double height)
       : Class(meta_class)
-      , canvas_{static_cast<uint32_t>(width), static_cast<uint32_t>(height)}
+      , canvas_{std::make_shared<sunray::Canvas>(static_cast<uint32_t>(width), static_cast<uint32_t>(height))}
       {
       }
 
       Canvas(MetaClassPtr meta_class, sunray::Canvas&& canvas)
       : Class(meta_class)
-      , canvas_{std::move(canvas)}
+      , canvas_{std::make_shared<sunray::Canvas>(std::move(canvas))}
+      {
+      }
+
+      // A canvas holding the given region of an image of image_width x image_height pixels
+      Canvas(MetaClassPtr meta_class, sunray::Canvas&& canvas, const Tile& region, uint32_t image_width, uint32_t image_height)
+      : Class(meta_class)
+      , canvas_{std::make_shared<sunray::Canvas>(std::move(canvas))}
+      , region_{region}
+      , image_width_{image_width}
+      , image_height_{image_height}
+      {
+      }
+
+      // A canvas of a frame, which is still rendered by the queue. Reading or changing its pixels waits for the frame,
+      // writing it is queued behind the writes of the frames before.
+      Canvas(MetaClassPtr meta_class, FrameQueuePtr frames, FrameQueue::FramePtr frame, std::optional<Tile> region,
+             uint32_t image_width, uint32_t image_height)
+      : Class(meta_class)
+      , frames_{std::move(frames)}
+      , frame_{std::move(frame)}
+      , region_{region}
+      , image_width_{image_width}
+      , image_height_{image_height}
       {
       }
 
       double width() const
       {
-        return canvas_.width();
+        return frame_ ? frame_->region_.width_ : canvas_->width();
       }
 
       double height() const
       {
-        return canvas_.height();
+        return frame_ ? frame_->region_.height_ : canvas_->height();
       }
 
       void set_pixel(double x, double y, const Color& color)
       {
-        canvas_.pixel_at(
+        canvas().pixel_at(
           static_cast<uint32_t>(x), static_cast<uint32_t>(y),
           sunray::Color{static_cast<float>(color.red()), static_cast<float>(color.green()), static_cast<float>(color.blue())});
       }
 
+      // The canvas of a region is patched into the image file, if it already exists, otherwise it is written as is
       void write(const std::string& filename)
       {
-        sunray::CanvasFileWriter writer{sunray::ImageFormat::PNG, filename};
-        writer.write(canvas_);
+        if (!frame_) {
+          write(*canvas_, filename, region_, image_width_, image_height_);
+          return;
+        }
+        frames_->then(frame_, [filename, region = region_, width = image_width_, height = image_height_](
+                                const sunray::Canvas& canvas) {
+          write(canvas, filename, region, width, height);
+        });
+      }
+
+      // Settings the canvas has been rendered with, if they have been lowered to meet a deadline
+      const std::string& quality() const
+      {
+        return quality_;
+      }
+
+      void quality(std::string quality)
+      {
+        quality_ = std::move(quality);
       }
 
       std::string to_string() const override
@@ -63,7 +110,41 @@ namespace sunray
       }
 
     private:
-      sunray::Canvas canvas_;
+      sunray::Canvas& canvas()
+      {
+        if (frame_) {
+          canvas_ = std::shared_ptr<sunray::Canvas>{frame_, &frames_->canvas(frame_)};
+          frame_ = nullptr;
+        }
+        return *canvas_;
+      }
+
+      static void write(const sunray::Canvas& canvas, const std::string& filename, const std::optional<Tile>& region,
+                        uint32_t image_width, uint32_t image_height)
+      {
+        sunray::CanvasFileWriter writer{sunray::ImageFormat::PNG, filename};
+        if (!region || !std::filesystem::exists(writer.path())) {
+          writer.write(canvas);
+          return;
+        }
+
+        auto image = sunray::CanvasFileReader{writer.path()}.read();
+        if (image.width() != image_width || image.height() != image_height) {
+          throw std::runtime_error{fmt::format("Canvas region cannot be written into '{}', its size is {}x{} instead of {}x{}.",
+                                               writer.path().string(), image.width(), image.height(), image_width,
+                                               image_height)};
+        }
+        image.paste(canvas, region->x_, region->y_);
+        writer.write(image);
+      }
+
+      std::shared_ptr<sunray::Canvas> canvas_;
+      FrameQueuePtr frames_;
+      FrameQueue::FramePtr frame_;
+      std::optional<Tile> region_;
+      uint32_t image_width_{0};
+      uint32_t image_height_{0};
+      std::string quality_;
     };
 
 
@@ -72,6 +153,13 @@ namespace sunray
     public:
       CanvasMetaClass() = default;
 
+      // The canvases of a meta class without writing files are not written, like the ones of a worker process rendering
+      // for another process
+      explicit CanvasMetaClass(bool write_files)
+      : write_files_{write_files}
+      {
+      }
+
       const std::string& name() const override
       {
         static const std::string name = "Canvas";
@@ -90,6 +178,7 @@ namespace sunray
         });
         registry.add_function("Canvas_get_width", get_width);
         registry.add_function("Canvas_get_height", get_height);
+        registry.add_function("Canvas_get_quality", get_quality);
         registry.add_function("Canvas_set_pixel", set_pixel);
         registry.add_function("Canvas_write", write);
       }
@@ -110,6 +199,11 @@ namespace sunray
         return get_class(c)->height();
       }
 
+      static std::string get_quality(const sunray::script::MutableClassPtr& c)
+      {
+        return get_class(c)->quality();
+      }
+
       static double set_pixel(sunray::script::MutableClassPtr& c, double x, double y,
                               const sunray::script::MutableClassPtr& color)
       {
@@ -123,9 +217,14 @@ namespace sunray
       }
       static double write(sunray::script::MutableClassPtr& c, const std::string& filename)
       {
-        get_class(c)->write(filename);
+        auto canvas = get_class(c);
+        if (std::static_pointer_cast<const CanvasMetaClass>(canvas->meta_class())->write_files_) {
+          canvas->write(filename);
+        }
         return 0;
       }
+
+      bool write_files_{true};
     };
   }
 }
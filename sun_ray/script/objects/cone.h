@@ -31,7 +31,8 @@ namespace sunray
 
       sunray::ConePtr cone(double maximum, double minimum, bool closed) const
       {
-        return sunray::Cone::make_cone(material_, trans_.matrix(), casts_shadow_, maximum, minimum, closed);
+        return sunray::Cone::make_cone(material_, trans_.matrix(), casts_shadow_, static_cast<sunray::Real>(maximum),
+                                       static_cast<sunray::Real>(minimum), closed);
       }
 
       std::shared_ptr<const sunray::Object> shape() const override
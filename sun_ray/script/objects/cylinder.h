@@ -31,7 +31,8 @@ namespace sunray
 
       sunray::CylinderPtr cylinder(double maximum, double minimum, bool closed) const
       {
-        return sunray::Cylinder::make_cylinder(material_, trans_.matrix(), casts_shadow_, maximum, minimum, closed);
+        return sunray::Cylinder::make_cylinder(material_, trans_.matrix(), casts_shadow_, static_cast<sunray::Real>(maximum),
+                                               static_cast<sunray::Real>(minimum), closed);
       }
 
       std::shared_ptr<const sunray::Object> shape() const override
@@ -31,7 +31,8 @@ namespace sunray
 
       sunray::DiskPtr disk(double inner_radius) const
       {
-        return sunray::Disk::make_disk(material_, trans_.matrix(), casts_shadow_, inner_radius);
+        return sunray::Disk::make_disk(material_, trans_.matrix(), casts_shadow_,
+                                       static_cast<sunray::Real>(inner_radius));
       }
 
       std::shared_ptr<const sunray::Object> shape() const override
@@ -0,0 +1,121 @@
+//
+//  group.h
+//  sun_ray
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#pragma once
+
+#include <sun_ray/feature/group.h>
+#include <sun_ray/script/objects/shape.h>
+
+#include <algorithm>
+
+
+namespace sunray
+{
+  namespace script
+  {
+    class Group : public Shape
+    {
+    public:
+      Group(MetaClassPtr meta_class)
+      : Shape(meta_class)
+      {
+      }
+
+      std::string to_string() const override
+      {
+        return fmt::format("Group");
+      }
+
+      MutableClassPtr add(const std::shared_ptr<Shape>& shape)
+      {
+        if (shape.get() == this || contains(*shape, *this)) {
+          throw std::runtime_error{"Group cannot be added to itself or to one of its members"};
+        }
+        children_.push_back(shape);
+        return shared_from_this();
+      }
+
+      sunray::GroupPtr group() const
+      {
+        std::vector<sunray::ObjectPtr> children;
+        children.reserve(children_.size());
+        for (const auto& child : children_) {
+          children.push_back(child->shape());
+        }
+        return sunray::Group::make_group(trans_.matrix(), std::move(children));
+      }
+
+      std::shared_ptr<const sunray::Object> shape() const override
+      {
+        return group();
+      }
+
+    private:
+      // Whether the shape is a group holding the member, directly or in one of its nested groups
+      static bool contains(const Shape& shape, const Shape& member)
+      {
+        const auto* group = dynamic_cast<const Group*>(&shape);
+        if (!group) {
+          return false;
+        }
+        return std::any_of(group->children_.begin(), group->children_.end(), [&member](const auto& child) {
+          return child.get() == &member || contains(*child, member);
+        });
+      }
+
+      std::vector<std::shared_ptr<Shape>> children_;
+    };
+
+
+    class GroupMetaClass : public ShapeMetaClass
+    {
+    public:
+      GroupMetaClass() = default;
+
+      const std::string& name() const override
+      {
+        static const std::string name = "Group";
+        return name;
+      }
+
+      void init(sunray::script::FunctionRegistry& registry) override
+      {
+        auto self = std::dynamic_pointer_cast<GroupMetaClass>(shared_from_this());
+        registry.add_variadic_function("Group_constructor", [self](const std::vector<Variant>& parameter) {
+          if (!parameter.empty()) {
+            throw std::runtime_error{
+              fmt::format("Group constructor called with wrong parameter count. Should be 0, but is {}.", parameter.size())};
+          }
+          return self->construct();
+        });
+        registry.add_function("Group_add", add);
+        registry.add_function("Group_scale", scale);
+        registry.add_function("Group_shear", shear);
+        registry.add_function("Group_translate", translate);
+        registry.add_function("Group_rotate_x", rotate_x);
+        registry.add_function("Group_rotate_y", rotate_y);
+        registry.add_function("Group_rotate_z", rotate_z);
+      }
+
+      std::shared_ptr<Group> construct() const
+      {
+        return std::make_shared<Group>(shared_from_this());
+      }
+
+    private:
+      static MutableClassPtr add(MutableClassPtr& c, const MutableClassPtr& obj)
+      {
+        auto shape = std::dynamic_pointer_cast<Shape>(obj);
+        if (!shape) {
+          throw std::runtime_error{"Group add has to be called with a shape"};
+        }
+        return std::dynamic_pointer_cast<Group>(c)->add(shape);
+      }
+    };
+  }
+}
@@ -0,0 +1,115 @@
+//
+//  instance.h
+//  sun_ray
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#pragma once
+
+#include <sun_ray/feature/instance.h>
+#include <sun_ray/script/objects/shape.h>
+
+
+namespace sunray
+{
+  namespace script
+  {
+    class Instance : public Shape
+    {
+    public:
+      Instance(MetaClassPtr meta_class, std::shared_ptr<Shape> prototype)
+      : Shape(meta_class)
+      , prototype_shape_{std::move(prototype)}
+      {
+      }
+
+      Instance(MetaClassPtr meta_class, std::shared_ptr<Shape> prototype, const Material& material)
+      : Shape(meta_class, material)
+      , prototype_shape_{std::move(prototype)}
+      , has_material_{true}
+      {
+      }
+
+      std::string to_string() const override
+      {
+        return fmt::format("Instance");
+      }
+
+      sunray::InstancePtr instance() const
+      {
+        if (has_material_) {
+          return sunray::Instance::make_instance(prototype_shape_->prototype(), material_, trans_.matrix(), casts_shadow_);
+        }
+        return sunray::Instance::make_instance(prototype_shape_->prototype(), trans_.matrix(), casts_shadow_);
+      }
+
+      std::shared_ptr<const sunray::Object> shape() const override
+      {
+        return instance();
+      }
+
+    private:
+      std::shared_ptr<Shape> prototype_shape_;
+      bool has_material_{false};
+    };
+
+
+    class InstanceMetaClass : public ShapeMetaClass
+    {
+    public:
+      InstanceMetaClass() = default;
+
+      const std::string& name() const override
+      {
+        static const std::string name = "Instance";
+        return name;
+      }
+
+      void init(sunray::script::FunctionRegistry& registry) override
+      {
+        auto self = std::dynamic_pointer_cast<InstanceMetaClass>(shared_from_this());
+        registry.add_variadic_function("Instance_constructor", [self](const std::vector<Variant>& parameter) {
+          if (parameter.empty() || parameter.size() > 2) {
+            throw std::runtime_error{fmt::format(
+              "Instance constructor called with wrong parameter count. Should be 1 or 2, but is {}.", parameter.size())};
+          }
+          if (parameter.size() == 1) {
+            return self->construct(as_class(parameter[0]));
+          }
+          return self->construct(as_class(parameter[0]), as_class(parameter[1]));
+        });
+        registry.add_function("Instance_scale", scale);
+        registry.add_function("Instance_shear", shear);
+        registry.add_function("Instance_translate", translate);
+        registry.add_function("Instance_rotate_x", rotate_x);
+        registry.add_function("Instance_rotate_y", rotate_y);
+        registry.add_function("Instance_rotate_z", rotate_z);
+        registry.add_function("Instance_set_casts_shadow", casts_shadow);
+      }
+
+      std::shared_ptr<Instance> construct(const sunray::script::MutableClassPtr& prototype) const
+      {
+        return std::make_shared<Instance>(shared_from_this(), as_shape(prototype));
+      }
+
+      std::shared_ptr<Instance> construct(const sunray::script::MutableClassPtr& prototype,
+                                          const sunray::script::MutableClassPtr& material) const
+      {
+        return std::make_shared<Instance>(shared_from_this(), as_shape(prototype),
+                                          cast_object<Material, MaterialMetaClass>(material, "material"));
+      }
+
+    private:
+      static std::shared_ptr<Shape> as_shape(const sunray::script::MutableClassPtr& prototype)
+      {
+        auto shape = std::dynamic_pointer_cast<Shape>(prototype);
+        if (!shape) {
+          throw std::runtime_error{"Instance has to be constructed from a shape"};
+        }
+        return shape;
+      }
+    };
+  }
+}
@@ -30,37 +30,38 @@ namespace sunray
 
       MutableClassPtr scale(double x, double y, double z)
       {
-        trans_.scale(x, y, z);
+        trans_.scale(static_cast<sunray::Real>(x), static_cast<sunray::Real>(y), static_cast<sunray::Real>(z));
         return shared_from_this();
       }
 
       MutableClassPtr rotate_x(double radians)
       {
-        trans_.rotate_x(radians);
+        trans_.rotate_x(static_cast<sunray::Real>(radians));
         return shared_from_this();
       }
 
       MutableClassPtr rotate_y(double radians)
       {
-        trans_.rotate_y(radians);
+        trans_.rotate_y(static_cast<sunray::Real>(radians));
         return shared_from_this();
       }
 
       MutableClassPtr rotate_z(double radians)
       {
-        trans_.rotate_z(radians);
+        trans_.rotate_z(static_cast<sunray::Real>(radians));
         return shared_from_this();
       }
 
       MutableClassPtr translate(double x, double y, double z)
       {
-        trans_.translate(x, y, z);
+        trans_.translate(static_cast<sunray::Real>(x), static_cast<sunray::Real>(y), static_cast<sunray::Real>(z));
         return shared_from_this();
       }
 
       MutableClassPtr shear(double xy, double xz, double yx, double yz, double zx, double zy)
       {
-        trans_.shear(xy, xz, yx, yz, zx, zy);
+        trans_.shear(static_cast<sunray::Real>(xy), static_cast<sunray::Real>(xz), static_cast<sunray::Real>(yx),
+                    static_cast<sunray::Real>(yz), static_cast<sunray::Real>(zx), static_cast<sunray::Real>(zy));
         return shared_from_this();
       }
 
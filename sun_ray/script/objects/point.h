@@ -23,7 +23,7 @@ namespace sunray
     public:
       Point(MetaClassPtr meta_class, double x, double y, double z)
       : Class(meta_class)
-      , point_{sunray::create_point(x, y, z)}
+      , point_{sunray::create_point(static_cast<sunray::Real>(x), static_cast<sunray::Real>(y), static_cast<sunray::Real>(z))}
       {
       }
 
@@ -55,7 +55,7 @@ namespace sunray
 
       std::string to_string() const override
       {
-        return fmt::format("Point x: {} y: {} z: {}", x(), y(), z());
+        return fmt::format("Point x: {} y: {} z: {}", point_.x(), point_.y(), point_.z());
       }
 
       const sunray::Point& point() const
@@ -24,6 +24,12 @@ namespace sunray
     , public std::enable_shared_from_this<Shape>
     {
     public:
+      Shape(MetaClassPtr meta_class)
+      : Class(meta_class)
+      {
+        trans_.identity();
+      }
+
       Shape(MetaClassPtr meta_class, const Material& material)
       : Class(meta_class)
       , material_{material.material()}
@@ -33,37 +39,38 @@ namespace sunray
 
       MutableClassPtr scale(double x, double y, double z)
       {
-        trans_.scale(x, y, z);
+        trans_.scale(static_cast<sunray::Real>(x), static_cast<sunray::Real>(y), static_cast<sunray::Real>(z));
         return shared_from_this();
       }
 
       MutableClassPtr rotate_x(double radians)
       {
-        trans_.rotate_x(radians);
+        trans_.rotate_x(static_cast<sunray::Real>(radians));
         return shared_from_this();
       }
 
       MutableClassPtr rotate_y(double radians)
       {
-        trans_.rotate_y(radians);
+        trans_.rotate_y(static_cast<sunray::Real>(radians));
         return shared_from_this();
       }
 
       MutableClassPtr rotate_z(double radians)
       {
-        trans_.rotate_z(radians);
+        trans_.rotate_z(static_cast<sunray::Real>(radians));
         return shared_from_this();
       }
 
       MutableClassPtr translate(double x, double y, double z)
       {
-        trans_.translate(x, y, z);
+        trans_.translate(static_cast<sunray::Real>(x), static_cast<sunray::Real>(y), static_cast<sunray::Real>(z));
         return shared_from_this();
       }
 
       MutableClassPtr shear(double xy, double xz, double yx, double yz, double zx, double zy)
       {
-        trans_.shear(xy, xz, yx, yz, zx, zy);
+        trans_.shear(static_cast<sunray::Real>(xy), static_cast<sunray::Real>(xz), static_cast<sunray::Real>(yx),
+                    static_cast<sunray::Real>(yz), static_cast<sunray::Real>(zx), static_cast<sunray::Real>(zy));
         return shared_from_this();
       }
 
@@ -79,10 +86,21 @@ namespace sunray
 
       virtual std::shared_ptr<const sunray::Object> shape() const = 0;
 
+      // The shape shared by all instances of it. It is created on first use, so later changes to the shape do not affect
+      // its instances.
+      std::shared_ptr<const sunray::Object> prototype() const
+      {
+        if (!prototype_) {
+          prototype_ = shape();
+        }
+        return prototype_;
+      }
+
     protected:
       mutable sunray::Transformation trans_;
       sunray::Material material_;
       bool casts_shadow_{true};
+      mutable std::shared_ptr<const sunray::Object> prototype_;
     };
 
 
@@ -0,0 +1,143 @@
+//
+//  sphere_set.h
+//  sun_ray
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#pragma once
+
+#include <sun_ray/feature/sphere_set.h>
+#include <sun_ray/script/build_in_functions.h>
+#include <sun_ray/script/objects/point.h>
+#include <sun_ray/script/objects/shape.h>
+
+
+namespace sunray
+{
+  namespace script
+  {
+    class SphereSet : public Shape
+    {
+    public:
+      SphereSet(MetaClassPtr meta_class, const Material& material)
+      : Shape(meta_class, material)
+      {
+      }
+
+      std::string to_string() const override
+      {
+        return fmt::format("SphereSet size: {}", radii_.size());
+      }
+
+      MutableClassPtr add(double x, double y, double z, double radius)
+      {
+        if (radius <= 0) {
+          throw std::runtime_error{fmt::format("SphereSet radius has to be positive, but is {}", radius)};
+        }
+        centers_.emplace_back(
+          sunray::create_point(static_cast<sunray::Real>(x), static_cast<sunray::Real>(y), static_cast<sunray::Real>(z)));
+        radii_.push_back(static_cast<sunray::Real>(radius));
+        return shared_from_this();
+      }
+
+      MutableClassPtr scatter(double count, double minimum_radius, double maximum_radius, const sunray::Point& minimum,
+                              const sunray::Point& maximum)
+      {
+        if (count < 0) {
+          throw std::runtime_error{fmt::format("SphereSet scatter count must not be negative, but is {}", count)};
+        }
+        if (minimum_radius <= 0 || maximum_radius < minimum_radius) {
+          throw std::runtime_error{
+            fmt::format("SphereSet scatter radius range [{}, {}] is not valid", minimum_radius, maximum_radius)};
+        }
+        const auto uniform = [](double from, double to) {
+          return static_cast<sunray::Real>(from + (to - from) * (BuildInFunctions::random_number() + 1.0) / 2.0);
+        };
+        const auto n = static_cast<size_t>(count);
+        centers_.reserve(centers_.size() + n);
+        radii_.reserve(radii_.size() + n);
+        for (size_t i = 0; i < n; ++i) {
+          const auto x = uniform(minimum.x(), maximum.x());
+          const auto y = uniform(minimum.y(), maximum.y());
+          const auto z = uniform(minimum.z(), maximum.z());
+          centers_.emplace_back(sunray::create_point(x, y, z));
+          radii_.push_back(uniform(minimum_radius, maximum_radius));
+        }
+        return shared_from_this();
+      }
+
+      size_t size() const
+      {
+        return radii_.size();
+      }
+
+      sunray::SphereSetPtr sphere_set() const
+      {
+        return sunray::SphereSet::make_sphere_set(material_, trans_.matrix(), centers_, radii_, casts_shadow_);
+      }
+
+      std::shared_ptr<const sunray::Object> shape() const override
+      {
+        return sphere_set();
+      }
+
+    private:
+      std::vector<sunray::Point> centers_;
+      std::vector<sunray::Real> radii_;
+    };
+
+
+    class SphereSetMetaClass : public ShapeMetaClass
+    {
+    public:
+      SphereSetMetaClass() = default;
+
+      const std::string& name() const override
+      {
+        static const std::string name = "SphereSet";
+        return name;
+      }
+
+      void init(sunray::script::FunctionRegistry& registry) override
+      {
+        auto self = std::dynamic_pointer_cast<SphereSetMetaClass>(shared_from_this());
+        registry.add_variadic_function("SphereSet_constructor", [self](const std::vector<Variant>& parameter) {
+          if (parameter.size() != 1) {
+            throw std::runtime_error{
+              fmt::format("SphereSet constructor called with wrong parameter count. Should be 1, but is {}.", parameter.size())};
+          }
+          return self->construct(as_class(parameter[0]));
+        });
+        registry.add_function("SphereSet_add", add);
+        registry.add_function("SphereSet_scatter", scatter);
+        registry.add_function("SphereSet_scale", scale);
+        registry.add_function("SphereSet_shear", shear);
+        registry.add_function("SphereSet_translate", translate);
+        registry.add_function("SphereSet_rotate_x", rotate_x);
+        registry.add_function("SphereSet_rotate_y", rotate_y);
+        registry.add_function("SphereSet_rotate_z", rotate_z);
+        registry.add_function("SphereSet_set_casts_shadow", casts_shadow);
+      }
+
+      std::shared_ptr<SphereSet> construct(const sunray::script::MutableClassPtr& material) const
+      {
+        return std::make_shared<SphereSet>(shared_from_this(), cast_object<Material, MaterialMetaClass>(material, "material"));
+      }
+
+    private:
+      static MutableClassPtr add(MutableClassPtr& c, double x, double y, double z, double radius)
+      {
+        return std::dynamic_pointer_cast<SphereSet>(c)->add(x, y, z, radius);
+      }
+      static MutableClassPtr scatter(MutableClassPtr& c, double count, double minimum_radius, double maximum_radius,
+                                     const MutableClassPtr& minimum, const MutableClassPtr& maximum)
+      {
+        return std::dynamic_pointer_cast<SphereSet>(c)->scatter(
+          count, minimum_radius, maximum_radius, cast_object<Point>(minimum, "Point", "minimum").point(),
+          cast_object<Point>(maximum, "Point", "maximum").point());
+      }
+    };
+  }
+}
@@ -22,7 +22,7 @@ namespace sunray
     public:
       Vector(MetaClassPtr meta_class, double x, double y, double z)
       : Class(meta_class)
-      , vector_{sunray::create_vector(x, y, z)}
+      , vector_{sunray::create_vector(static_cast<sunray::Real>(x), static_cast<sunray::Real>(y), static_cast<sunray::Real>(z))}
       {
       }
 
@@ -59,12 +59,12 @@ namespace sunray
 
       MutableClassPtr multiply(double scalar) const
       {
-        return std::make_shared<Vector>(meta_class(), vector_ * scalar);
+        return std::make_shared<Vector>(meta_class(), vector_ * static_cast<sunray::Real>(scalar));
       }
 
       std::string to_string() const override
       {
-        return fmt::format("Vector x: {} y: {} z: {}", x(), y(), z());
+        return fmt::format("Vector x: {} y: {} z: {}", vector_.x(), vector_.y(), vector_.z());
       }
 
       const sunray::Vector& vector() const
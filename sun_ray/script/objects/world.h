@@ -14,6 +14,11 @@
 #include <sun_ray/script/objects/light.h>
 #include <sun_ray/script/objects/sphere.h>
 
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <utility>
+
 
 namespace sunray
 {
@@ -31,12 +36,14 @@ namespace sunray
 
       MutableClassPtr add(const std::shared_ptr<const sunray::PointLight>& light)
       {
+        wait_for_frame();
         world_.add_light(light);
         return shared_from_this();
       }
 
       MutableClassPtr add(const std::shared_ptr<const sunray::Object>& object)
       {
+        wait_for_frame();
         world_.add_object(object);
         return shared_from_this();
       }
@@ -56,26 +63,140 @@ namespace sunray
         refractions_ = set;
       }
 
+      void tile_size(double size)
+      {
+        if (size < 1.0) {
+          throw std::runtime_error{fmt::format("World tile_size has to be at least 1, but is {}.", size)};
+        }
+        tile_size_ = static_cast<uint32_t>(size);
+      }
+
+      void samples_per_pixel(double samples)
+      {
+        if (samples < 1.0 || samples > 1024.0) {
+          throw std::runtime_error{fmt::format("World samples_per_pixel has to be between 1 and 1024, but is {}.", samples)};
+        }
+        samples_per_pixel_ = static_cast<uint32_t>(samples);
+      }
+
+      void filter(const std::string& name)
+      {
+        if (name == "box") {
+          filter_ = sunray::ReconstructionFilter::BOX;
+        } else if (name == "gaussian") {
+          filter_ = sunray::ReconstructionFilter::GAUSSIAN;
+        } else {
+          throw std::runtime_error{fmt::format("World filter has to be 'box' or 'gaussian', but is '{}'.", name)};
+        }
+      }
+
+      void anti_aliasing(bool set)
+      {
+        anti_aliasing_ = set;
+      }
+
+      void anti_aliasing_threshold(double threshold)
+      {
+        if (threshold < 0.0) {
+          throw std::runtime_error{fmt::format("World anti_aliasing_threshold must not be negative, but is {}.", threshold)};
+        }
+        anti_aliasing_threshold_ = static_cast<float>(threshold);
+      }
+
+      void minimum_weight(double weight)
+      {
+        if (weight < 0.0 || weight > 1.0) {
+          throw std::runtime_error{fmt::format("World minimum_weight has to be between 0 and 1, but is {}.", weight)};
+        }
+        minimum_weight_ = static_cast<float>(weight);
+      }
+
+      void russian_roulette(bool set)
+      {
+        russian_roulette_ = set;
+      }
+
+      void russian_roulette_depth(double depth)
+      {
+        if (depth < 0.0 || depth > 255.0) {
+          throw std::runtime_error{fmt::format("World russian_roulette_depth has to be between 0 and 255, but is {}.", depth)};
+        }
+        russian_roulette_depth_ = static_cast<uint8_t>(depth);
+      }
+
+      void deadline(double seconds)
+      {
+        if (seconds < 0.0) {
+          throw std::runtime_error{fmt::format("World deadline must not be negative, but is {}.", seconds)};
+        }
+        deadline_ = std::chrono::milliseconds{std::llround(seconds * 1000.0)};
+      }
+
       std::string to_string() const override
       {
         return fmt::format("World");
       }
 
+      // A frame rendered in the background reads the world until it is done, the function waits for the frame
+      void in_flight(std::function<void()> wait_for_frame) const
+      {
+        wait_for_frame_ = std::move(wait_for_frame);
+      }
+
       const sunray::World& world() const
       {
+        wait_for_frame();
         sunray::RenderContext context;
         context.shadows_ = shadows_;
         context.reflections_ = reflections_;
         context.refractions_ = refractions_;
+        context.tile_size_ = tile_size_;
+        context.samples_per_pixel_ = samples_per_pixel_;
+        context.filter_ = filter_;
+        context.anti_aliasing_ = anti_aliasing_;
+        context.anti_aliasing_threshold_ = anti_aliasing_threshold_;
+        context.minimum_weight_ = minimum_weight_;
+        context.russian_roulette_ = russian_roulette_;
+        context.russian_roulette_depth_ = russian_roulette_depth_;
+        context.deadline_ = deadline_;
         world_.context(context);
+        if (!world_.has_hierarchy()) {
+          world_.build_hierarchy();
+        }
+        return world_;
+      }
+
+      // For renders, which change the render context for a while
+      sunray::World& world()
+      {
+        std::as_const(*this).world();
         return world_;
       }
 
     private:
+      void wait_for_frame() const
+      {
+        if (wait_for_frame_) {
+          const auto wait = std::move(wait_for_frame_);
+          wait_for_frame_ = nullptr;
+          wait();
+        }
+      }
+
       bool shadows_{true};
       bool reflections_{true};
       bool refractions_{true};
+      uint32_t tile_size_{sunray::TileScheduler::default_tile_size};
+      uint32_t samples_per_pixel_{1};
+      sunray::ReconstructionFilter filter_{sunray::ReconstructionFilter::BOX};
+      bool anti_aliasing_{false};
+      float anti_aliasing_threshold_{0.1f};
+      float minimum_weight_{sunray::RenderContext{}.minimum_weight_};
+      bool russian_roulette_{false};
+      uint8_t russian_roulette_depth_{sunray::RenderContext{}.russian_roulette_depth_};
+      std::chrono::milliseconds deadline_{0};
       mutable sunray::World world_;
+      mutable std::function<void()> wait_for_frame_;
     };
 
 
@@ -84,6 +205,12 @@ namespace sunray
     public:
       WorldMetaClass() = default;
 
+      // All worlds constructed by this meta class start with the given deadline for their frames
+      explicit WorldMetaClass(std::chrono::milliseconds deadline)
+      : deadline_{deadline}
+      {
+      }
+
       const std::string& name() const override
       {
         static const std::string name = "World";
@@ -104,11 +231,22 @@ namespace sunray
         registry.add_function("World_set_shadows", shadows);
         registry.add_function("World_set_reflections", reflections);
         registry.add_function("World_set_refractions", refractions);
+        registry.add_function("World_set_tile_size", tile_size);
+        registry.add_function("World_set_samples_per_pixel", samples_per_pixel);
+        registry.add_function("World_set_filter", filter);
+        registry.add_function("World_set_anti_aliasing", anti_aliasing);
+        registry.add_function("World_set_anti_aliasing_threshold", anti_aliasing_threshold);
+        registry.add_function("World_set_minimum_weight", minimum_weight);
+        registry.add_function("World_set_russian_roulette", russian_roulette);
+        registry.add_function("World_set_russian_roulette_depth", russian_roulette_depth);
+        registry.add_function("World_set_deadline", deadline);
       }
 
       std::shared_ptr<World> construct() const
       {
-        return std::make_shared<World>(shared_from_this());
+        auto world = std::make_shared<World>(shared_from_this());
+        world->deadline(std::chrono::duration<double>(deadline_).count());
+        return world;
       }
 
     private:
@@ -139,6 +277,53 @@ namespace sunray
         get_class(c)->refractions(set);
         return 0.0;
       }
+      static double tile_size(MutableClassPtr& c, double size)
+      {
+        get_class(c)->tile_size(size);
+        return 0.0;
+      }
+      static double samples_per_pixel(MutableClassPtr& c, double samples)
+      {
+        get_class(c)->samples_per_pixel(samples);
+        return 0.0;
+      }
+      static double filter(MutableClassPtr& c, const std::string& name)
+      {
+        get_class(c)->filter(name);
+        return 0.0;
+      }
+      static double anti_aliasing(MutableClassPtr& c, bool set)
+      {
+        get_class(c)->anti_aliasing(set);
+        return 0.0;
+      }
+      static double anti_aliasing_threshold(MutableClassPtr& c, double threshold)
+      {
+        get_class(c)->anti_aliasing_threshold(threshold);
+        return 0.0;
+      }
+      static double minimum_weight(MutableClassPtr& c, double weight)
+      {
+        get_class(c)->minimum_weight(weight);
+        return 0.0;
+      }
+      static double russian_roulette(MutableClassPtr& c, bool set)
+      {
+        get_class(c)->russian_roulette(set);
+        return 0.0;
+      }
+      static double russian_roulette_depth(MutableClassPtr& c, double depth)
+      {
+        get_class(c)->russian_roulette_depth(depth);
+        return 0.0;
+      }
+      static double deadline(MutableClassPtr& c, double seconds)
+      {
+        get_class(c)->deadline(seconds);
+        return 0.0;
+      }
+
+      std::chrono::milliseconds deadline_{0};
     };
   }
 }
@@ -8,6 +8,7 @@
 
 #include <src/sun_ray/application.h>
 #include <sstream>
+#include <thread>
 
 #include "temporary_directory.h"
 
@@ -66,6 +67,17 @@ TEST_CASE("application", "[application]")
     CHECK(output.str() == "z = 220.00");
     CHECK_FALSE(error.str().empty());
   }
+  SECTION("process simple script with progress")
+  {
+    std::stringstream output;
+    std::stringstream error;
+
+    std::vector<std::string> args{"sun_ray", "--progress", "sample.wsl"};
+
+    sunray::Application app(output, error, args);
+    CHECK(app.run() == 0);
+    CHECK(output.str() == "z = 220.00");
+  }
   SECTION("process help option")
   {
     std::stringstream output;
@@ -80,6 +92,50 @@ TEST_CASE("application", "[application]")
   }
 }
 
+TEST_CASE("application with render processes", "[application]")
+{
+  const std::string scene = R"(
+      camera = Camera()
+      camera.from = (0, 0, -5)
+      camera.to = (0, 0, 0)
+      camera.up = [0, 1, 0]
+      camera.horizontal = 23
+      camera.vertical = 17
+      world = World()
+      world.add(Light(Point(-10, 10, -10), Color(1, 1, 1)))
+      world.add(Sphere(Material()))
+      world.tile_size = 4
+      world.anti_aliasing = true
+      canvas = camera.render(world)
+  )";
+
+  TemporaryDirectoryGuard guard;
+  create_input_file(guard, scene + "canvas.write('single')\n", "single.wsl");
+  create_input_file(guard, scene + "canvas.write('several')\nprint('done')\n", "several.wsl");
+
+  SECTION("anti aliased image of several processes is the same as the one of a single process")
+  {
+    std::stringstream output;
+    std::stringstream error;
+    sunray::Application single(output, error, {"sun_ray", "-p", "1", "single.wsl"});
+    CHECK(single.run() == 0);
+    sunray::Application several(output, error, {"sun_ray", "-p", "2", "-t", "2", "several.wsl"});
+    CHECK(several.run() == 0);
+    // The workers do not print
+    CHECK(output.str() == "done");
+
+    const auto expected = sunray::CanvasFileReader{guard.temporary_directory_path() / "single.png"}.read();
+    const auto canvas = sunray::CanvasFileReader{guard.temporary_directory_path() / "several.png"}.read();
+    REQUIRE(canvas.width() == expected.width());
+    REQUIRE(canvas.height() == expected.height());
+    for (uint32_t y = 0; y < canvas.height(); ++y) {
+      for (uint32_t x = 0; x < canvas.width(); ++x) {
+        CHECK(canvas.pixel_at(x, y) == expected.pixel_at(x, y));
+      }
+    }
+  }
+}
+
 TEST_CASE("application error", "[application]")
 {
   SECTION("cmd error")
@@ -143,3 +199,74 @@ TEST_CASE("application process error", "[application]")
     CHECK(app.run() == -1);
   }
 }
+
+TEST_CASE("progress reporter", "[application]")
+{
+  sunray::RenderProgress progress;
+  progress.add_tiles(4);
+  progress.tile_done(100);
+
+  SECTION("progress line")
+  {
+    const auto line = sunray::ProgressReporter::line(progress);
+    CHECK(line.rfind("progress: 25% (1/4 tiles) ", 0) == 0);
+    CHECK(line.find(" Mrays/s") != std::string::npos);
+  }
+  SECTION("cancelled progress line")
+  {
+    progress.cancel();
+    const auto line = sunray::ProgressReporter::line(progress);
+    CHECK(line.substr(line.size() - 10) == " cancelled");
+  }
+  SECTION("last line is printed")
+  {
+    std::stringstream stream;
+    {
+      sunray::ProgressReporter reporter{stream, progress, std::chrono::milliseconds{60000}};
+    }
+    CHECK(stream.str().rfind("progress: 25% (1/4 tiles) ", 0) == 0);
+  }
+}
+
+TEST_CASE("synchronized stream", "[application]")
+{
+  std::stringstream target;
+  std::mutex mutex;
+
+  SECTION("complete lines are passed on")
+  {
+    {
+      sunray::SynchronizedStream stream{target, mutex};
+      stream << "first " << 1;
+      CHECK(target.str().empty());
+      stream << " line\nsecond";
+      CHECK(target.str() == "first 1 line\n");
+      stream << std::flush;
+      CHECK(target.str() == "first 1 line\nsecond");
+      stream << " line";
+    }
+    CHECK(target.str() == "first 1 line\nsecond line");
+  }
+  SECTION("lines of several threads do not interleave")
+  {
+    const auto write = [&target, &mutex](char c) {
+      sunray::SynchronizedStream stream{target, mutex};
+      for (int n = 0; n < 1000; ++n) {
+        stream << std::string(10, c) << ' ' << n << std::endl;
+      }
+    };
+    std::thread first{write, 'a'};
+    std::thread second{write, 'b'};
+    first.join();
+    second.join();
+
+    std::string line;
+    size_t lines{0};
+    while (std::getline(target, line)) {
+      CHECK((line.find_first_not_of('a', 0) == 10 || line.find_first_not_of('b', 0) == 10));
+      CHECK(line.find(line[0] == 'a' ? 'b' : 'a') == std::string::npos);
+      ++lines;
+    }
+    CHECK(lines == 2000);
+  }
+}
@@ -0,0 +1,44 @@
+//
+//  canvas_file_reader_test.cpp
+//  sun_ray_test
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#include <sun_ray/canvas_file_reader.h>
+#include <sun_ray/canvas_file_writer.h>
+
+#include "temporary_directory.h"
+
+#include <catch2/catch.hpp>
+
+
+TEST_CASE("read file canvas", "[canvas file reader]")
+{
+  SECTION("read png file")
+  {
+    TemporaryDirectoryGuard guard;
+    auto file = guard.temporary_directory_path() / "test.png";
+
+    sunray::Canvas canvas{7, 5};
+    const auto red = sunray::Color{1.0f, 0, 0};
+    const auto gray = sunray::Color{0.2f, 0.2f, 0.2f};
+    canvas.pixel_at(0, 0, red);
+    canvas.pixel_at(6, 4, gray);
+    sunray::CanvasFileWriter writer{sunray::ImageFormat::PNG, file};
+    writer.write(canvas);
+
+    const auto read = sunray::CanvasFileReader{file}.read();
+    REQUIRE(read.width() == 7);
+    REQUIRE(read.height() == 5);
+    CHECK(read.pixel_at(0, 0) == red);
+    CHECK(read.pixel_at(6, 4) == gray);
+    CHECK(read.pixel_at(3, 2) == sunray::Color{0, 0, 0});
+  }
+  SECTION("read missing file")
+  {
+    std::filesystem::path file{"/this/file/does/not/exist/test.png"};
+    CHECK_THROWS_AS(sunray::CanvasFileReader{file}.read(), std::runtime_error);
+  }
+}
@@ -0,0 +1,64 @@
+//
+//  accumulation_buffer_test.cpp
+//  sun_ray_test
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#include <sun_ray/feature/accumulation_buffer.h>
+
+#include <catch2/catch.hpp>
+
+
+TEST_CASE("accumulation buffer", "[accumulation buffer]")
+{
+  sunray::AccumulationBuffer buffer{10, 6};
+
+  SECTION("empty buffer")
+  {
+    CHECK(buffer.width() == 10);
+    CHECK(buffer.height() == 6);
+    CHECK(buffer.samples(3, 4) == 0);
+    CHECK(buffer.color_at(3, 4) == sunray::Color(0, 0, 0));
+    CHECK(std::isinf(buffer.standard_error(3, 4)));
+    CHECK_THROWS_AS(buffer.samples(10, 0), std::out_of_range);
+    CHECK_THROWS_AS(buffer.add(0, 6, sunray::Color(1, 1, 1)), std::out_of_range);
+  }
+  SECTION("mean of samples")
+  {
+    buffer.add(3, 4, sunray::Color(1, 0, 0));
+    buffer.add(3, 4, sunray::Color(0, 1, 0));
+    CHECK(buffer.samples(3, 4) == 2);
+    CHECK(buffer.color_at(3, 4) == sunray::Color(0.5f, 0.5f, 0));
+  }
+  SECTION("weighted samples")
+  {
+    buffer.add(1, 1, sunray::Color(1, 1, 1), 3.0f);
+    buffer.add(1, 1, sunray::Color(0, 0, 0), 1.0f);
+    CHECK(buffer.color_at(1, 1) == sunray::Color(0.75f, 0.75f, 0.75f));
+  }
+  SECTION("standard error")
+  {
+    for (int n = 0; n < 4; ++n) {
+      buffer.add(2, 2, sunray::Color(0.5f, 0.5f, 0.5f));
+    }
+    CHECK(buffer.standard_error(2, 2) == Approx(0.0).margin(1e-9));
+
+    buffer.add(5, 5, sunray::Color(0, 0, 0));
+    buffer.add(5, 5, sunray::Color(1, 1, 1));
+    CHECK(buffer.standard_error(5, 5) == Approx(0.5));
+  }
+  SECTION("canvas fills gaps from coarse samples")
+  {
+    buffer.add(0, 0, sunray::Color(1, 0, 0));
+    buffer.add(8, 0, sunray::Color(0, 1, 0));
+    buffer.add(4, 4, sunray::Color(0, 0, 1));
+    buffer.add(9, 5, sunray::Color(1, 1, 1));
+    const auto canvas = buffer.canvas();
+    CHECK(canvas.pixel_at(7, 3) == sunray::Color(1, 0, 0));
+    CHECK(canvas.pixel_at(9, 3) == sunray::Color(0, 1, 0));
+    CHECK(canvas.pixel_at(5, 5) == sunray::Color(0, 0, 1));
+    CHECK(canvas.pixel_at(9, 5) == sunray::Color(1, 1, 1));
+  }
+}
@@ -0,0 +1,92 @@
+//
+//  affine_transform_test.cpp
+//  sun_ray_test
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#include <sun_ray/feature/affine_transform.h>
+#include <sun_ray/feature/transformation.h>
+
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+
+TEST_CASE("classify transformations", "[affine transform]")
+{
+  SECTION("identity")
+  {
+    CHECK(sunray::AffineTransform::classify(sunray::Matrix44::identity()) == sunray::TransformKind::identity);
+    CHECK(sunray::AffineTransform::classify(sunray::Matrix44::identity().inverse()) == sunray::TransformKind::identity);
+    CHECK(sunray::AffineTransform::classify(sunray::Matrix44::scaling(1, 1, 1)) == sunray::TransformKind::identity);
+  }
+  SECTION("translate")
+  {
+    CHECK(sunray::AffineTransform::classify(sunray::Matrix44::translation(2, 3, 4)) == sunray::TransformKind::translate);
+    CHECK(sunray::AffineTransform::classify(sunray::Matrix44::translation(2, 3, 4).inverse()) ==
+          sunray::TransformKind::translate);
+    CHECK(sunray::AffineTransform::classify(sunray::Matrix44::translation(0, 0, -1)) == sunray::TransformKind::translate);
+  }
+  SECTION("translate and scale")
+  {
+    CHECK(sunray::AffineTransform::classify(sunray::Matrix44::scaling(2, 2, 2)) == sunray::TransformKind::translate_scale);
+    CHECK(sunray::AffineTransform::classify(sunray::Matrix44::scaling(2, 0.5, 3)) ==
+          sunray::TransformKind::translate_scale);
+    const auto matrix = sunray::Transformation().scale(0.5, 0.5, 0.5).translate(1, -2, 3).matrix();
+    CHECK(sunray::AffineTransform::classify(matrix) == sunray::TransformKind::translate_scale);
+    CHECK(sunray::AffineTransform::classify(matrix.inverse()) == sunray::TransformKind::translate_scale);
+  }
+  SECTION("affine")
+  {
+    CHECK(sunray::AffineTransform::classify(sunray::Matrix44::rotation_y(sunray::PI / 4)) == sunray::TransformKind::affine);
+    CHECK(sunray::AffineTransform::classify(sunray::Matrix44::shearing(1, 0, 0, 0, 0, 0)) == sunray::TransformKind::affine);
+    const auto matrix = sunray::Transformation().rotate_x(sunray::PI / 2).scale(2, 2, 2).translate(1, 0, 0).matrix();
+    CHECK(sunray::AffineTransform::classify(matrix) == sunray::TransformKind::affine);
+    CHECK(sunray::AffineTransform::classify(matrix.inverse()) == sunray::TransformKind::affine);
+  }
+  SECTION("general")
+  {
+    const sunray::Matrix44 matrix{{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0.5, 0, 1}};
+    CHECK(sunray::AffineTransform::classify(matrix) == sunray::TransformKind::general);
+  }
+}
+
+TEST_CASE("apply affine transforms", "[affine transform]")
+{
+  const auto point = sunray::create_point(-3, 4, 5);
+  const auto vector = sunray::create_vector(1, -2, 0.5);
+  const std::vector<sunray::Matrix44> matrices{
+    sunray::Matrix44::identity(), sunray::Matrix44::translation(5, -3, 2), sunray::Matrix44::scaling(2, 3, 4),
+    sunray::Transformation().scale(0.25, 0.25, 0.25).translate(1, 2, 3).matrix(),
+    sunray::Transformation().rotate_z(sunray::PI / 5).shear(1, 0, 0.5, 0, 0, 1).translate(-1, 0, 2).matrix()};
+
+  SECTION("point and vector")
+  {
+    for (const auto& matrix : matrices) {
+      const sunray::AffineTransform transform{matrix};
+      CHECK(transform.kind() == sunray::AffineTransform::classify(matrix));
+      CHECK(transform * point == matrix * point);
+      CHECK(transform * vector == matrix * vector);
+    }
+  }
+  SECTION("ray")
+  {
+    const sunray::Ray ray{point, vector};
+    for (const auto& matrix : matrices) {
+      const sunray::AffineTransform transform{matrix};
+      CHECK(transform.transform(ray) == ray.transform(matrix));
+    }
+  }
+  SECTION("normal matrix")
+  {
+    for (const auto& matrix : matrices) {
+      const auto inverse = matrix.inverse();
+      const auto normal_matrix = sunray::AffineTransform::normal_matrix(inverse);
+      const auto expected = inverse.transpose() * vector;
+      CHECK(normal_matrix * vector == sunray::create_vector(expected.x(), expected.y(), expected.z()));
+      CHECK(normal_matrix.kind() != sunray::TransformKind::translate);
+    }
+  }
+}
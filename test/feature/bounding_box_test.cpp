@@ -0,0 +1,203 @@
+//
+//  bounding_box_test.cpp
+//  sun_ray_test
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#include <sun_ray/feature/bounding_box.h>
+#include <sun_ray/feature/cone.h>
+#include <sun_ray/feature/cube.h>
+#include <sun_ray/feature/cylinder.h>
+#include <sun_ray/feature/disk.h>
+#include <sun_ray/feature/plane.h>
+#include <sun_ray/feature/sphere.h>
+#include <sun_ray/feature/transformation.h>
+#include <sun_ray/feature/triangle.h>
+
+#include <sstream>
+
+#include <catch2/catch.hpp>
+
+
+TEST_CASE("create bounding box", "[bounding_box]")
+{
+  SECTION("create empty bounding box")
+  {
+    sunray::BoundingBox box;
+    CHECK(box.is_empty());
+    CHECK_FALSE(box.is_bounded());
+    CHECK(box.surface_area() == Approx(0));
+  }
+  SECTION("create bounding box with volume")
+  {
+    sunray::BoundingBox box{sunray::create_point(-1, -2, -3), sunray::create_point(3, 2, 1)};
+    CHECK_FALSE(box.is_empty());
+    CHECK(box.is_bounded());
+    CHECK(box.minimum() == sunray::create_point(-1, -2, -3));
+    CHECK(box.maximum() == sunray::create_point(3, 2, 1));
+    CHECK(box.centroid() == sunray::create_point(1, 0, -1));
+    CHECK(box.surface_area() == Approx(96));
+  }
+  SECTION("create infinite bounding box")
+  {
+    auto box = sunray::BoundingBox::infinite();
+    CHECK_FALSE(box.is_empty());
+    CHECK_FALSE(box.is_bounded());
+    CHECK(box.contains(sunray::create_point(1000, -1000, 1000)));
+  }
+  SECTION("output bounding box")
+  {
+    sunray::BoundingBox box{sunray::create_point(-1, -1, -1), sunray::create_point(1, 1, 1)};
+    std::stringstream ss;
+    ss << box;
+    CHECK(ss.str() == "minimum: x: -1 y: -1 z: -1 w: 1 maximum: x: 1 y: 1 z: 1 w: 1");
+  }
+}
+
+TEST_CASE("extend bounding box", "[bounding_box]")
+{
+  SECTION("add points to bounding box")
+  {
+    sunray::BoundingBox box;
+    box.add(sunray::create_point(-5, 2, 0));
+    box.add(sunray::create_point(7, 0, -3));
+    CHECK(box.minimum() == sunray::create_point(-5, 0, -3));
+    CHECK(box.maximum() == sunray::create_point(7, 2, 0));
+  }
+  SECTION("add bounding box to bounding box")
+  {
+    sunray::BoundingBox box{sunray::create_point(-5, -2, 0), sunray::create_point(7, 4, 4)};
+    box.add(sunray::BoundingBox{sunray::create_point(8, -7, -2), sunray::create_point(14, 2, 8)});
+    CHECK(box.minimum() == sunray::create_point(-5, -7, -2));
+    CHECK(box.maximum() == sunray::create_point(14, 4, 8));
+  }
+  SECTION("add empty bounding box")
+  {
+    sunray::BoundingBox box{sunray::create_point(-1, -1, -1), sunray::create_point(1, 1, 1)};
+    box.add(sunray::BoundingBox{});
+    CHECK(box == sunray::BoundingBox{sunray::create_point(-1, -1, -1), sunray::create_point(1, 1, 1)});
+  }
+  SECTION("largest axis")
+  {
+    CHECK(sunray::BoundingBox{sunray::create_point(0, 0, 0), sunray::create_point(3, 1, 2)}.largest_axis() == 0);
+    CHECK(sunray::BoundingBox{sunray::create_point(0, 0, 0), sunray::create_point(1, 3, 2)}.largest_axis() == 1);
+    CHECK(sunray::BoundingBox{sunray::create_point(0, 0, 0), sunray::create_point(1, 2, 3)}.largest_axis() == 2);
+  }
+}
+
+TEST_CASE("bounding box contains", "[bounding_box]")
+{
+  sunray::BoundingBox box{sunray::create_point(5, -2, 0), sunray::create_point(11, 4, 7)};
+
+  SECTION("box contains point")
+  {
+    CHECK(box.contains(sunray::create_point(5, -2, 0)));
+    CHECK(box.contains(sunray::create_point(11, 4, 7)));
+    CHECK(box.contains(sunray::create_point(8, 1, 3)));
+    CHECK_FALSE(box.contains(sunray::create_point(3, 0, 3)));
+    CHECK_FALSE(box.contains(sunray::create_point(8, -4, 3)));
+    CHECK_FALSE(box.contains(sunray::create_point(8, 1, 8)));
+  }
+  SECTION("box contains box")
+  {
+    CHECK(box.contains(sunray::BoundingBox{sunray::create_point(5, -2, 0), sunray::create_point(11, 4, 7)}));
+    CHECK(box.contains(sunray::BoundingBox{sunray::create_point(6, -1, 1), sunray::create_point(10, 3, 6)}));
+    CHECK_FALSE(box.contains(sunray::BoundingBox{sunray::create_point(4, -3, -1), sunray::create_point(10, 3, 6)}));
+    CHECK_FALSE(box.contains(sunray::BoundingBox{sunray::create_point(6, -1, 1), sunray::create_point(12, 5, 8)}));
+  }
+}
+
+TEST_CASE("transform bounding box", "[bounding_box]")
+{
+  SECTION("rotate bounding box")
+  {
+    sunray::BoundingBox box{sunray::create_point(-1, -1, -1), sunray::create_point(1, 1, 1)};
+    sunray::Transformation trans;
+    trans.rotate_y(sunray::PI / 4).translate(1, 2, 3);
+    auto transformed = box.transform(trans.matrix());
+    CHECK(transformed.minimum() == sunray::create_point(1 - sqrt(2), 1, 3 - sqrt(2)));
+    CHECK(transformed.maximum() == sunray::create_point(1 + sqrt(2), 3, 3 + sqrt(2)));
+  }
+  SECTION("transform empty and infinite bounding box")
+  {
+    CHECK(sunray::BoundingBox{}.transform(sunray::Matrix44::translation(1, 2, 3)).is_empty());
+    auto transformed = sunray::BoundingBox::infinite().transform(sunray::Matrix44::translation(1, 2, 3));
+    CHECK_FALSE(transformed.is_empty());
+    CHECK_FALSE(transformed.is_bounded());
+  }
+}
+
+TEST_CASE("intersect bounding box", "[bounding_box]")
+{
+  sunray::BoundingBox box{sunray::create_point(5, -2, 0), sunray::create_point(11, 4, 7)};
+  const auto inf = std::numeric_limits<double>::infinity();
+  const auto inverse = [](const sunray::Vector& direction) {
+    return sunray::create_vector(1.0 / direction.x(), 1.0 / direction.y(), 1.0 / direction.z());
+  };
+
+  SECTION("ray hits bounding box")
+  {
+    CHECK(box.intersects(sunray::create_point(15, 1, 2), inverse(sunray::create_vector(-1, 0, 0)), inf));
+    CHECK(box.intersects(sunray::create_point(-5, -1, 4), inverse(sunray::create_vector(1, 0, 0)), inf));
+    CHECK(box.intersects(sunray::create_point(7, 6, 5), inverse(sunray::create_vector(0, -1, 0)), inf));
+    CHECK(box.intersects(sunray::create_point(9, 0, 9), inverse(sunray::create_vector(0, 0, -1)), inf));
+    CHECK(box.intersects(sunray::create_point(8, 2, 12), inverse(sunray::create_vector(0, 0, -1)), inf));
+    CHECK(box.intersects(sunray::create_point(8, 1, 3.5), inverse(sunray::create_vector(0, 0, 1)), inf));
+  }
+  SECTION("ray misses bounding box")
+  {
+    CHECK_FALSE(box.intersects(sunray::create_point(9, -1, -8), inverse(sunray::create_vector(2, 4, 6).normalize()), inf));
+    CHECK_FALSE(box.intersects(sunray::create_point(8, 3, -4), inverse(sunray::create_vector(6, 2, 4).normalize()), inf));
+    CHECK_FALSE(box.intersects(sunray::create_point(12, 5, 4), inverse(sunray::create_vector(-1, 0, 0)), inf));
+    CHECK_FALSE(box.intersects(sunray::create_point(15, 1, 2), inverse(sunray::create_vector(1, 0, 0)), inf));
+  }
+  SECTION("ray hits bounding box beyond maximum distance")
+  {
+    CHECK_FALSE(box.intersects(sunray::create_point(15, 1, 2), inverse(sunray::create_vector(-1, 0, 0)), 3));
+    CHECK(box.intersects(sunray::create_point(15, 1, 2), inverse(sunray::create_vector(-1, 0, 0)), 5));
+  }
+}
+
+TEST_CASE("object bounds", "[bounding_box]")
+{
+  SECTION("sphere bounds")
+  {
+    auto sphere = sunray::Sphere::make_sphere(sunray::Matrix44::translation(1, 2, 3));
+    CHECK(sphere->bounds() == sunray::BoundingBox{sunray::create_point(0, 1, 2), sunray::create_point(2, 3, 4)});
+  }
+  SECTION("cube bounds")
+  {
+    auto cube = sunray::Cube::make_cube(sunray::Matrix44::scaling(2, 3, 4));
+    CHECK(cube->bounds() == sunray::BoundingBox{sunray::create_point(-2, -3, -4), sunray::create_point(2, 3, 4)});
+  }
+  SECTION("plane bounds")
+  {
+    auto plane = sunray::Plane::make_plane();
+    CHECK_FALSE(plane->bounds().is_bounded());
+  }
+  SECTION("disk bounds")
+  {
+    auto disk = sunray::Disk::make_disk(sunray::Matrix44::scaling(2, 1, 2), 0.5);
+    CHECK(disk->bounds() == sunray::BoundingBox{sunray::create_point(-2, 0, -2), sunray::create_point(2, 0, 2)});
+  }
+  SECTION("cylinder bounds")
+  {
+    auto cylinder = sunray::Cylinder::make_cylinder(3, -5, false);
+    CHECK(cylinder->bounds() == sunray::BoundingBox{sunray::create_point(-1, -5, -1), sunray::create_point(1, 3, 1)});
+    CHECK_FALSE(sunray::Cylinder::make_cylinder()->bounds().is_bounded());
+  }
+  SECTION("cone bounds")
+  {
+    auto cone = sunray::Cone::make_cone(3, -5, false);
+    CHECK(cone->bounds() == sunray::BoundingBox{sunray::create_point(-5, -5, -5), sunray::create_point(5, 3, 5)});
+    CHECK_FALSE(sunray::Cone::make_cone()->bounds().is_bounded());
+  }
+  SECTION("triangle bounds")
+  {
+    auto triangle = sunray::Triangle::make_triangle(sunray::create_point(-3, 7, 2), sunray::create_point(6, 2, -4),
+                                                    sunray::create_point(2, -1, -1));
+    CHECK(triangle->bounds() == sunray::BoundingBox{sunray::create_point(-3, -1, -4), sunray::create_point(6, 7, 2)});
+  }
+}
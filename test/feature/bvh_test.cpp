@@ -0,0 +1,142 @@
+//
+//  bvh_test.cpp
+//  sun_ray_test
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#include <sun_ray/feature/bvh.h>
+
+#include <algorithm>
+#include <set>
+
+#include <catch2/catch.hpp>
+
+
+namespace
+{
+  std::vector<sunray::BoundingBox> create_boxes(uint32_t count)
+  {
+    // a row of unit boxes along the x axis with a gap of one unit in between
+    std::vector<sunray::BoundingBox> boxes;
+    for (uint32_t n = 0; n < count; ++n) {
+      boxes.emplace_back(sunray::create_point(2.0 * n, 0, 0), sunray::create_point(2.0 * n + 1, 1, 1));
+    }
+    return boxes;
+  }
+
+  std::set<uint32_t> visited(const sunray::Bvh& bvh, const sunray::Ray& ray)
+  {
+    std::set<uint32_t> indices;
+    bvh.traverse(ray, [&indices](uint32_t index) {
+      indices.insert(index);
+    });
+    return indices;
+  }
+}
+
+
+TEST_CASE("create bvh", "[bvh]")
+{
+  SECTION("create empty bvh")
+  {
+    sunray::Bvh bvh{{}};
+    CHECK(bvh.empty());
+    CHECK(bvh.size() == 0);
+    CHECK(bvh.node_count() == 0);
+    CHECK(bvh.bounds().is_empty());
+    CHECK(visited(bvh, sunray::Ray{sunray::create_point(0, 0, 0), sunray::create_vector(1, 0, 0)}).empty());
+  }
+  SECTION("create bvh with a single leaf")
+  {
+    sunray::Bvh bvh{create_boxes(3)};
+    CHECK_FALSE(bvh.empty());
+    CHECK(bvh.size() == 3);
+    CHECK(bvh.node_count() == 1);
+    CHECK(bvh.bounds() == sunray::BoundingBox{sunray::create_point(0, 0, 0), sunray::create_point(5, 1, 1)});
+  }
+  SECTION("create bvh with inner nodes")
+  {
+    sunray::Bvh bvh{create_boxes(100)};
+    CHECK(bvh.size() == 100);
+    CHECK(bvh.node_count() > 1);
+    CHECK(bvh.bounds() == sunray::BoundingBox{sunray::create_point(0, 0, 0), sunray::create_point(199, 1, 1)});
+  }
+  SECTION("create bvh with identical boxes")
+  {
+    std::vector<sunray::BoundingBox> boxes(50, sunray::BoundingBox{sunray::create_point(0, 0, 0), sunray::create_point(1, 1, 1)});
+    sunray::Bvh bvh{boxes};
+    CHECK(bvh.node_count() == 1);
+    CHECK(visited(bvh, sunray::Ray{sunray::create_point(0.5, 0.5, -5), sunray::create_vector(0, 0, 1)}).size() == 50);
+  }
+}
+
+TEST_CASE("traverse bvh", "[bvh]")
+{
+  sunray::Bvh bvh{create_boxes(100), 1};
+
+  SECTION("ray hits a single box")
+  {
+    auto indices = visited(bvh, sunray::Ray{sunray::create_point(20.5, 0.5, -5), sunray::create_vector(0, 0, 1)});
+    CHECK(indices == std::set<uint32_t>{10});
+  }
+  SECTION("ray misses all boxes")
+  {
+    CHECK(visited(bvh, sunray::Ray{sunray::create_point(21.5, 0.5, -5), sunray::create_vector(0, 0, 1)}).empty());
+    CHECK(visited(bvh, sunray::Ray{sunray::create_point(20.5, 5, -5), sunray::create_vector(0, 0, 1)}).empty());
+  }
+  SECTION("ray along all boxes")
+  {
+    auto indices = visited(bvh, sunray::Ray{sunray::create_point(-5, 0.5, 0.5), sunray::create_vector(1, 0, 0)});
+    CHECK(indices.size() == 100);
+  }
+  SECTION("ray starts between the boxes")
+  {
+    auto indices = visited(bvh, sunray::Ray{sunray::create_point(101.5, 0.5, 0.5), sunray::create_vector(-1, 0, 0)});
+    CHECK(indices.size() == 51);
+    CHECK(*indices.begin() == 0);
+    CHECK(*indices.rbegin() == 50);
+  }
+  SECTION("boxes are visited front to back")
+  {
+    std::vector<uint32_t> order;
+    bvh.traverse(sunray::Ray{sunray::create_point(300, 0.5, 0.5), sunray::create_vector(-1, 0, 0)}, [&order](uint32_t index) {
+      order.push_back(index);
+    });
+    REQUIRE(order.size() == 100);
+    CHECK(std::is_sorted(order.rbegin(), order.rend()));
+  }
+}
+
+TEST_CASE("any hit in bvh", "[bvh]")
+{
+  sunray::Bvh bvh{create_boxes(100), 1};
+  sunray::Ray ray{sunray::create_point(-5, 0.5, 0.5), sunray::create_vector(1, 0, 0)};
+
+  SECTION("stops at the first accepted primitive")
+  {
+    std::vector<uint32_t> order;
+    CHECK(bvh.any_of(ray, std::numeric_limits<double>::infinity(), [&order](uint32_t index) {
+      order.push_back(index);
+      return index == 3;
+    }));
+    CHECK(order == std::vector<uint32_t>{0, 1, 2, 3});
+  }
+  SECTION("boxes beyond max_t are skipped")
+  {
+    std::set<uint32_t> indices;
+    CHECK_FALSE(bvh.any_of(ray, 10.0, [&indices](uint32_t index) {
+      indices.insert(index);
+      return false;
+    }));
+    CHECK(indices == std::set<uint32_t>{0, 1, 2});
+  }
+  SECTION("empty hierarchy")
+  {
+    sunray::Bvh empty;
+    CHECK_FALSE(empty.any_of(ray, 10.0, [](uint32_t) {
+      return true;
+    }));
+  }
+}
@@ -10,6 +10,7 @@
 #include <sun_ray/feature/sphere.h>
 #include <sun_ray/feature/transformation.h>
 
+#include <cstring>
 #include <sstream>
 
 #include <catch2/catch.hpp>
@@ -43,10 +44,10 @@ TEST_CASE("stream camera", "[camera]")
     std::stringstream ss;
     ss << c;
     // clang-format off
-    const std::string expect = R"(horizontal: 160 vertical: 140 field of view: 1.5708 transformation: | 1 | 0 | -0 | 0 |
-| -0 | 1 | -0 | 0 |
-| 0 | -0 | 1 | -0 |
-| 0 | 0 | -0 | 1 |
+    const std::string expect = R"(horizontal: 160 vertical: 140 field of view: 1.5708 transformation: | 1 | 0 | 0 | 0 |
+| 0 | 1 | 0 | 0 |
+| 0 | 0 | 1 | 0 |
+| 0 | 0 | 0 | 1 |
 )";
     // clang-format on
     CHECK(expect == ss.str());
@@ -121,4 +122,330 @@ TEST_CASE("render world", "[camera]")
     auto canvas = c.render(world);
     CHECK(canvas.pixel_at(5, 5) == sunray::Color{0.38066f, 0.47583f, 0.2855f});
   }
+  SECTION("render statistics")
+  {
+    sunray::RenderContext context;
+    context.number_of_threads_ = 2;
+    world.context(context);
+    sunray::RenderStatistics statistics;
+    auto canvas = c.render(world, statistics);
+    CHECK(canvas.pixel_at(5, 5) == sunray::Color{0.38066f, 0.47583f, 0.2855f});
+    CHECK(statistics.shadow_rays_ > 0);
+    CHECK(statistics.shadow_cache_hits_ <= statistics.shadow_rays_);
+  }
+  SECTION("render with a shared thread pool")
+  {
+    sunray::ThreadPool pool{3};
+    auto first = c.render(world, pool);
+    auto second = c.render(world, pool);
+    CHECK(first.pixel_at(5, 5) == sunray::Color{0.38066f, 0.47583f, 0.2855f});
+    CHECK(second.pixel_at(5, 5) == first.pixel_at(5, 5));
+  }
+  SECTION("render without threads and small tiles")
+  {
+    sunray::RenderContext context;
+    context.number_of_threads_ = 0;
+    context.tile_size_ = 3;
+    world.context(context);
+    auto canvas = c.render(world);
+    CHECK(canvas.pixel_at(5, 5) == sunray::Color{0.38066f, 0.47583f, 0.2855f});
+    // The last column and row are rendered, too
+    CHECK(canvas.pixel_at(10, 5) == canvas.pixel_at(0, 5));
+    CHECK(canvas.pixel_at(5, 10) == canvas.pixel_at(5, 0));
+  }
+  SECTION("render region")
+  {
+    sunray::RenderContext context;
+    context.tile_size_ = 2;
+    context.samples_per_pixel_ = 4;
+    world.context(context);
+    sunray::ThreadPool pool{3};
+    const auto full = c.render(world, pool);
+
+    const sunray::Tile region{3, 4, 5, 6};
+    sunray::RenderStatistics statistics;
+    const auto canvas = c.render(world, region, statistics, pool);
+    REQUIRE(canvas.width() == 5);
+    REQUIRE(canvas.height() == 6);
+    CHECK(statistics.samples_ == 5 * 6 * 4);
+    for (uint32_t y = 0; y < canvas.height(); ++y) {
+      for (uint32_t x = 0; x < canvas.width(); ++x) {
+        const auto expected = full.pixel_at(region.x_ + x, region.y_ + y);
+        const auto actual = canvas.pixel_at(x, y);
+        CHECK(std::memcmp(static_cast<const float*>(actual), static_cast<const float*>(expected), 3 * sizeof(float)) == 0);
+      }
+    }
+  }
+  SECTION("render region on the calling thread")
+  {
+    sunray::ThreadPool pool{3};
+    const sunray::Tile region{2, 1, 7, 8};
+    sunray::RenderStatistics pool_statistics;
+    const auto expected = c.render(world, region, pool_statistics, pool);
+    sunray::RenderStatistics statistics;
+    const auto canvas = c.render(world, region, statistics);
+    REQUIRE(canvas.width() == 7);
+    REQUIRE(canvas.height() == 8);
+    CHECK(statistics.samples_ == pool_statistics.samples_);
+    for (uint32_t y = 0; y < canvas.height(); ++y) {
+      for (uint32_t x = 0; x < canvas.width(); ++x) {
+        const auto actual = canvas.pixel_at(x, y);
+        const auto wanted = expected.pixel_at(x, y);
+        CHECK(std::memcmp(static_cast<const float*>(actual), static_cast<const float*>(wanted), 3 * sizeof(float)) == 0);
+      }
+    }
+  }
+  SECTION("render with progress")
+  {
+    sunray::RenderContext context;
+    context.tile_size_ = 3;
+    world.context(context);
+    sunray::ThreadPool pool{3};
+    sunray::RenderProgress progress;
+    sunray::RenderStatistics statistics;
+    const auto canvas = c.render(world, statistics, pool, &progress);
+    CHECK(canvas.pixel_at(5, 5) == sunray::Color{0.38066f, 0.47583f, 0.2855f});
+    CHECK(progress.tiles_total() == 16);
+    CHECK(progress.tiles_done() == 16);
+    CHECK(progress.samples() == statistics.samples_);
+    CHECK(progress.fraction() == Approx(1.0));
+  }
+  SECTION("cancelled render returns the canvas")
+  {
+    sunray::ThreadPool pool{3};
+    sunray::RenderProgress progress;
+    progress.cancel();
+    sunray::RenderStatistics statistics;
+    const auto canvas = c.render(world, statistics, pool, &progress);
+    REQUIRE(canvas.width() == 11);
+    REQUIRE(canvas.height() == 11);
+    CHECK(canvas.pixel_at(5, 5) == sunray::Color{0, 0, 0});
+    CHECK(statistics.samples_ == 0);
+    CHECK(progress.tiles_done() == 0);
+    CHECK(progress.tiles_total() > 0);
+  }
+  SECTION("render region outside of the image")
+  {
+    sunray::ThreadPool pool{1};
+    sunray::RenderStatistics statistics;
+    CHECK_THROWS_AS(c.render(world, sunray::Tile{8, 0, 4, 4}, statistics, pool), std::out_of_range);
+    CHECK_THROWS_AS(c.render(world, sunray::Tile{0, 0, 0, 4}, statistics, pool), std::out_of_range);
+    CHECK_THROWS_AS(c.render(world, sunray::Tile{0, 9, 4, 4}, statistics), std::out_of_range);
+  }
+}
+
+TEST_CASE("adaptive anti aliasing", "[camera]")
+{
+  sunray::World world;
+  world.add_light(std::make_shared<sunray::PointLight>(sunray::create_point(-10, 10, -10), sunray::Color(1, 1, 1)));
+
+  auto from = sunray::create_point(0, 0, -5);
+  auto to = sunray::create_point(0, 0, 0);
+  auto up = sunray::create_vector(0, 1, 0);
+  sunray::Camera c{21, 21, sunray::PI / 6, sunray::view_transformation(from, to, up)};
+  sunray::ThreadPool pool{2};
+  const auto pixels = uint64_t{21 * 21};
+  sunray::RenderContext context;
+  context.anti_aliasing_ = true;
+  world.context(context);
+
+  SECTION("uniform image is not supersampled")
+  {
+    sunray::RenderStatistics statistics;
+    c.render(world, statistics, pool);
+    CHECK(statistics.samples_ == pixels);
+    CHECK(statistics.passes_ == 2);
+  }
+  SECTION("edges are supersampled")
+  {
+    world.add_object(
+      sunray::Sphere::make_sphere(sunray::Material{sunray::Color{0.8f, 1, 0.6f}, 0.1f, 0.7f, 0.2f, 200.0f, 0.0f, 0.0f, 1.0f}));
+    sunray::RenderStatistics statistics;
+    auto canvas = c.render(world, statistics, pool);
+    CHECK(statistics.samples_ > pixels);
+    CHECK(statistics.samples_ < 4 * pixels);
+    CHECK(canvas.pixel_at(0, 0) == sunray::Color(0, 0, 0));
+
+    context.anti_aliasing_ = false;
+    world.context(context);
+    sunray::RenderStatistics single_statistics;
+    auto aliased = c.render(world, single_statistics, pool);
+    CHECK(single_statistics.samples_ == pixels);
+    CHECK(canvas.pixel_at(10, 10) == aliased.pixel_at(10, 10));
+
+    // The pixels on the silhouette blend the sphere with the background
+    CHECK(canvas.pixel_at(3, 10) != aliased.pixel_at(3, 10));
+    CHECK(canvas.pixel_at(2, 10) != aliased.pixel_at(2, 10));
+  }
+  SECTION("anti aliasing stops at the deadline")
+  {
+    world.add_object(
+      sunray::Sphere::make_sphere(sunray::Material{sunray::Color{0.8f, 1, 0.6f}, 0.1f, 0.7f, 0.2f, 200.0f, 0.0f, 0.0f, 1.0f}));
+    sunray::RenderStatistics statistics;
+    const auto canvas = c.render(world, statistics, pool, nullptr, std::chrono::steady_clock::now());
+    CHECK(statistics.samples_ == pixels);
+
+    context.anti_aliasing_ = false;
+    world.context(context);
+    sunray::RenderStatistics single_statistics;
+    const auto aliased = c.render(world, single_statistics, pool);
+    for (uint32_t y = 0; y < 21; ++y) {
+      for (uint32_t x = 0; x < 21; ++x) {
+        CHECK(canvas.pixel_at(x, y) == aliased.pixel_at(x, y));
+      }
+    }
+  }
+}
+
+TEST_CASE("multiple samples per pixel", "[camera]")
+{
+  sunray::World world;
+  world.add_light(std::make_shared<sunray::PointLight>(sunray::create_point(-10, 10, -10), sunray::Color(1, 1, 1)));
+  world.add_object(
+    sunray::Sphere::make_sphere(sunray::Material{sunray::Color{0.8f, 1, 0.6f}, 0.1f, 0.7f, 0.2f, 200.0f, 0.0f, 0.0f, 1.0f}));
+
+  auto from = sunray::create_point(0, 0, -5);
+  auto to = sunray::create_point(0, 0, 0);
+  auto up = sunray::create_vector(0, 1, 0);
+  sunray::Camera c{23, 17, sunray::PI / 6, sunray::view_transformation(from, to, up)};
+
+  const auto identical = [](const sunray::Canvas& lhs, const sunray::Canvas& rhs) {
+    for (uint32_t y = 0; y < lhs.height(); ++y) {
+      for (uint32_t x = 0; x < lhs.width(); ++x) {
+        const auto left = lhs.pixel_at(x, y);
+        const auto right = rhs.pixel_at(x, y);
+        if (std::memcmp(static_cast<const float*>(left), static_cast<const float*>(right), 3 * sizeof(float)) != 0) {
+          return false;
+        }
+      }
+    }
+    return true;
+  };
+
+  for (auto filter : {sunray::ReconstructionFilter::BOX, sunray::ReconstructionFilter::GAUSSIAN}) {
+    sunray::RenderContext context;
+    context.samples_per_pixel_ = 9;
+    context.filter_ = filter;
+    context.tile_size_ = 16;
+    world.context(context);
+    sunray::ThreadPool single{1};
+    sunray::RenderStatistics statistics;
+    auto reference = c.render(world, statistics, single);
+    CHECK(statistics.samples_ == 9 * 23 * 17);
+
+    // Neither the number of threads nor the order of the tiles changes a single bit
+    context.tile_size_ = 3;
+    world.context(context);
+    sunray::ThreadPool pool{5};
+    auto parallel = c.render(world, pool);
+    CHECK(identical(reference, parallel));
+
+    // The interior of the sphere is smooth, the silhouette is blended
+    context.samples_per_pixel_ = 1;
+    world.context(context);
+    auto single_sample = c.render(world, pool);
+    CHECK(reference.pixel_at(11, 8).green() == Approx(single_sample.pixel_at(11, 8).green()).epsilon(0.05));
+    CHECK_FALSE(identical(reference, single_sample));
+  }
+}
+
+TEST_CASE("progressive rendering", "[camera]")
+{
+  sunray::World world;
+  world.add_light(std::make_shared<sunray::PointLight>(sunray::create_point(-10, 10, -10), sunray::Color(1, 1, 1)));
+  world.add_object(
+    sunray::Sphere::make_sphere(sunray::Material{sunray::Color{0.8f, 1, 0.6f}, 0.1f, 0.7f, 0.2f, 200.0f, 0.0f, 0.0f, 1.0f}));
+
+  auto from = sunray::create_point(0, 0, -5);
+  auto to = sunray::create_point(0, 0, 0);
+  auto up = sunray::create_vector(0, 1, 0);
+  sunray::Camera c{21, 13, sunray::PI2, sunray::view_transformation(from, to, up)};
+  sunray::ThreadPool pool{3};
+  const auto pixels = uint64_t{21 * 13};
+
+  SECTION("single sample equals render")
+  {
+    sunray::ProgressiveSettings settings;
+    settings.max_samples_ = 1;
+    settings.snapshot_interval_ = std::chrono::milliseconds{0};
+    std::vector<uint32_t> passes;
+    sunray::RenderStatistics statistics;
+    const auto snapshot = [&passes](const sunray::Canvas& image, uint32_t pass) {
+      CHECK(image.width() == 21);
+      passes.push_back(pass);
+    };
+    auto canvas = c.render_progressive(world, settings, pool, statistics, snapshot);
+    auto expected = c.render(world, pool);
+    for (uint32_t y = 0; y < 13; ++y) {
+      for (uint32_t x = 0; x < 21; ++x) {
+        CHECK(canvas.pixel_at(x, y) == expected.pixel_at(x, y));
+      }
+    }
+    CHECK(statistics.samples_ == pixels);
+    CHECK(statistics.passes_ == 5);
+    CHECK(passes == std::vector<uint32_t>{0, 1, 2, 3, 4});
+  }
+  SECTION("several samples per pixel equal render")
+  {
+    auto context = world.context();
+    context.samples_per_pixel_ = 3;
+    context.filter_ = sunray::ReconstructionFilter::GAUSSIAN;
+    world.context(context);
+    sunray::ProgressiveSettings settings;
+    settings.max_samples_ = 3;
+    settings.noise_threshold_ = 0.0;
+    sunray::RenderStatistics statistics;
+    auto canvas = c.render_progressive(world, settings, pool, statistics);
+    auto expected = c.render(world, pool);
+    for (uint32_t y = 0; y < 13; ++y) {
+      for (uint32_t x = 0; x < 21; ++x) {
+        CHECK(std::memcmp(static_cast<const float*>(canvas.pixel_at(x, y)), static_cast<const float*>(expected.pixel_at(x, y)),
+                          3 * sizeof(float)) == 0);
+      }
+    }
+    CHECK(statistics.samples_ == 3 * pixels);
+  }
+  SECTION("samples up to the maximum")
+  {
+    sunray::ProgressiveSettings settings;
+    settings.max_samples_ = 6;
+    settings.noise_threshold_ = 0.0;
+    sunray::RenderStatistics statistics;
+    c.render_progressive(world, settings, pool, statistics);
+    CHECK(statistics.samples_ == 6 * pixels);
+  }
+  SECTION("converged pixels stop sampling")
+  {
+    sunray::ProgressiveSettings settings;
+    settings.min_samples_ = 2;
+    settings.noise_threshold_ = 1.0;
+    sunray::RenderStatistics statistics;
+    c.render_progressive(world, settings, pool, statistics);
+    CHECK(statistics.samples_ == 2 * pixels);
+  }
+  SECTION("cancelled progressive render")
+  {
+    sunray::ProgressiveSettings settings;
+    settings.max_samples_ = 1000000;
+    settings.noise_threshold_ = 0.0;
+    sunray::RenderProgress progress;
+    progress.cancel();
+    sunray::RenderStatistics statistics;
+    auto canvas = c.render_progressive(world, settings, pool, statistics, {}, &progress);
+    CHECK(statistics.samples_ == 0);
+    CHECK(statistics.passes_ == 1);
+    CHECK(canvas.width() == 21);
+  }
+  SECTION("time budget")
+  {
+    sunray::ProgressiveSettings settings;
+    settings.max_samples_ = 1000000;
+    settings.noise_threshold_ = 0.0;
+    settings.time_budget_ = std::chrono::milliseconds{20};
+    sunray::RenderStatistics statistics;
+    auto canvas = c.render_progressive(world, settings, pool, statistics);
+    CHECK(statistics.samples_ >= 3 * 2);
+    CHECK(statistics.samples_ < 1000000 * pixels);
+    CHECK(canvas.width() == 21);
+  }
 }
@@ -155,3 +155,64 @@ TEST_CASE("canvas pixels", "[canvas]")
     }
   }
 }
+
+TEST_CASE("paste canvas", "[canvas]")
+{
+  sunray::Canvas canvas{10, 20};
+  sunray::Canvas patch{3, 2};
+  const auto red = sunray::Color{1.0f, 0, 0};
+  for (uint32_t y = 0; y < patch.height(); ++y) {
+    for (uint32_t x = 0; x < patch.width(); ++x) {
+      patch.pixel_at(x, y, red);
+    }
+  }
+
+  SECTION("paste")
+  {
+    canvas.paste(patch, 7, 18);
+    for (uint32_t y = 0; y < 20; ++y) {
+      for (uint32_t x = 0; x < 10; ++x) {
+        const auto inside = x >= 7 && y >= 18;
+        CHECK(canvas.pixel_at(x, y) == (inside ? red : sunray::Color{0, 0, 0}));
+      }
+    }
+  }
+  SECTION("paste out of range")
+  {
+    CHECK_THROWS_AS(canvas.paste(patch, 8, 0), std::out_of_range);
+    CHECK_THROWS_AS(canvas.paste(patch, 0, 19), std::out_of_range);
+  }
+}
+
+TEST_CASE("difference of canvases", "[canvas]")
+{
+  sunray::Canvas lhs{4, 2};
+  sunray::Canvas rhs{4, 2};
+
+  SECTION("same canvases")
+  {
+    const auto diff = sunray::difference(lhs, rhs);
+    CHECK(diff.maximum_ == Approx(0.0f));
+    CHECK(diff.mean_ == Approx(0.0));
+    CHECK(diff.pixels_ == 0);
+  }
+  SECTION("different pixels")
+  {
+    lhs.pixel_at(0, 0, sunray::Color{0.5f, 0, 0});
+    lhs.pixel_at(3, 1, sunray::Color{0, 0, 0.002f});
+    const auto diff = sunray::difference(lhs, rhs);
+    CHECK(diff.maximum_ == Approx(0.5f));
+    CHECK(diff.mean_ == Approx(0.502 / 24.0));
+    CHECK(diff.pixels_ == 1);
+  }
+  SECTION("channels are clamped")
+  {
+    lhs.pixel_at(1, 1, sunray::Color{3.0f, 1.0f, 1.0f});
+    rhs.pixel_at(1, 1, sunray::Color{1.0f, 1.0f, 1.0f});
+    CHECK(sunray::difference(lhs, rhs).pixels_ == 0);
+  }
+  SECTION("different sizes")
+  {
+    CHECK_THROWS_AS(sunray::difference(lhs, sunray::Canvas{2, 4}), std::invalid_argument);
+  }
+}
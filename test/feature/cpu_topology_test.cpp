@@ -0,0 +1,137 @@
+//
+//  cpu_topology_test.cpp
+//  sun_ray_test
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#include <sun_ray/feature/cpu_topology.h>
+
+#include "../temporary_directory.h"
+
+#include <catch2/catch.hpp>
+
+
+namespace
+{
+  void write_file(const std::filesystem::path& path, const std::string& content)
+  {
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream file{path.string()};
+    file << content << "\n";
+  }
+
+  std::vector<uint32_t> ids(const std::vector<sunray::Cpu>& cpus)
+  {
+    std::vector<uint32_t> result;
+    for (const auto& cpu : cpus) {
+      result.push_back(cpu.id_);
+    }
+    return result;
+  }
+
+  // Two nodes with two cores each, the second hardware threads of the cores are numbered after the first ones
+  sunray::CpuTopology two_nodes()
+  {
+    return sunray::CpuTopology{{sunray::Cpu{0, 0, 0, 0}, sunray::Cpu{1, 0, 0, 1}, sunray::Cpu{2, 1, 1, 0},
+                                sunray::Cpu{3, 1, 1, 1}, sunray::Cpu{4, 0, 0, 0}, sunray::Cpu{5, 0, 0, 1},
+                                sunray::Cpu{6, 1, 1, 0}, sunray::Cpu{7, 1, 1, 1}}};
+  }
+}
+
+
+TEST_CASE("cpu list", "[cpu topology]")
+{
+  CHECK(sunray::CpuTopology::parse_cpu_list("").empty());
+  CHECK(sunray::CpuTopology::parse_cpu_list("3") == std::vector<uint32_t>{3});
+  CHECK(sunray::CpuTopology::parse_cpu_list("0-3,8,10-11") == std::vector<uint32_t>{0, 1, 2, 3, 8, 10, 11});
+  CHECK_THROWS_AS(sunray::CpuTopology::parse_cpu_list("0-x"), std::invalid_argument);
+}
+
+TEST_CASE("affinity policy names", "[cpu topology]")
+{
+  CHECK(sunray::affinity_policy("none") == sunray::AffinityPolicy::none);
+  CHECK(sunray::affinity_policy("compact") == sunray::AffinityPolicy::compact);
+  CHECK(sunray::affinity_policy("scatter") == sunray::AffinityPolicy::scatter);
+  CHECK_THROWS_AS(sunray::affinity_policy("spread"), std::invalid_argument);
+}
+
+TEST_CASE("read cpu topology", "[cpu topology]")
+{
+  TemporaryDirectoryGuard guard;
+  const auto root = guard.temporary_directory_path();
+
+  SECTION("nodes, packages and cores")
+  {
+    write_file(root / "cpu" / "online", "0-3");
+    for (uint32_t id = 0; id < 4; ++id) {
+      const auto topology = root / "cpu" / ("cpu" + std::to_string(id)) / "topology";
+      write_file(topology / "physical_package_id", std::to_string(id / 2));
+      write_file(topology / "core_id", std::to_string(id % 2));
+    }
+    write_file(root / "node" / "node0" / "cpulist", "0-1");
+    write_file(root / "node" / "node1" / "cpulist", "2-3");
+    write_file(root / "node" / "possible", "0-1");
+
+    const auto topology = sunray::CpuTopology::read(root);
+    REQUIRE(topology.cpus().size() == 4);
+    CHECK(topology.nodes() == std::vector<uint32_t>{0, 1});
+    CHECK(topology.cpus()[3].id_ == 3);
+    CHECK(topology.cpus()[3].node_ == 1);
+    CHECK(topology.cpus()[3].package_ == 1);
+    CHECK(topology.cpus()[3].core_ == 1);
+  }
+  SECTION("missing topology")
+  {
+    write_file(root / "cpu" / "online", "0,2");
+    const auto topology = sunray::CpuTopology::read(root);
+    REQUIRE(topology.cpus().size() == 2);
+    CHECK(topology.nodes() == std::vector<uint32_t>{0});
+    CHECK(topology.cpus()[1].id_ == 2);
+    CHECK(topology.cpus()[1].core_ == 2);
+  }
+  SECTION("missing sysfs")
+  {
+    CHECK_FALSE(sunray::CpuTopology::read(root / "unknown").cpus().empty());
+  }
+}
+
+TEST_CASE("cpu placement", "[cpu topology]")
+{
+  const auto topology = two_nodes();
+
+  SECTION("no affinity")
+  {
+    CHECK(topology.placement(sunray::AffinityPolicy::none, 4).empty());
+  }
+  SECTION("compact")
+  {
+    CHECK(ids(topology.placement(sunray::AffinityPolicy::compact, 8)) == std::vector<uint32_t>{0, 4, 1, 5, 2, 6, 3, 7});
+  }
+  SECTION("scatter")
+  {
+    CHECK(ids(topology.placement(sunray::AffinityPolicy::scatter, 8)) == std::vector<uint32_t>{0, 2, 1, 3, 4, 6, 5, 7});
+  }
+  SECTION("more workers than hardware threads")
+  {
+    CHECK(ids(topology.placement(sunray::AffinityPolicy::scatter, 10)) ==
+          std::vector<uint32_t>{0, 2, 1, 3, 4, 6, 5, 7, 0, 2});
+  }
+  SECTION("single node")
+  {
+    const auto placement = topology.placement(sunray::AffinityPolicy::scatter, 3, 1);
+    CHECK(ids(placement) == std::vector<uint32_t>{2, 3, 6});
+    CHECK(placement[0].node_ == 1);
+  }
+  SECTION("unknown node uses all nodes")
+  {
+    CHECK(topology.placement(sunray::AffinityPolicy::compact, 8, 5).size() == 8);
+  }
+  SECTION("detected topology")
+  {
+    const auto detected = sunray::CpuTopology::detect();
+    CHECK_FALSE(detected.cpus().empty());
+    CHECK(detected.placement(sunray::AffinityPolicy::compact, 3).size() == 3);
+  }
+}
@@ -0,0 +1,204 @@
+//
+//  deadline_renderer_test.cpp
+//  sun_ray_test
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#include <sun_ray/feature/deadline_renderer.h>
+#include <sun_ray/feature/sphere.h>
+#include <sun_ray/feature/transformation.h>
+
+#include <chrono>
+#include <cstring>
+
+#include <catch2/catch.hpp>
+
+
+TEST_CASE("deadline quality levels", "[deadline renderer]")
+{
+  SECTION("levels of the default context")
+  {
+    const auto levels = sunray::DeadlineRenderer::levels(sunray::RenderContext{});
+    REQUIRE(levels.size() == 6);
+    CHECK(levels[0].to_string() == "samples: 1 depth: 5 shadows: on anti aliasing: off scale: 1/1");
+    CHECK(levels[1].to_string() == "samples: 1 depth: 2 shadows: on anti aliasing: off scale: 1/1");
+    CHECK(levels[2].to_string() == "samples: 1 depth: 1 shadows: on anti aliasing: off scale: 1/1");
+    CHECK(levels[3].to_string() == "samples: 1 depth: 1 shadows: off anti aliasing: off scale: 1/1");
+    CHECK(levels[4].to_string() == "samples: 1 depth: 1 shadows: off anti aliasing: off scale: 1/2");
+    CHECK(levels[5].to_string() == "samples: 1 depth: 1 shadows: off anti aliasing: off scale: 1/4");
+  }
+  SECTION("levels start with the settings of the context")
+  {
+    sunray::RenderContext context;
+    context.samples_per_pixel_ = 8;
+    context.maximum_depth_ = 1;
+    context.shadows_ = false;
+    const auto levels = sunray::DeadlineRenderer::levels(context);
+    REQUIRE(levels.size() == 4);
+    CHECK(levels[0].to_string() == "samples: 8 depth: 1 shadows: off anti aliasing: off scale: 1/1");
+    CHECK(levels[1].to_string() == "samples: 1 depth: 1 shadows: off anti aliasing: off scale: 1/1");
+    CHECK(levels[2].scale_ == 2);
+    CHECK(levels[3].scale_ == 4);
+  }
+  SECTION("anti aliasing is dropped before the depth")
+  {
+    sunray::RenderContext context;
+    context.anti_aliasing_ = true;
+    const auto levels = sunray::DeadlineRenderer::levels(context);
+    REQUIRE(levels.size() >= 2);
+    CHECK(levels[0].anti_aliasing_);
+    CHECK_FALSE(levels[1].anti_aliasing_);
+    CHECK(levels[1].maximum_depth_ == 5);
+  }
+}
+
+TEST_CASE("choose quality level", "[deadline renderer]")
+{
+  sunray::RenderContext context;
+  context.samples_per_pixel_ = 4;
+  const auto levels = sunray::DeadlineRenderer::levels(context);
+  const auto cost = [](const sunray::QualityLevel& level) {
+    return level.samples_per_pixel_ * (level.shadows_ ? 2.0 : 1.0) / (level.scale_ * level.scale_);
+  };
+
+  SECTION("best level fitting into the time")
+  {
+    const auto level = sunray::DeadlineRenderer::choose(levels, [&cost](const sunray::QualityLevel& candidate) {
+      return std::make_pair(cost(candidate), 2.0);
+    });
+    CHECK(level.to_string() == "samples: 1 depth: 1 shadows: off anti aliasing: off scale: 1/1");
+  }
+  SECTION("plenty of time")
+  {
+    const auto level = sunray::DeadlineRenderer::choose(levels, [&cost](const sunray::QualityLevel& candidate) {
+      return std::make_pair(cost(candidate), 100.0);
+    });
+    CHECK(level.to_string() == levels.front().to_string());
+  }
+  SECTION("time is up")
+  {
+    const auto level = sunray::DeadlineRenderer::choose(levels, [&cost](const sunray::QualityLevel& candidate) {
+      return std::make_pair(cost(candidate), -1.0);
+    });
+    CHECK(level.to_string() == levels.back().to_string());
+  }
+}
+
+TEST_CASE("upscale canvas", "[deadline renderer]")
+{
+  sunray::Canvas canvas{2, 1};
+  canvas.pixel_at(0, 0, sunray::Color{0, 0, 0});
+  canvas.pixel_at(1, 0, sunray::Color{1, 1, 1});
+
+  const auto result = sunray::DeadlineRenderer::upscale(canvas, 4, 2);
+  REQUIRE(result.width() == 4);
+  REQUIRE(result.height() == 2);
+  CHECK(result.pixel_at(0, 0) == sunray::Color{0, 0, 0});
+  CHECK(result.pixel_at(1, 1) == sunray::Color{0.25f, 0.25f, 0.25f});
+  CHECK(result.pixel_at(2, 0) == sunray::Color{0.75f, 0.75f, 0.75f});
+  CHECK(result.pixel_at(3, 1) == sunray::Color{1, 1, 1});
+}
+
+TEST_CASE("render with deadline", "[deadline renderer]")
+{
+  sunray::World world;
+  world.add_light(std::make_shared<sunray::PointLight>(sunray::create_point(-10, 10, -10), sunray::Color(1, 1, 1)));
+  world.add_object(sunray::Sphere::make_sphere(
+    sunray::Material{sunray::Color{0.8f, 1, 0.6f}, 0.1f, 0.7f, 0.2f, 200.0f, 0.3f, 0.0f, 1.0f}));
+  world.build_hierarchy();
+
+  sunray::Camera c{32, 24, sunray::PI / 4,
+                   sunray::view_transformation(sunray::create_point(0, 0, -5), sunray::create_point(0, 0, 0),
+                                               sunray::create_vector(0, 1, 0))};
+  sunray::ThreadPool pool{2};
+  sunray::RenderContext context;
+  context.samples_per_pixel_ = 4;
+
+  SECTION("without deadline the settings of the context are used")
+  {
+    world.context(context);
+    sunray::DeadlineRenderer renderer;
+    sunray::RenderStatistics statistics;
+    const auto canvas = renderer.render(c, world, pool, statistics);
+    CHECK(renderer.quality().samples_per_pixel_ == 4);
+    CHECK(renderer.quality().scale_ == 1);
+    CHECK(canvas.width() == 32);
+    CHECK(canvas.height() == 24);
+    CHECK(statistics.samples_ == 32 * 24 * 4);
+  }
+  SECTION("generous deadline keeps the settings of the context")
+  {
+    context.deadline_ = std::chrono::milliseconds{60000};
+    world.context(context);
+    sunray::DeadlineRenderer renderer;
+    sunray::RenderStatistics statistics;
+    renderer.render(c, world, pool, statistics);
+    CHECK(renderer.quality().to_string() == sunray::DeadlineRenderer::levels(context).front().to_string());
+  }
+  SECTION("settings of the context render the image of a plain render")
+  {
+    context.filter_ = sunray::ReconstructionFilter::GAUSSIAN;
+    for (const auto deadline : {std::chrono::milliseconds{0}, std::chrono::milliseconds{60000}}) {
+      context.deadline_ = deadline;
+      world.context(context);
+      sunray::DeadlineRenderer renderer;
+      sunray::RenderStatistics statistics;
+      const auto canvas = renderer.render(c, world, pool, statistics);
+      REQUIRE(renderer.quality().samples_per_pixel_ == 4);
+      const auto expected = c.render(world, pool);
+      for (uint32_t y = 0; y < 24; ++y) {
+        for (uint32_t x = 0; x < 32; ++x) {
+          CHECK(std::memcmp(static_cast<const float*>(canvas.pixel_at(x, y)),
+                            static_cast<const float*>(expected.pixel_at(x, y)), 3 * sizeof(float)) == 0);
+        }
+      }
+    }
+  }
+  SECTION("short deadline lowers the quality and keeps the size")
+  {
+    context.deadline_ = std::chrono::milliseconds{1};
+    world.context(context);
+    sunray::DeadlineRenderer renderer;
+    sunray::RenderStatistics statistics;
+    const auto canvas = renderer.render(c, world, pool, statistics);
+    CHECK(renderer.quality().samples_per_pixel_ == 1);
+    CHECK(canvas.width() == 32);
+    CHECK(canvas.height() == 24);
+    CHECK(statistics.samples_ < 32 * 24 * 4);
+  }
+  SECTION("context of the world is restored")
+  {
+    context.deadline_ = std::chrono::milliseconds{1};
+    world.context(context);
+    sunray::DeadlineRenderer renderer;
+    sunray::RenderStatistics statistics;
+    renderer.render(c, world, pool, statistics);
+    CHECK(world.context().samples_per_pixel_ == 4);
+    CHECK(world.context().maximum_depth_ == 5);
+    CHECK(world.context().shadows_);
+    CHECK(world.context().deadline_ == std::chrono::milliseconds{1});
+  }
+  SECTION("anti aliasing costlier than estimated stops at the deadline")
+  {
+    // Every pixel is subdivided down to the depth, far more than the probe expects
+    context.samples_per_pixel_ = 1;
+    context.anti_aliasing_ = true;
+    context.anti_aliasing_threshold_ = -1.0f;
+    context.anti_aliasing_depth_ = 7;
+    context.tile_size_ = 2;
+    context.deadline_ = std::chrono::milliseconds{500};
+    world.context(context);
+    sunray::DeadlineRenderer renderer;
+    sunray::RenderStatistics statistics;
+    const auto start = std::chrono::steady_clock::now();
+    const auto canvas = renderer.render(c, world, pool, statistics);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    CHECK(renderer.quality().anti_aliasing_);
+    CHECK(canvas.width() == 32);
+    CHECK(elapsed < std::chrono::milliseconds{2000});
+    // Each pixel of the complete pass would take 4 + 16 + ... + 4^7 samples
+    CHECK(statistics.samples_ < 32 * 24 * 21845);
+  }
+}
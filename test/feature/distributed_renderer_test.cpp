@@ -0,0 +1,148 @@
+//
+//  distributed_renderer_test.cpp
+//  sun_ray_test
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#include <sun_ray/feature/distributed_renderer.h>
+#include <sun_ray/feature/sphere.h>
+#include <sun_ray/feature/transformation.h>
+
+#include <cstring>
+
+#include <catch2/catch.hpp>
+
+
+#ifndef _WIN32
+TEST_CASE("distributed rendering", "[distributed renderer]")
+{
+  sunray::World world;
+  world.add_light(std::make_shared<sunray::PointLight>(sunray::create_point(-10, 10, -10), sunray::Color(1, 1, 1)));
+  world.add_object(sunray::Sphere::make_sphere(
+    sunray::Material{sunray::Color{0.8f, 1, 0.6f}, 0.1f, 0.7f, 0.2f, 200.0f, 0.3f, 0.0f, 1.0f}));
+  world.add_object(sunray::Sphere::make_sphere(
+    sunray::Material{sunray::Color{0.2f, 0.3f, 1}, 0.1f, 0.7f, 0.2f, 200.0f, 0.0f, 0.0f, 1.0f},
+    sunray::Transformation().translate(1.5, 0.5, -1).scale(0.4, 0.4, 0.4).matrix()));
+  world.build_hierarchy();
+
+  sunray::RenderContext context;
+  context.tile_size_ = 4;
+  context.samples_per_pixel_ = 2;
+  world.context(context);
+
+  auto from = sunray::create_point(0, 0, -5);
+  auto to = sunray::create_point(0, 0, 0);
+  auto up = sunray::create_vector(0, 1, 0);
+  sunray::Camera c{23, 17, sunray::PI / 4, sunray::view_transformation(from, to, up)};
+
+  const auto identical = [](const sunray::Canvas& lhs, const sunray::Canvas& rhs) {
+    if (lhs.width() != rhs.width() || lhs.height() != rhs.height()) {
+      return false;
+    }
+    for (uint32_t y = 0; y < lhs.height(); ++y) {
+      for (uint32_t x = 0; x < lhs.width(); ++x) {
+        const auto left = lhs.pixel_at(x, y);
+        const auto right = rhs.pixel_at(x, y);
+        if (std::memcmp(static_cast<const float*>(left), static_cast<const float*>(right), 3 * sizeof(float)) != 0) {
+          return false;
+        }
+      }
+    }
+    return true;
+  };
+
+  // The workers are forked before the pool starts its threads, they know the scene and serve every render
+  const auto serve = [&c, &world](sunray::DistributedRenderer& workers) {
+    while (workers.serve(c, world)) {
+    }
+  };
+
+  SECTION("processes render the same image as a single process")
+  {
+    sunray::DistributedRenderer single{1, 1};
+    sunray::DistributedRenderer several{3, 1};
+    CHECK(several.number_of_processes() == 3);
+    single.start(serve);
+    several.start(serve);
+    CHECK_FALSE(several.worker());
+
+    sunray::ThreadPool pool{2};
+    sunray::RenderStatistics expected_statistics;
+    const auto expected = c.render(world, expected_statistics, pool);
+    for (auto* renderer : {&single, &several}) {
+      sunray::RenderStatistics statistics;
+      const auto canvas = renderer->render(c, world, statistics);
+      CHECK(identical(canvas, expected));
+      CHECK(statistics.samples_ == expected_statistics.samples_);
+      CHECK(statistics.shadow_rays_ > 0);
+    }
+  }
+  SECTION("processes on their nodes render the same image as a single process")
+  {
+    sunray::DistributedRenderer renderer{2, 2, sunray::AffinityPolicy::compact};
+    renderer.start(serve);
+
+    sunray::ThreadPool pool{2};
+    sunray::RenderStatistics expected_statistics;
+    const auto expected = c.render(world, expected_statistics, pool);
+    sunray::RenderStatistics statistics;
+    CHECK(identical(renderer.render(c, world, statistics), expected));
+  }
+  SECTION("processes render a region")
+  {
+    sunray::DistributedRenderer renderer{2, 2};
+    renderer.start(serve);
+
+    sunray::ThreadPool pool{2};
+    const sunray::Tile region{5, 3, 11, 9};
+    sunray::RenderStatistics expected_statistics;
+    const auto expected = c.render(world, region, expected_statistics, pool);
+    sunray::RenderStatistics statistics;
+    CHECK(identical(renderer.render(c, world, region, statistics), expected));
+    CHECK_THROWS_AS(renderer.render(c, world, sunray::Tile{20, 0, 4, 4}, statistics), std::out_of_range);
+  }
+  SECTION("processes anti alias across the borders of the tiles")
+  {
+    context.samples_per_pixel_ = 1;
+    context.anti_aliasing_ = true;
+    world.context(context);
+    sunray::DistributedRenderer single{1, 1};
+    sunray::DistributedRenderer several{2, 2};
+    single.start(serve);
+    several.start(serve);
+
+    sunray::ThreadPool pool{2};
+    const sunray::Tile region{3, 2, 17, 13};
+    for (const auto& tile : {sunray::Tile{0, 0, 23, 17}, region}) {
+      sunray::RenderStatistics expected_statistics;
+      const auto expected = c.render(world, tile, expected_statistics, pool);
+      sunray::RenderStatistics single_statistics;
+      const auto canvas = single.render(c, world, tile, single_statistics);
+      CHECK(identical(canvas, expected));
+      CHECK(single_statistics.passes_ == 2);
+      sunray::RenderStatistics statistics;
+      CHECK(identical(several.render(c, world, tile, statistics), canvas));
+    }
+  }
+  SECTION("processes with another scene stop the render")
+  {
+    const sunray::Camera moved{23, 17, sunray::PI / 4,
+                               sunray::view_transformation(sunray::create_point(0, 1, -5), to, up)};
+    sunray::DistributedRenderer renderer{2, 1};
+    renderer.start([&moved, &world](sunray::DistributedRenderer& workers) {
+      while (workers.serve(moved, world)) {
+      }
+    });
+    sunray::RenderStatistics statistics;
+    CHECK_THROWS_AS(renderer.render(c, world, statistics), std::runtime_error);
+  }
+  SECTION("processes have to be started")
+  {
+    sunray::DistributedRenderer renderer{2, 1};
+    sunray::RenderStatistics statistics;
+    CHECK_THROWS_AS(renderer.render(c, world, statistics), std::runtime_error);
+  }
+}
+#endif
@@ -0,0 +1,161 @@
+//
+//  frame_queue_test.cpp
+//  sun_ray_test
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#include <sun_ray/feature/frame_queue.h>
+#include <sun_ray/feature/sphere.h>
+#include <sun_ray/feature/transformation.h>
+
+#include <cstring>
+
+#include <catch2/catch.hpp>
+
+
+namespace
+{
+  std::shared_ptr<sunray::World> make_world(double x)
+  {
+    auto world = std::make_shared<sunray::World>();
+    world->add_light(std::make_shared<sunray::PointLight>(sunray::create_point(-10, 10, -10), sunray::Color(1, 1, 1)));
+    world->add_object(sunray::Sphere::make_sphere(
+      sunray::Material{sunray::Color{0.8f, 1, 0.6f}, 0.1f, 0.7f, 0.2f, 200.0f, 0.3f, 0.0f, 1.0f},
+      sunray::Transformation().translate(x, 0, 0).matrix()));
+    world->build_hierarchy();
+
+    sunray::RenderContext context;
+    context.tile_size_ = 4;
+    context.samples_per_pixel_ = 2;
+    world->context(context);
+    return world;
+  }
+
+  bool identical(const sunray::Canvas& lhs, const sunray::Canvas& rhs)
+  {
+    if (lhs.width() != rhs.width() || lhs.height() != rhs.height()) {
+      return false;
+    }
+    for (uint32_t y = 0; y < lhs.height(); ++y) {
+      for (uint32_t x = 0; x < lhs.width(); ++x) {
+        const auto left = lhs.pixel_at(x, y);
+        const auto right = rhs.pixel_at(x, y);
+        if (std::memcmp(static_cast<const float*>(left), static_cast<const float*>(right), 3 * sizeof(float)) != 0) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+}
+
+
+TEST_CASE("frame queue", "[frame queue]")
+{
+  auto pool = std::make_shared<sunray::ThreadPool>(3);
+  auto camera = std::make_shared<const sunray::Camera>(
+    23, 17, sunray::PI / 4,
+    sunray::view_transformation(sunray::create_point(0, 0, -5), sunray::create_point(0, 0, 0),
+                                sunray::create_vector(0, 1, 0)));
+  const sunray::Tile image{0, 0, 23, 17};
+
+  SECTION("frames render the same images as the camera")
+  {
+    sunray::FrameQueue queue{pool, 2};
+    CHECK(queue.frames_in_flight() == 2);
+
+    std::vector<std::shared_ptr<sunray::World>> worlds;
+    std::vector<sunray::FrameQueue::FramePtr> frames;
+    for (int n = 0; n < 5; ++n) {
+      worlds.push_back(make_world(n * 0.3));
+      frames.push_back(queue.add(camera, worlds.back(), image));
+    }
+    for (size_t n = 0; n < frames.size(); ++n) {
+      sunray::RenderStatistics statistics;
+      CHECK(identical(queue.canvas(frames[n]), camera->render(*worlds[n], image, statistics, *pool)));
+    }
+    CHECK_NOTHROW(queue.wait());
+  }
+  SECTION("frames are anti aliased across the borders of the tiles")
+  {
+    sunray::FrameQueue queue{pool, 2};
+    std::vector<std::shared_ptr<sunray::World>> worlds;
+    std::vector<sunray::FrameQueue::FramePtr> frames;
+    for (int n = 0; n < 3; ++n) {
+      worlds.push_back(make_world(n * 0.3));
+      auto context = worlds.back()->context();
+      context.samples_per_pixel_ = 1;
+      context.anti_aliasing_ = true;
+      worlds.back()->context(context);
+      frames.push_back(queue.add(camera, worlds.back(), image));
+    }
+    for (size_t n = 0; n < frames.size(); ++n) {
+      sunray::RenderStatistics statistics;
+      CHECK(identical(queue.canvas(frames[n]), camera->render(*worlds[n], image, statistics, *pool)));
+      const auto frame_statistics = queue.statistics(frames[n]);
+      CHECK(frame_statistics.samples_ == statistics.samples_);
+      CHECK(frame_statistics.passes_ == 2);
+      CHECK(frame_statistics.shadow_rays_ == statistics.shadow_rays_);
+    }
+  }
+  SECTION("frames render a region")
+  {
+    sunray::FrameQueue queue{pool, 3};
+    const sunray::Tile region{5, 3, 11, 9};
+    auto world = make_world(0.5);
+    const auto frame = queue.add(camera, world, region);
+    sunray::RenderStatistics statistics;
+    CHECK(identical(queue.canvas(frame), camera->render(*world, region, statistics, *pool)));
+  }
+  SECTION("continuations are called in the order of the frames")
+  {
+    sunray::FrameQueue queue{pool, 3};
+    std::vector<uint32_t> widths;
+    for (uint32_t n = 0; n < 6; ++n) {
+      // Later frames are smaller and done earlier
+      const auto frame = queue.add(camera, make_world(0.0), sunray::Tile{0, 0, 23 - 3 * n, 17});
+      queue.then(frame, [&widths](const sunray::Canvas& canvas) {
+        widths.push_back(canvas.width());
+      });
+    }
+    queue.wait();
+    CHECK(widths == std::vector<uint32_t>{23, 20, 17, 14, 11, 8});
+  }
+  SECTION("continuation of a delivered frame is called right away")
+  {
+    sunray::FrameQueue queue{pool, 1};
+    const auto frame = queue.add(camera, make_world(0.0), image);
+    queue.wait();
+    bool called{false};
+    queue.then(frame, [&called](const sunray::Canvas&) {
+      called = true;
+    });
+    CHECK(called);
+  }
+  SECTION("errors of continuations are thrown by wait")
+  {
+    sunray::FrameQueue queue{pool, 2};
+    const auto frame = queue.add(camera, make_world(0.0), image);
+    const auto fail = [](const sunray::Canvas&) {
+      throw std::runtime_error{"cannot write"};
+    };
+    // Whether the frame is delivered before or after, the error is thrown by wait
+    CHECK_NOTHROW(queue.then(frame, fail));
+    CHECK_THROWS_AS(queue.wait(), std::runtime_error);
+    CHECK_NOTHROW(queue.wait());
+    CHECK_NOTHROW(queue.then(frame, fail));
+    CHECK_THROWS_AS(queue.wait(), std::runtime_error);
+    CHECK_NOTHROW(queue.wait());
+  }
+  SECTION("region outside of the image")
+  {
+    sunray::FrameQueue queue{pool, 2};
+    CHECK_THROWS_AS(queue.add(camera, make_world(0.0), sunray::Tile{20, 0, 4, 4}), std::out_of_range);
+  }
+  SECTION("queue needs a pool")
+  {
+    CHECK_THROWS_AS(sunray::FrameQueue(nullptr, 2), std::invalid_argument);
+  }
+}
@@ -0,0 +1,139 @@
+//
+//  group_test.cpp
+//  sun_ray_test
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#include <sun_ray/feature/group.h>
+#include <sun_ray/feature/plane.h>
+#include <sun_ray/feature/sphere.h>
+#include <sun_ray/feature/transformation.h>
+
+#include <catch2/catch.hpp>
+
+
+TEST_CASE("create group", "[group]")
+{
+  SECTION("create empty group")
+  {
+    auto group = sunray::Group::make_group({});
+    CHECK(group->empty());
+    CHECK(group->transformation() == sunray::Matrix44::identity());
+    CHECK(group->bounds().is_empty());
+    auto xs = sunray::intersect(sunray::Ray{sunray::create_point(0, 0, 0), sunray::create_vector(0, 0, 1)}, *group);
+    CHECK(xs.intersections().empty());
+  }
+  SECTION("create group with children")
+  {
+    auto sphere = sunray::Sphere::make_sphere();
+    auto group = sunray::Group::make_group(sunray::Matrix44::translation(1, 2, 3), {sphere});
+    REQUIRE(group->children().size() == 1);
+    CHECK(group->children()[0] == sphere);
+    CHECK(sphere->parent() == group.get());
+    CHECK(group->transformation() == sunray::Matrix44::translation(1, 2, 3));
+  }
+  SECTION("object can only be part of one group")
+  {
+    auto sphere = sunray::Sphere::make_sphere();
+    auto group = sunray::Group::make_group({sphere});
+    CHECK_THROWS_AS(sunray::Group::make_group({sphere}), std::invalid_argument);
+    CHECK_THROWS_AS(sunray::Group::make_group({nullptr}), std::invalid_argument);
+  }
+  SECTION("failing group adopts none of its children")
+  {
+    auto s1 = sunray::Sphere::make_sphere();
+    auto s2 = sunray::Sphere::make_sphere();
+    auto group = sunray::Group::make_group({s2});
+    CHECK_THROWS_AS(sunray::Group::make_group({s1, nullptr}), std::invalid_argument);
+    CHECK_THROWS_AS(sunray::Group::make_group({s1, s2}), std::invalid_argument);
+    CHECK_THROWS_AS(sunray::Group::make_group({s1, s1}), std::invalid_argument);
+    CHECK(s1->parent() == nullptr);
+    CHECK(s2->parent() == group.get());
+  }
+}
+
+TEST_CASE("group bounds", "[group]")
+{
+  SECTION("group bounds contain all children")
+  {
+    auto s1 = sunray::Sphere::make_sphere(sunray::Matrix44::translation(2, 5, -3));
+    auto s2 = sunray::Sphere::make_sphere(sunray::Matrix44::scaling(2, 2, 2));
+    auto group = sunray::Group::make_group(sunray::Matrix44::translation(1, 0, 0), {s1, s2});
+    CHECK(group->bounds() == sunray::BoundingBox{sunray::create_point(-1, -2, -4), sunray::create_point(4, 6, 2)});
+  }
+  SECTION("group with unbounded child")
+  {
+    auto group = sunray::Group::make_group({sunray::Sphere::make_sphere(), sunray::Plane::make_plane()});
+    CHECK_FALSE(group->bounds().is_bounded());
+  }
+}
+
+TEST_CASE("intersect group", "[group]")
+{
+  SECTION("intersect ray with nonempty group")
+  {
+    auto s1 = sunray::Sphere::make_sphere();
+    auto s2 = sunray::Sphere::make_sphere(sunray::Matrix44::translation(0, 0, -3));
+    auto s3 = sunray::Sphere::make_sphere(sunray::Matrix44::translation(5, 0, 0));
+    auto group = sunray::Group::make_group({s1, s2, s3});
+    auto xs = sunray::intersect(sunray::Ray{sunray::create_point(0, 0, -5), sunray::create_vector(0, 0, 1)}, *group);
+    REQUIRE(xs.intersections().size() == 4);
+    CHECK(xs.intersections()[0].object() == s2.get());
+    CHECK(xs.intersections()[1].object() == s2.get());
+    CHECK(xs.intersections()[2].object() == s1.get());
+    CHECK(xs.intersections()[3].object() == s1.get());
+  }
+  SECTION("intersect transformed group")
+  {
+    auto s = sunray::Sphere::make_sphere(sunray::Matrix44::translation(5, 0, 0));
+    auto group = sunray::Group::make_group(sunray::Matrix44::scaling(2, 2, 2), {s});
+    auto xs = sunray::intersect(sunray::Ray{sunray::create_point(10, 0, -10), sunray::create_vector(0, 0, 1)}, *group);
+    CHECK(xs.intersections().size() == 2);
+  }
+  SECTION("ray misses group bounds")
+  {
+    auto s = sunray::Sphere::make_sphere();
+    auto group = sunray::Group::make_group({s, sunray::Group::make_group(sunray::Matrix44::translation(0, 3, 0),
+                                                                          {sunray::Sphere::make_sphere()})});
+    auto xs = sunray::intersect(sunray::Ray{sunray::create_point(0, 6, -5), sunray::create_vector(0, 0, 1)}, *group);
+    CHECK(xs.intersections().empty());
+  }
+  SECTION("group occludes ray")
+  {
+    auto shadowless = sunray::Sphere::make_sphere(sunray::Material{}, sunray::Matrix44::translation(0, 3, 0), false);
+    auto group = sunray::Group::make_group(sunray::Matrix44::translation(0, 0, 5), {sunray::Sphere::make_sphere(), shadowless});
+    CHECK(group->occludes(sunray::Ray{sunray::create_point(0, 0, 0), sunray::create_vector(0, 0, 1)}, 5.0));
+    CHECK_FALSE(group->occludes(sunray::Ray{sunray::create_point(0, 0, 0), sunray::create_vector(0, 0, 1)}, 3.5));
+    CHECK_FALSE(group->occludes(sunray::Ray{sunray::create_point(0, 0, 8), sunray::create_vector(0, 0, 1)}, 10.0));
+    CHECK_FALSE(group->occludes(sunray::Ray{sunray::create_point(0, 3, 0), sunray::create_vector(0, 0, 1)}, 10.0));
+  }
+}
+
+TEST_CASE("group normal", "[group]")
+{
+  SECTION("convert point from world to object space")
+  {
+    auto s = sunray::Sphere::make_sphere(sunray::Matrix44::translation(5, 0, 0));
+    auto g2 = sunray::Group::make_group(sunray::Matrix44::scaling(2, 2, 2), {s});
+    auto g1 = sunray::Group::make_group(sunray::Matrix44::rotation_y(sunray::PI / 2), {g2});
+    CHECK(s->world_to_object(sunray::create_point(-2, 0, -10)) == sunray::create_point(0, 0, -1));
+  }
+  SECTION("convert normal from object to world space")
+  {
+    auto s = sunray::Sphere::make_sphere(sunray::Matrix44::translation(5, 0, 0));
+    auto g2 = sunray::Group::make_group(sunray::Matrix44::scaling(1, 2, 3), {s});
+    auto g1 = sunray::Group::make_group(sunray::Matrix44::rotation_y(sunray::PI / 2), {g2});
+    auto n = s->normal_to_world(sunray::create_vector(sqrt(3) / 3, sqrt(3) / 3, sqrt(3) / 3));
+    CHECK(n == sunray::create_vector(0.2857, 0.4286, -0.8571));
+  }
+  SECTION("find normal on child object")
+  {
+    auto s = sunray::Sphere::make_sphere(sunray::Matrix44::translation(5, 0, 0));
+    auto g2 = sunray::Group::make_group(sunray::Matrix44::scaling(1, 2, 3), {s});
+    auto g1 = sunray::Group::make_group(sunray::Matrix44::rotation_y(sunray::PI / 2), {g2});
+    auto n = s->normal_at(sunray::create_point(1.7321, 1.1547, -5.5774));
+    CHECK(n == sunray::create_vector(0.2857, 0.4286, -0.8571));
+  }
+}
@@ -0,0 +1,165 @@
+//
+//  instance_test.cpp
+//  sun_ray_test
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#include <sun_ray/feature/instance.h>
+#include <sun_ray/feature/intersection_state.h>
+#include <sun_ray/feature/sphere.h>
+#include <sun_ray/feature/world.h>
+
+#include <catch2/catch.hpp>
+
+
+TEST_CASE("create instance", "[instance]")
+{
+  SECTION("create instance of sphere")
+  {
+    auto sphere = sunray::Sphere::make_sphere();
+    auto instance = sunray::Instance::make_instance(sphere, sunray::Matrix44::translation(1, 2, 3));
+    CHECK(instance->prototype() == sphere);
+    CHECK(instance->transformation() == sunray::Matrix44::translation(1, 2, 3));
+    CHECK(instance->material_override() == nullptr);
+    CHECK(sphere->parent() == nullptr);
+  }
+  SECTION("instance with material")
+  {
+    sunray::Material material{sunray::Color(1, 0, 0), 0.1f, 0.9f, 0.9f, 200.0f, 0.0f, 0.0f, 1.0f};
+    auto instance = sunray::Instance::make_instance(sunray::Sphere::make_sphere(), material, sunray::Matrix44::identity());
+    REQUIRE(instance->material_override() != nullptr);
+    CHECK(instance->material_override()->color() == sunray::Color(1, 0, 0));
+  }
+  SECTION("instance of instance is flattened")
+  {
+    sunray::Material material{sunray::Color(0, 1, 0), 0.1f, 0.9f, 0.9f, 200.0f, 0.0f, 0.0f, 1.0f};
+    auto sphere = sunray::Sphere::make_sphere();
+    auto inner = sunray::Instance::make_instance(sphere, material, sunray::Matrix44::scaling(2, 2, 2));
+    auto outer = sunray::Instance::make_instance(inner, sunray::Matrix44::translation(5, 0, 0));
+    CHECK(outer->prototype() == sphere);
+    CHECK(outer->transformation() == sunray::Matrix44::translation(5, 0, 0) * sunray::Matrix44::scaling(2, 2, 2));
+    REQUIRE(outer->material_override() != nullptr);
+    CHECK(outer->material_override()->color() == sunray::Color(0, 1, 0));
+  }
+  SECTION("invalid prototypes")
+  {
+    CHECK_THROWS_AS(sunray::Instance::make_instance(nullptr, sunray::Matrix44::identity()), std::invalid_argument);
+
+    auto sphere = sunray::Sphere::make_sphere();
+    auto group = sunray::Group::make_group({sphere});
+    CHECK_THROWS_AS(sunray::Instance::make_instance(sphere, sunray::Matrix44::identity()), std::invalid_argument);
+
+    auto instance = sunray::Instance::make_instance(sunray::Sphere::make_sphere(), sunray::Matrix44::identity());
+    auto group_with_instance = sunray::Group::make_group({instance});
+    CHECK_THROWS_AS(sunray::Instance::make_instance(group_with_instance, sunray::Matrix44::identity()), std::invalid_argument);
+  }
+}
+
+TEST_CASE("instance bounds", "[instance]")
+{
+  auto sphere = sunray::Sphere::make_sphere(sunray::Matrix44::scaling(2, 2, 2));
+  auto instance = sunray::Instance::make_instance(sphere, sunray::Matrix44::translation(10, 0, 0));
+  CHECK(instance->bounds() == sunray::BoundingBox{sunray::create_point(8, -2, -2), sunray::create_point(12, 2, 2)});
+}
+
+TEST_CASE("intersect instance", "[instance]")
+{
+  auto sphere = sunray::Sphere::make_sphere();
+  auto first = sunray::Instance::make_instance(sphere, sunray::Matrix44::translation(0, 0, 5));
+  auto second = sunray::Instance::make_instance(sphere, sunray::Matrix44::translation(0, 0, -5));
+
+  SECTION("intersections refer to the prototype and the instance")
+  {
+    sunray::Ray ray{sunray::create_point(0, 0, -10), sunray::create_vector(0, 0, 1)};
+    sunray::Intersections xs;
+    first->is_intersected_by(ray, xs);
+    second->is_intersected_by(ray, xs);
+    const auto& intersections = xs.intersections();
+    REQUIRE(intersections.size() == 4);
+    CHECK(intersections[0].time() == Approx(4));
+    CHECK(intersections[0].object() == sphere.get());
+    CHECK(intersections[0].instance() == second.get());
+    CHECK(intersections[3].time() == Approx(16));
+    CHECK(intersections[3].instance() == first.get());
+  }
+  SECTION("ray missing instance")
+  {
+    sunray::Ray ray{sunray::create_point(0, 2, -10), sunray::create_vector(0, 0, 1)};
+    auto xs = sunray::intersect(ray, *first);
+    CHECK(xs.intersections().empty());
+  }
+  SECTION("normal on instance")
+  {
+    auto scaled = sunray::Instance::make_instance(sphere, sunray::Matrix44::scaling(1, 0.5, 1));
+    sunray::Ray ray{sunray::create_point(0, 5, 0), sunray::create_vector(0, -1, 0)};
+    auto xs = sunray::intersect(ray, *scaled);
+    REQUIRE(xs.hit());
+    const auto point = ray.position(xs.hit()->time());
+    CHECK(point == sunray::create_point(0, 0.5, 0));
+    CHECK(sphere->normal_at(point, *xs.hit()) == sunray::create_vector(0, 1, 0));
+    const auto tilted_point = sunray::create_point(0, sqrt(2) / 4, sqrt(2) / 2);
+    sunray::Intersection tilted{0, sphere.get()};
+    sunray::Intersections tagged;
+    tagged.add(std::move(tilted));
+    tagged.instance(0, scaled.get());
+    CHECK(sphere->normal_at(tilted_point, tagged.intersections()[0]) == sunray::create_vector(0, 0.89443, 0.44721));
+  }
+  SECTION("instance of group")
+  {
+    auto group = sunray::Group::make_group(sunray::Matrix44::scaling(2, 2, 2), {sunray::Sphere::make_sphere()});
+    auto instance = sunray::Instance::make_instance(group, sunray::Matrix44::translation(5, 0, 0));
+    sunray::Ray missing_ray{sunray::create_point(10, 0, -10), sunray::create_vector(0, 0, 1)};
+    CHECK(sunray::intersect(missing_ray, *instance).intersections().empty());
+    sunray::Ray ray{sunray::create_point(6, 0, -10), sunray::create_vector(0, 0, 1)};
+    auto xs = sunray::intersect(ray, *instance);
+    REQUIRE(xs.hit());
+    const auto& child = group->children()[0];
+    CHECK(xs.hit()->object() == child.get());
+    CHECK(xs.hit()->instance() == instance.get());
+    const auto point = ray.position(xs.hit()->time());
+    CHECK(child->world_to_object(point, instance.get()) == sunray::create_point(0.5, 0, -sqrt(0.75)));
+  }
+}
+
+TEST_CASE("shade instance", "[instance]")
+{
+  sunray::World world;
+  world.add_light(std::make_shared<sunray::PointLight>(sunray::create_point(-10, 10, -10), sunray::Color(1, 1, 1)));
+  sunray::Material red{sunray::Color(1, 0, 0), 0.1f, 0.9f, 0.0f, 200.0f, 0.0f, 0.0f, 1.0f};
+  sunray::Material blue{sunray::Color(0, 0, 1), 0.1f, 0.9f, 0.0f, 200.0f, 0.0f, 0.0f, 1.0f};
+  auto sphere = sunray::Sphere::make_sphere(red);
+  world.add_object(sunray::Instance::make_instance(sphere, sunray::Matrix44::translation(-3, 0, 0)));
+  world.add_object(sunray::Instance::make_instance(sphere, blue, sunray::Matrix44::translation(3, 0, 0)));
+  world.build_hierarchy();
+
+  sunray::Intersections intersections;
+  auto left = world.color_at(sunray::Ray{sunray::create_point(-3, 0, -5), sunray::create_vector(0, 0, 1)}, intersections);
+  CHECK(left.red() > 0.5f);
+  CHECK(left.blue() == Approx(0.0f));
+  auto right = world.color_at(sunray::Ray{sunray::create_point(3, 0, -5), sunray::create_vector(0, 0, 1)}, intersections);
+  CHECK(right.red() == Approx(0.0f));
+  CHECK(right.blue() > 0.5f);
+}
+
+TEST_CASE("refraction through instances", "[instance]")
+{
+  auto glass = sunray::Sphere::make_sphere(sunray::Material{sunray::Color(1, 1, 1), 1, 0, 0, 200.0f, 0.0f, 1.0f, 1.5f});
+  sunray::Material water{sunray::Color(1, 1, 1), 1, 0, 0, 200.0f, 0.0f, 1.0f, 1.33f};
+  auto outer = sunray::Instance::make_instance(glass, sunray::Matrix44::scaling(2, 2, 2));
+  auto inner = sunray::Instance::make_instance(glass, water, sunray::Matrix44::identity());
+
+  sunray::Ray ray{sunray::create_point(0, 0, -4), sunray::create_vector(0, 0, 1)};
+  sunray::Intersections xs;
+  outer->is_intersected_by(ray, xs);
+  inner->is_intersected_by(ray, xs);
+  const auto& intersections = xs.intersections();
+  REQUIRE(intersections.size() == 4);
+  sunray::IntersectionState entering{intersections[1], ray, xs};
+  CHECK(entering.n1() == Approx(1.5));
+  CHECK(entering.n2() == Approx(1.33));
+  sunray::IntersectionState leaving{intersections[2], ray, xs};
+  CHECK(leaving.n1() == Approx(1.33));
+  CHECK(leaving.n2() == Approx(1.5));
+}
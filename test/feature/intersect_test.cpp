@@ -203,6 +203,47 @@ TEST_CASE("object hit", "[intersect]")
     REQUIRE(intersection);
     CHECK(intersection->time() == Approx(2.0));
   }
+  SECTION("hit is kept when sorting")
+  {
+    auto sphere = sunray::Sphere::make_sphere();
+    sunray::Intersections intersections;
+    intersections.add(sunray::Intersection{4, sphere.get()});
+    intersections.add(sunray::Intersection{-1, sphere.get()});
+    intersections.add(sunray::Intersection{3, sphere.get()});
+    REQUIRE(intersections.hit());
+    CHECK(intersections.hit()->time() == Approx(3.0));
+    const auto list = intersections.intersections();
+    REQUIRE(list.size() == 3);
+    CHECK(list.front().time() == Approx(-1.0));
+    CHECK(list.back().time() == Approx(4.0));
+    CHECK(intersections.hit() == &list[1]);
+  }
+}
+
+TEST_CASE("intersections beyond inline capacity", "[intersect]")
+{
+  auto sphere = sunray::Sphere::make_sphere();
+  sunray::Intersections intersections;
+  const auto count = 3 * sunray::Intersections::inline_capacity;
+  for (size_t n = 0; n < count; ++n) {
+    intersections.add(sunray::Intersection{static_cast<sunray::Real>(count - n) - sunray::Real{10.5}, sphere.get()});
+  }
+  REQUIRE(intersections.size() == count);
+  REQUIRE(intersections.hit());
+  CHECK(intersections.hit()->time() == Approx(0.5));
+
+  const auto list = intersections.intersections();
+  REQUIRE(list.size() == count);
+  CHECK(std::is_sorted(list.begin(), list.end()));
+  CHECK(list.front().time() == Approx(-9.5));
+  CHECK(intersections.hit()->time() == Approx(0.5));
+
+  intersections.clear();
+  CHECK(intersections.size() == 0);
+  CHECK_FALSE(intersections.hit());
+  intersections.add(sunray::Intersection{1, sphere.get()});
+  REQUIRE(intersections.hit());
+  CHECK(intersections.intersections().size() == 1);
 }
 
 TEST_CASE("intersect object with transformed ray", "[intersect]")
@@ -11,6 +11,8 @@
 #include <sun_ray/feature/sphere.h>
 #include <sun_ray/feature/transformation.h>
 
+#include <vector>
+
 #include <catch2/catch.hpp>
 
 namespace
@@ -129,6 +131,40 @@ TEST_CASE("create intersection state for refractions", "[intersection state]")
     CHECK(state6.n1() == Approx(1.5));
     CHECK(state6.n2() == Approx(1.0));
   }
+  SECTION("find n1 and n2 inside more containers than intersections are kept in place")
+  {
+    // Nested spheres with the refractive indices 1.1, 1.2, ...
+    std::vector<sunray::SpherePtr> spheres;
+    for (size_t n = 0; n < sunray::Intersections::inline_capacity; ++n) {
+      const auto index = 1.0f + 0.1f * static_cast<float>(n + 1);
+      const auto scale = static_cast<sunray::Real>(sunray::Intersections::inline_capacity - n);
+      trans.clear();
+      trans.scale(scale, scale, scale);
+      spheres.push_back(sunray::Sphere::make_sphere(
+        sunray::Material{sunray::Color(1, 1, 1), 1, 0, 0, 200.0f, 0.0f, 1.0f, index}, trans.matrix()));
+    }
+    sunray::Intersections intersections;
+    for (size_t n = 0; n < spheres.size(); ++n) {
+      intersections.add(sunray::Intersection{static_cast<sunray::Real>(n), spheres[n].get()});
+    }
+    for (size_t n = spheres.size(); n > 0; --n) {
+      intersections.add(sunray::Intersection{static_cast<sunray::Real>(2 * spheres.size() - n), spheres[n - 1].get()});
+    }
+    REQUIRE(intersections.size() > sunray::Intersections::inline_capacity);
+
+    const auto last = spheres.size() - 1;
+    sunray::IntersectionState innermost{intersections.intersections()[last], ray, intersections};
+    CHECK(innermost.n1() == Approx(1.0f + 0.1f * static_cast<float>(last)));
+    CHECK(innermost.n2() == Approx(1.0f + 0.1f * static_cast<float>(last + 1)));
+
+    sunray::IntersectionState leaving{intersections.intersections()[last + 1], ray, intersections};
+    CHECK(leaving.n1() == Approx(1.0f + 0.1f * static_cast<float>(last + 1)));
+    CHECK(leaving.n2() == Approx(1.0f + 0.1f * static_cast<float>(last)));
+
+    sunray::IntersectionState outermost{intersections.intersections()[2 * spheres.size() - 1], ray, intersections};
+    CHECK(outermost.n1() == Approx(1.1));
+    CHECK(outermost.n2() == Approx(1.0));
+  }
 }
 
 TEST_CASE("calculate intersection state under point", "[intersection state]")
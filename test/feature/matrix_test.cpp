@@ -744,6 +744,67 @@ TEST_CASE("inversion 4x4 matrix", "[matrix 4x4]")
     auto c = a * b;
     CHECK(c * b.inverse() == a);
   }
+  SECTION("inverse of the cofactors")
+  {
+    // clang-format off
+    sunray::Matrix44 a{{ 3,-9, 7, 3,
+                         3,-8, 2,-9,
+                        -4, 4, 4, 1,
+                        -6, 5,-1, 1 }};
+    // clang-format on
+    const auto b = a.inverse();
+    for (uint8_t r = 0; r < 4; ++r) {
+      for (uint8_t c = 0; c < 4; ++c) {
+        CHECK(b[{r, c}] == Approx(a.cofactor(c, r) / a.determinant()));
+      }
+    }
+    CHECK(a * b == sunray::Matrix44::identity());
+  }
+}
+
+TEST_CASE("affine 4x4 matrix", "[matrix 4x4]")
+{
+  const auto transformation = sunray::Matrix44::translation(5, -3, 2) * sunray::Matrix44::rotation_y(0.7) *
+                              sunray::Matrix44::scaling(2, -0.5, 4) * sunray::Matrix44::shearing(1, 0, 0.5, 0, 0, 2);
+
+  SECTION("is affine")
+  {
+    CHECK(sunray::Matrix44::identity().is_affine());
+    CHECK(sunray::Matrix44::translation(1, 2, 3).is_affine());
+    CHECK(sunray::Matrix44::rotation_z(0.5).is_affine());
+    CHECK(transformation.is_affine());
+    CHECK(sunray::Matrix44{{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, -0.0, 0, -0.0, 1}}.is_affine());
+    CHECK_FALSE(transformation.transpose().is_affine());
+    CHECK_FALSE(sunray::Matrix44{{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 2}}.is_affine());
+  }
+  SECTION("affine inverse")
+  {
+    const auto inverse = transformation.affine_inverse();
+    CHECK(inverse.is_affine());
+    CHECK(transformation.determinant() == Approx(transformation.minor(3, 3)));
+    for (uint8_t r = 0; r < 4; ++r) {
+      for (uint8_t c = 0; c < 4; ++c) {
+        CHECK(inverse[{r, c}] == Approx(transformation.cofactor(c, r) / transformation.determinant()).margin(1e-12));
+      }
+    }
+    CHECK(transformation * inverse == sunray::Matrix44::identity());
+    CHECK(transformation.inverse() == inverse);
+    CHECK(transformation.transpose().inverse() == inverse.transpose());
+  }
+  SECTION("affine inverse of a general matrix")
+  {
+    CHECK_THROWS_AS(transformation.transpose().affine_inverse(), std::runtime_error);
+    CHECK_THROWS_AS(sunray::Matrix44::scaling(1, 0, 1).affine_inverse(), std::runtime_error);
+  }
+  SECTION("multiply tuple")
+  {
+    const auto point = sunray::create_point(1, -2, 3);
+    const auto vector = sunray::create_vector(1, -2, 3);
+    CHECK((transformation * point).w() == Approx(1.0));
+    CHECK((transformation * vector).w() == Approx(0.0));
+    CHECK(transformation.affine_inverse() * (transformation * point) == point);
+    CHECK(transformation.affine_inverse() * (transformation * vector) == vector);
+  }
 }
 
 TEST_CASE("translation 4x4 matrix", "[matrix 4x4]")
@@ -75,6 +75,7 @@ TEST_CASE("create object", "[object]")
     CHECK(object.origin() == sunray::create_point(0, 0, 0));
     CHECK(object.transformation() == sunray::Matrix44::translation(2, 3, 4));
     CHECK(object.inverse_transformation() == object.transformation().inverse());
+    CHECK(object.transform_kind() == sunray::TransformKind::translate);
     CHECK(object.material() == default_material);
   }
   SECTION("create object with material")
@@ -112,6 +113,26 @@ TEST_CASE("object intersect method", "[object]")
     object.is_intersected_by(ray, intersections);
     CHECK(object.ray() == sunray::Ray{sunray::create_point(-5, 0, -5), sunray::create_vector(0, 0, 1)});
   }
+  SECTION("intersect untransformed shape with a ray")
+  {
+    TestObject object;
+    CHECK(object.transform_kind() == sunray::TransformKind::identity);
+    sunray::Ray ray{sunray::create_point(0, 0, -5), sunray::create_vector(0, 0, 1)};
+    sunray::Intersections intersections;
+    object.is_intersected_by(ray, intersections);
+    CHECK(object.ray() == ray);
+  }
+  SECTION("intersect shape with a general transformation")
+  {
+    const sunray::Matrix44 transformation{{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0.5, 1}};
+    TestObject object(transformation);
+    CHECK(object.transform_kind() == sunray::TransformKind::general);
+    sunray::Ray ray{sunray::create_point(0, 0, -5), sunray::create_vector(0, 0, 1)};
+    sunray::Intersections intersections;
+    object.is_intersected_by(ray, intersections);
+    CHECK(object.ray() == ray.transform(transformation.inverse()));
+    CHECK(object.world_to_object(ray.origin()) == transformation.inverse() * ray.origin());
+  }
 }
 
 TEST_CASE("object normal method", "[object]")
@@ -0,0 +1,67 @@
+//
+//  pixel_sampler_test.cpp
+//  sun_ray_test
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#include <sun_ray/feature/pixel_sampler.h>
+
+#include <catch2/catch.hpp>
+
+
+TEST_CASE("r2 sequence", "[pixel sampler]")
+{
+  const auto first = sunray::PixelSampler::r2(0);
+  CHECK(first.first == Approx(0.5));
+  CHECK(first.second == Approx(0.5));
+  const auto second = sunray::PixelSampler::r2(1);
+  CHECK(second.first == Approx(0.2548776662));
+  CHECK(second.second == Approx(0.0698402910));
+}
+
+TEST_CASE("pixel sampler", "[pixel sampler]")
+{
+  SECTION("samples depend on the pixel only")
+  {
+    const sunray::PixelSampler first{17, 4, sunray::ReconstructionFilter::BOX};
+    const sunray::PixelSampler second{17, 4, sunray::ReconstructionFilter::BOX};
+    const sunray::PixelSampler other{4, 17, sunray::ReconstructionFilter::BOX};
+    for (uint32_t n = 0; n < 16; ++n) {
+      CHECK(first.sample(n).x_ == Approx(second.sample(n).x_).margin(0));
+      CHECK(first.sample(n).y_ == Approx(second.sample(n).y_).margin(0));
+    }
+    CHECK(first.sample(0).x_ != Approx(other.sample(0).x_));
+  }
+  SECTION("box filter stays inside of the pixel")
+  {
+    const sunray::PixelSampler sampler{3, 9, sunray::ReconstructionFilter::BOX};
+    int upper_left{0};
+    for (uint32_t n = 0; n < 64; ++n) {
+      const auto sample = sampler.sample(n);
+      CHECK(sample.x_ >= 0.0);
+      CHECK(sample.x_ < 1.0);
+      CHECK(sample.y_ >= 0.0);
+      CHECK(sample.y_ < 1.0);
+      CHECK(sample.weight_ == Approx(1.0f));
+      upper_left += sample.x_ < 0.5 && sample.y_ < 0.5 ? 1 : 0;
+    }
+    // Low discrepancy samples cover the quarters of the pixel evenly
+    CHECK(upper_left >= 14);
+    CHECK(upper_left <= 18);
+  }
+  SECTION("gaussian filter weights samples by distance")
+  {
+    const sunray::PixelSampler sampler{3, 9, sunray::ReconstructionFilter::GAUSSIAN};
+    for (uint32_t n = 0; n < 64; ++n) {
+      const auto sample = sampler.sample(n);
+      CHECK(sample.x_ >= -0.5);
+      CHECK(sample.x_ < 1.5);
+      CHECK(sample.weight_ > 0.0f);
+      CHECK(sample.weight_ <= 1.0f);
+      const auto distance = std::hypot(sample.x_ - 0.5, sample.y_ - 0.5);
+      CHECK(sample.weight_ == Approx(std::exp(-distance * distance / 0.5)));
+    }
+  }
+}
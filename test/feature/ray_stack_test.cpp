@@ -0,0 +1,71 @@
+//
+//  ray_stack_test.cpp
+//  sun_ray_test
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#include <sun_ray/feature/ray_stack.h>
+
+#include <catch2/catch.hpp>
+
+
+TEST_CASE("ray stack", "[ray stack]")
+{
+  sunray::RayStack stack;
+  CHECK(stack.empty());
+  CHECK(stack.size() == 0);
+  CHECK(stack.capacity() == 0);
+
+  SECTION("frames are allocated for the depth up front")
+  {
+    stack.reset(4);
+    CHECK(stack.capacity() == 5);
+    CHECK(stack.empty());
+    stack.reset(2);
+    CHECK(stack.capacity() == 5);
+    for (size_t n = 0; n < 5; ++n) {
+      stack.push();
+    }
+    CHECK(stack.size() == 5);
+    CHECK_THROWS_AS(stack.push(), std::out_of_range);
+  }
+  SECTION("frames are popped in reverse order")
+  {
+    stack.reset(2);
+    stack.push().depth_ = 1;
+    stack.push().depth_ = 0;
+    CHECK(stack.size() == 2);
+    CHECK(stack.top().depth_ == 0);
+    stack.pop();
+    CHECK(stack.top().depth_ == 1);
+    stack.pop();
+    CHECK(stack.empty());
+  }
+  SECTION("pushed frame has no rays")
+  {
+    stack.reset(1);
+    auto& frame = stack.push();
+    frame.fresnel_ = true;
+    frame.next_ = 2;
+    frame.branches_[sunray::RayStack::Frame::reflected].follow_ = true;
+    frame.branches_[sunray::RayStack::Frame::refracted].color_ = sunray::Color{1, 1, 1};
+    stack.pop();
+
+    const auto& pushed = stack.push();
+    CHECK_FALSE(pushed.fresnel_);
+    CHECK(pushed.next_ == 0);
+    for (const auto& branch : pushed.branches_) {
+      CHECK_FALSE(branch.follow_);
+      CHECK(branch.color_ == sunray::Color{0, 0, 0});
+    }
+  }
+  SECTION("reset empties the stack")
+  {
+    stack.reset(1);
+    stack.push();
+    stack.reset(1);
+    CHECK(stack.empty());
+  }
+}
@@ -0,0 +1,48 @@
+//
+//  render_progress_test.cpp
+//  sun_ray_test
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#include <sun_ray/feature/render_progress.h>
+
+#include <catch2/catch.hpp>
+
+
+TEST_CASE("render progress", "[render progress]")
+{
+  sunray::RenderProgress progress;
+
+  SECTION("new progress")
+  {
+    CHECK(progress.tiles_total() == 0);
+    CHECK(progress.tiles_done() == 0);
+    CHECK(progress.samples() == 0);
+    CHECK(progress.fraction() == Approx(0.0));
+    CHECK_FALSE(progress.cancelled());
+  }
+  SECTION("count tiles")
+  {
+    progress.add_tiles(8);
+    progress.tile_done(16);
+    progress.tile_done(4);
+    CHECK(progress.tiles_total() == 8);
+    CHECK(progress.tiles_done() == 2);
+    CHECK(progress.samples() == 20);
+    CHECK(progress.fraction() == Approx(0.25));
+    CHECK(progress.samples_per_second() >= 0.0);
+  }
+  SECTION("reset keeps the cancellation")
+  {
+    progress.add_tiles(4);
+    progress.tile_done(1);
+    progress.cancel();
+    progress.reset();
+    CHECK(progress.tiles_total() == 0);
+    CHECK(progress.tiles_done() == 0);
+    CHECK(progress.samples() == 0);
+    CHECK(progress.cancelled());
+  }
+}
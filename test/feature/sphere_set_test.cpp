@@ -0,0 +1,148 @@
+//
+//  sphere_set_test.cpp
+//  sun_ray_test
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#include <sun_ray/feature/intersection_state.h>
+#include <sun_ray/feature/sphere.h>
+#include <sun_ray/feature/sphere_set.h>
+#include <sun_ray/feature/transformation.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include <catch2/catch.hpp>
+
+
+TEST_CASE("create sphere set", "[sphere_set]")
+{
+  SECTION("create empty sphere set")
+  {
+    auto set = sunray::SphereSet::make_sphere_set({}, {});
+    CHECK(set->size() == 0);
+    CHECK(set->bounds().is_empty());
+    auto xs = sunray::intersect(sunray::Ray{sunray::create_point(0, 0, -5), sunray::create_vector(0, 0, 1)}, *set);
+    CHECK(xs.intersections().empty());
+  }
+  SECTION("create sphere set")
+  {
+    auto set = sunray::SphereSet::make_sphere_set(sunray::Material{}, sunray::Matrix44::translation(1, 0, 0),
+                                                  {sunray::create_point(0, 0, 0), sunray::create_point(4, 2, 0)}, {1, 0.5});
+    REQUIRE(set->size() == 2);
+    CHECK(set->center(1) == sunray::create_point(4, 2, 0));
+    CHECK(set->radius(1) == Approx(0.5));
+    CHECK(set->bounds() == sunray::BoundingBox{sunray::create_point(0, -1, -1), sunray::create_point(5.5, 2.5, 1)});
+    CHECK(set->resolution()[0] >= 1);
+    CHECK_THROWS_AS(set->center(2), std::out_of_range);
+  }
+  SECTION("create invalid sphere set")
+  {
+    CHECK_THROWS_AS(sunray::SphereSet::make_sphere_set({sunray::create_point(0, 0, 0)}, {}), std::invalid_argument);
+    CHECK_THROWS_AS(sunray::SphereSet::make_sphere_set({sunray::create_point(0, 0, 0)}, {0.0}), std::invalid_argument);
+  }
+  SECTION("grid resolution depends on the density")
+  {
+    std::vector<sunray::Point> centers;
+    std::vector<sunray::Real> radii;
+    for (int n = 0; n < 1000; ++n) {
+      centers.push_back(sunray::create_point(static_cast<sunray::Real>(n % 10), static_cast<sunray::Real>((n / 10) % 10),
+                                              static_cast<sunray::Real>(n / 100)));
+      radii.push_back(0.25);
+    }
+    auto set = sunray::SphereSet::make_sphere_set(centers, radii);
+    CHECK(set->resolution()[0] > 1);
+    CHECK(set->resolution()[0] == set->resolution()[1]);
+    CHECK(set->resolution()[1] == set->resolution()[2]);
+  }
+}
+
+TEST_CASE("intersect sphere set", "[sphere_set]")
+{
+  SECTION("ray intersects spheres of the set")
+  {
+    auto set = sunray::SphereSet::make_sphere_set(
+      {sunray::create_point(0, 0, 0), sunray::create_point(0, 0, 4), sunray::create_point(3, 0, 0)}, {1, 1, 1});
+    auto xs = sunray::intersect(sunray::Ray{sunray::create_point(0, 0, -5), sunray::create_vector(0, 0, 1)}, *set);
+    REQUIRE(xs.intersections().size() == 4);
+    CHECK(xs.intersections()[0].time() == Approx(4));
+    CHECK(xs.intersections()[0].face() == 0);
+    CHECK(xs.intersections()[1].time() == Approx(6));
+    CHECK(xs.intersections()[2].time() == Approx(8));
+    CHECK(xs.intersections()[2].face() == 1);
+    CHECK(xs.intersections()[3].time() == Approx(10));
+  }
+  SECTION("ray starts inside a sphere of the set")
+  {
+    auto set = sunray::SphereSet::make_sphere_set({sunray::create_point(0, 0, 0), sunray::create_point(5, 0, 0)}, {1, 1});
+    auto xs = sunray::intersect(sunray::Ray{sunray::create_point(0, 0, 0), sunray::create_vector(0, 0, 1)}, *set);
+    REQUIRE(xs.intersections().size() == 2);
+    CHECK(xs.intersections()[0].time() == Approx(-1));
+    CHECK(xs.intersections()[1].time() == Approx(1));
+  }
+  SECTION("normal of the sphere hit")
+  {
+    auto set = sunray::SphereSet::make_sphere_set(sunray::Material{}, sunray::Matrix44::scaling(2, 2, 2),
+                                                  {sunray::create_point(0, 0, 0), sunray::create_point(3, 0, 0)}, {1, 1});
+    auto ray = sunray::Ray{sunray::create_point(6, 0, -5), sunray::create_vector(0, 0, 1)};
+    auto xs = sunray::intersect(ray, *set);
+    REQUIRE(xs.intersections().size() == 2);
+    sunray::IntersectionState state{xs.intersections()[0], ray, xs};
+    CHECK(xs.intersections()[0].face() == 1);
+    CHECK(state.point() == sunray::create_point(6, 0, -2));
+    CHECK(state.normal() == sunray::create_vector(0, 0, -1));
+  }
+  SECTION("sphere set behaves like single spheres")
+  {
+    std::mt19937 gen{4711};
+    std::uniform_real_distribution<> position{-5.0, 5.0};
+    std::uniform_real_distribution<> size{0.05, 0.8};
+
+    std::vector<sunray::Point> centers;
+    std::vector<sunray::Real> radii;
+    std::vector<sunray::SpherePtr> spheres;
+    for (int n = 0; n < 300; ++n) {
+      centers.push_back(sunray::create_point(position(gen), position(gen), position(gen)));
+      radii.push_back(size(gen));
+      spheres.push_back(sunray::Sphere::make_sphere(sunray::Transformation()
+                                                      .scale(radii.back(), radii.back(), radii.back())
+                                                      .translate(centers.back().x(), centers.back().y(), centers.back().z())
+                                                      .matrix()));
+    }
+    auto set = sunray::SphereSet::make_sphere_set(centers, radii);
+
+    std::vector<sunray::Point> origins{sunray::create_point(0, 0, -20), sunray::create_point(0.1, 0.2, 0.3),
+                                       sunray::create_point(12, -7, 3)};
+    for (const auto& origin : origins) {
+      for (int n = 0; n < 500; ++n) {
+        const auto target = sunray::create_point(position(gen), position(gen), position(gen));
+        const auto ray = sunray::Ray{origin, (target - origin).normalize()};
+
+        // Only intersections with spheres in front of the origin or around it are reported by the set
+        sunray::Intersections expected;
+        for (const auto& sphere : spheres) {
+          sunray::Intersections xs;
+          sphere->is_intersected_by(ray, xs);
+          if (!xs.intersections().empty() && xs.intersections().back().time() >= 0) {
+            for (const auto& x : xs.intersections()) {
+              expected.add(sunray::Intersection{x.time(), set.get()});
+            }
+          }
+        }
+
+        // Rays grazing a sphere lose half of the digits of Real in the square root
+        const auto tolerance = std::sqrt(std::numeric_limits<sunray::Real>::epsilon());
+        auto xs = sunray::intersect(ray, *set);
+        REQUIRE(xs.intersections().size() == expected.intersections().size());
+        for (size_t i = 0; i < xs.intersections().size(); ++i) {
+          CHECK(xs.intersections()[i].time() == Approx(expected.intersections()[i].time()).epsilon(tolerance));
+        }
+        const auto* hit = expected.hit();
+        CHECK(set->occludes(ray, 8.0) == (hit && hit->time() < 8.0));
+      }
+    }
+  }
+}
@@ -0,0 +1,94 @@
+//
+//  thread_pool_test.cpp
+//  sun_ray_test
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#include <sun_ray/feature/thread_pool.h>
+
+#include <atomic>
+#include <stdexcept>
+
+#ifdef __linux__
+  #include <sched.h>
+#endif
+
+#include <catch2/catch.hpp>
+
+
+TEST_CASE("thread pool", "[thread pool]")
+{
+  SECTION("create thread pool")
+  {
+    sunray::ThreadPool pool{4};
+    CHECK(pool.size() == 4);
+    sunray::ThreadPool minimal_pool{0};
+    CHECK(minimal_pool.size() == 1);
+  }
+  SECTION("every worker runs the job")
+  {
+    sunray::ThreadPool pool{4};
+    std::vector<int> calls(pool.size(), 0);
+    pool.run([&calls](size_t worker) {
+      ++calls[worker];
+    });
+    CHECK(calls == std::vector<int>{1, 1, 1, 1});
+  }
+  SECTION("workers are reused")
+  {
+    sunray::ThreadPool pool{3};
+    std::atomic<int> counter{0};
+    for (int n = 0; n < 100; ++n) {
+      pool.run([&counter](size_t) {
+        ++counter;
+      });
+    }
+    CHECK(counter == 300);
+  }
+  SECTION("exception is passed to the caller")
+  {
+    sunray::ThreadPool pool{2};
+    CHECK_THROWS_AS(pool.run([](size_t worker) {
+      if (worker == 1) {
+        throw std::runtime_error{"failed"};
+      }
+    }),
+                    std::runtime_error);
+
+    std::atomic<int> counter{0};
+    pool.run([&counter](size_t) {
+      ++counter;
+    });
+    CHECK(counter == 2);
+  }
+  SECTION("pool without affinity is not pinned")
+  {
+    sunray::ThreadPool pool{2};
+    pool.run([](size_t) {
+    });
+    CHECK(pool.affinity() == sunray::AffinityPolicy::none);
+    CHECK_FALSE(pool.cpu(0));
+    CHECK_FALSE(pool.pinned(1));
+  }
+  SECTION("workers run on the hardware threads of the placement")
+  {
+    sunray::ThreadPool pool{3, sunray::AffinityPolicy::compact};
+    CHECK(pool.affinity() == sunray::AffinityPolicy::compact);
+    std::vector<int> cpus(pool.size(), -1);
+    pool.run([&cpus](size_t worker) {
+#ifdef __linux__
+      cpus[worker] = ::sched_getcpu();
+#else
+      (void)worker;
+#endif
+    });
+    for (size_t worker = 0; worker < pool.size(); ++worker) {
+      REQUIRE(pool.cpu(worker));
+      if (pool.pinned(worker)) {
+        CHECK(cpus[worker] == static_cast<int>(pool.cpu(worker)->id_));
+      }
+    }
+  }
+}
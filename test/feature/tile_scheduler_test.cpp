@@ -0,0 +1,121 @@
+//
+//  tile_scheduler_test.cpp
+//  sun_ray_test
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#include <sun_ray/feature/tile_scheduler.h>
+
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+
+TEST_CASE("morton code", "[tile scheduler]")
+{
+  CHECK(sunray::TileScheduler::morton_code(0, 0) == 0);
+  CHECK(sunray::TileScheduler::morton_code(1, 0) == 1);
+  CHECK(sunray::TileScheduler::morton_code(0, 1) == 2);
+  CHECK(sunray::TileScheduler::morton_code(1, 1) == 3);
+  CHECK(sunray::TileScheduler::morton_code(2, 0) == 4);
+  CHECK(sunray::TileScheduler::morton_code(3, 5) == 39);
+}
+
+TEST_CASE("tile scheduler", "[tile scheduler]")
+{
+  SECTION("every pixel is covered exactly once")
+  {
+    for (uint32_t workers : {1u, 3u, 8u, 100u}) {
+      const uint32_t width = 37;
+      const uint32_t height = 21;
+      sunray::TileScheduler scheduler{width, height, 8, workers};
+      CHECK(scheduler.number_of_workers() == workers);
+      CHECK(scheduler.tile_count() == 5 * 3);
+
+      std::vector<int> covered(width * height, 0);
+      size_t tiles{0};
+      for (size_t n = 0; n < scheduler.number_of_workers(); ++n) {
+        while (const auto tile = scheduler.next(n)) {
+          ++tiles;
+          for (auto y = tile->y_; y < tile->y_ + tile->height_; ++y) {
+            for (auto x = tile->x_; x < tile->x_ + tile->width_; ++x) {
+              ++covered[y * width + x];
+            }
+          }
+        }
+      }
+      CHECK(tiles == scheduler.tile_count());
+      CHECK(std::all_of(covered.begin(), covered.end(), [](int count) {
+        return count == 1;
+      }));
+    }
+  }
+  SECTION("only the region is covered")
+  {
+    const uint32_t width = 37;
+    const uint32_t height = 21;
+    const sunray::Tile region{5, 3, 19, 10};
+    sunray::TileScheduler scheduler{region, 8, 2};
+    CHECK(scheduler.tile_count() == 3 * 2);
+
+    std::vector<int> covered(width * height, 0);
+    for (size_t n = 0; n < scheduler.number_of_workers(); ++n) {
+      while (const auto tile = scheduler.next(n)) {
+        for (auto y = tile->y_; y < tile->y_ + tile->height_; ++y) {
+          for (auto x = tile->x_; x < tile->x_ + tile->width_; ++x) {
+            ++covered[y * width + x];
+          }
+        }
+      }
+    }
+    for (uint32_t y = 0; y < height; ++y) {
+      for (uint32_t x = 0; x < width; ++x) {
+        const auto inside = x >= region.x_ && x < region.x_ + region.width_ && y >= region.y_ && y < region.y_ + region.height_;
+        CHECK(covered[y * width + x] == (inside ? 1 : 0));
+      }
+    }
+  }
+  SECTION("tiles follow the morton curve")
+  {
+    sunray::TileScheduler scheduler{4, 4, 1, 1};
+    std::vector<std::pair<uint32_t, uint32_t>> order;
+    while (const auto tile = scheduler.next(0)) {
+      order.emplace_back(tile->x_, tile->y_);
+    }
+    REQUIRE(order.size() == 16);
+    CHECK(order[0] == std::make_pair(0u, 0u));
+    CHECK(order[1] == std::make_pair(1u, 0u));
+    CHECK(order[2] == std::make_pair(0u, 1u));
+    CHECK(order[3] == std::make_pair(1u, 1u));
+    CHECK(order[4] == std::make_pair(2u, 0u));
+    CHECK(order[15] == std::make_pair(3u, 3u));
+  }
+  SECTION("idle worker steals from the others")
+  {
+    sunray::TileScheduler scheduler{4, 4, 1, 4};
+    size_t tiles{0};
+    while (scheduler.next(2)) {
+      ++tiles;
+    }
+    CHECK(tiles == 16);
+    CHECK_FALSE(scheduler.next(0));
+  }
+  SECTION("zero workers")
+  {
+    sunray::TileScheduler scheduler{4, 4, 2, 0};
+    CHECK(scheduler.number_of_workers() == 1);
+    CHECK(scheduler.tile_count() == 4);
+  }
+  SECTION("empty image")
+  {
+    sunray::TileScheduler scheduler{0, 0, 16, 2};
+    CHECK(scheduler.tile_count() == 0);
+    CHECK_FALSE(scheduler.next(1));
+  }
+  SECTION("invalid tile size")
+  {
+    CHECK_THROWS_AS((sunray::TileScheduler{4, 4, 0, 1}), std::invalid_argument);
+  }
+}
@@ -0,0 +1,159 @@
+//
+//  triangle_mesh_test.cpp
+//  sun_ray_test
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#include <sun_ray/feature/intersection_state.h>
+#include <sun_ray/feature/transformation.h>
+#include <sun_ray/feature/triangle.h>
+#include <sun_ray/feature/triangle_mesh.h>
+
+#include <catch2/catch.hpp>
+
+
+namespace
+{
+  // a unit square in the xy plane made of two triangles
+  sunray::TriangleMeshPtr create_square(const sunray::Matrix44& transformation = sunray::Matrix44::identity())
+  {
+    std::vector<sunray::Point> vertices{sunray::create_point(-1, -1, 0), sunray::create_point(1, -1, 0),
+                                        sunray::create_point(1, 1, 0), sunray::create_point(-1, 1, 0)};
+    std::vector<uint32_t> indices{0, 1, 2, 0, 2, 3};
+    return sunray::TriangleMesh::make_triangle_mesh(sunray::Material{}, transformation, std::move(vertices),
+                                                    std::move(indices));
+  }
+}
+
+
+TEST_CASE("create triangle mesh", "[triangle_mesh]")
+{
+  sunray::Material default_material{sunray::Color{1, 1, 1}, 0.1f, 0.9f, 0.9f, 200.0f, 0.0f, 0.0f, 1.0f};
+
+  SECTION("create empty triangle mesh")
+  {
+    auto mesh = sunray::TriangleMesh::make_triangle_mesh({}, {});
+    CHECK(mesh->face_count() == 0);
+    CHECK(mesh->material() == default_material);
+    CHECK(mesh->bounds().is_empty());
+    auto xs = sunray::intersect(sunray::Ray{sunray::create_point(0, 0, -5), sunray::create_vector(0, 0, 1)}, *mesh);
+    CHECK(xs.intersections().empty());
+  }
+  SECTION("create triangle mesh")
+  {
+    auto mesh = create_square(sunray::Matrix44::translation(2, 3, 4));
+    CHECK(mesh->face_count() == 2);
+    CHECK(mesh->vertices().size() == 4);
+    CHECK(mesh->indices().size() == 6);
+    CHECK(mesh->transformation() == sunray::Matrix44::translation(2, 3, 4));
+    CHECK(mesh->bounds() == sunray::BoundingBox{sunray::create_point(1, 2, 4), sunray::create_point(3, 4, 4)});
+  }
+  SECTION("create invalid triangle mesh")
+  {
+    std::vector<sunray::Point> vertices{sunray::create_point(-1, -1, 0), sunray::create_point(1, -1, 0),
+                                        sunray::create_point(1, 1, 0)};
+    CHECK_THROWS_AS(sunray::TriangleMesh::make_triangle_mesh(vertices, {0, 1}), std::invalid_argument);
+    CHECK_THROWS_AS(sunray::TriangleMesh::make_triangle_mesh(vertices, {0, 1, 3}), std::invalid_argument);
+  }
+}
+
+TEST_CASE("triangle mesh normal", "[triangle_mesh]")
+{
+  std::vector<sunray::Point> vertices{sunray::create_point(0, 1, 0), sunray::create_point(-1, 0, 0),
+                                      sunray::create_point(1, 0, 0), sunray::create_point(0, 0, 1)};
+  auto mesh = sunray::TriangleMesh::make_triangle_mesh(vertices, {0, 1, 2, 0, 3, 1});
+
+  SECTION("normal of a face")
+  {
+    CHECK(mesh->face_normal(0) == sunray::create_vector(0, 0, -1));
+    CHECK(mesh->face_normal(1) == sunray::create_vector(-1, 1, 1).normalize());
+    CHECK_THROWS_AS(mesh->face_normal(2), std::out_of_range);
+  }
+  SECTION("normal of the face hit")
+  {
+    CHECK(mesh->normal_at(sunray::create_point(0, 0.5, 0), sunray::Intersection{1, mesh.get(), 0}) ==
+          sunray::create_vector(0, 0, -1));
+    CHECK(mesh->normal_at(sunray::create_point(0, 0.5, 0), sunray::Intersection{1, mesh.get(), 1}) ==
+          sunray::create_vector(-1, 1, 1).normalize());
+  }
+}
+
+TEST_CASE("intersect triangle mesh", "[triangle_mesh]")
+{
+  auto mesh = create_square();
+
+  SECTION("ray misses the mesh")
+  {
+    auto xs = sunray::intersect(sunray::Ray{sunray::create_point(2, 0, -2), sunray::create_vector(0, 0, 1)}, *mesh);
+    CHECK(xs.intersections().empty());
+  }
+  SECTION("ray parallel to the mesh")
+  {
+    auto xs = sunray::intersect(sunray::Ray{sunray::create_point(0, 0, -2), sunray::create_vector(0, 1, 0)}, *mesh);
+    CHECK(xs.intersections().empty());
+  }
+  SECTION("ray hits the first face")
+  {
+    auto xs = sunray::intersect(sunray::Ray{sunray::create_point(0.5, -0.5, -2), sunray::create_vector(0, 0, 1)}, *mesh);
+    REQUIRE(xs.intersections().size() == 1);
+    CHECK(xs.intersections()[0].time() == Approx(2));
+    CHECK(xs.intersections()[0].object() == mesh.get());
+    CHECK(xs.intersections()[0].face() == 0);
+  }
+  SECTION("ray hits the second face")
+  {
+    auto xs = sunray::intersect(sunray::Ray{sunray::create_point(-0.5, 0.5, -2), sunray::create_vector(0, 0, 1)}, *mesh);
+    REQUIRE(xs.intersections().size() == 1);
+    CHECK(xs.intersections()[0].time() == Approx(2));
+    CHECK(xs.intersections()[0].face() == 1);
+  }
+  SECTION("mesh behaves like the single triangles")
+  {
+    std::vector<sunray::Point> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<sunray::TrianglePtr> triangles;
+    for (uint32_t n = 0; n < 50; ++n) {
+      const auto x = static_cast<double>(n % 10) - 5;
+      const auto y = static_cast<double>(n / 10) - 2.5;
+      const auto z = static_cast<double>(n % 7);
+      vertices.push_back(sunray::create_point(x, y, z));
+      vertices.push_back(sunray::create_point(x + 1.2, y, z + 0.5));
+      vertices.push_back(sunray::create_point(x, y + 1.2, z - 0.5));
+      indices.insert(indices.end(), {3 * n, 3 * n + 1, 3 * n + 2});
+      triangles.push_back(sunray::Triangle::make_triangle(vertices[3 * n], vertices[3 * n + 1], vertices[3 * n + 2]));
+    }
+    auto big_mesh = sunray::TriangleMesh::make_triangle_mesh(vertices, indices);
+
+    for (int x = -30; x <= 30; ++x) {
+      for (int y = -15; y <= 15; ++y) {
+        const auto ray = sunray::Ray{sunray::create_point(x * 0.2, y * 0.2, -10), sunray::create_vector(0, 0, 1)};
+        sunray::Intersections expected;
+        for (const auto& triangle : triangles) {
+          triangle->is_intersected_by(ray, expected);
+        }
+        auto xs = sunray::intersect(ray, *big_mesh);
+        REQUIRE(xs.intersections().size() == expected.intersections().size());
+        for (size_t n = 0; n < xs.intersections().size(); ++n) {
+          CHECK(xs.intersections()[n].time() == Approx(expected.intersections()[n].time()));
+        }
+        const auto* hit = expected.hit();
+        CHECK(big_mesh->occludes(ray, 13.0) == (hit && hit->time() < 13.0));
+      }
+    }
+  }
+  SECTION("intersection state uses the normal of the face hit")
+  {
+    std::vector<sunray::Point> vertices{sunray::create_point(0, 1, 0), sunray::create_point(-1, 0, 0),
+                                        sunray::create_point(1, 0, 0), sunray::create_point(0, 1, 2),
+                                        sunray::create_point(1, 0, 2), sunray::create_point(-1, 0, 2)};
+    auto two_faces = sunray::TriangleMesh::make_triangle_mesh(vertices, {0, 1, 2, 3, 4, 5});
+    auto ray = sunray::Ray{sunray::create_point(0, 0.5, 1), sunray::create_vector(0, 0, 1)};
+    auto xs = sunray::intersect(ray, *two_faces);
+    REQUIRE(xs.intersections().size() == 2);
+    sunray::IntersectionState state{xs.intersections()[1], ray, xs};
+    CHECK(xs.intersections()[1].face() == 1);
+    CHECK(state.normal() == sunray::create_vector(0, 0, -1));
+  }
+}
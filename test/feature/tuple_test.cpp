@@ -8,6 +8,10 @@
 
 #include <sun_ray/feature/tuple.h>
 
+#include <array>
+#include <cstring>
+#include <limits>
+#include <random>
 #include <sstream>
 
 #include <catch2/catch.hpp>
@@ -363,3 +367,99 @@ TEST_CASE("tuple factory", "[tuple factory]")
     CHECK(vector[3] == Approx(0.0));
   }
 }
+
+TEST_CASE("tuple kernel", "[tuple]")
+{
+  const sunray::Tuple::Vec a{{1.5, -2.25, 3.125, 1.0}};
+  const sunray::Tuple::Vec b{{-0.5, 4.0, 2.75, 0.0}};
+  sunray::Tuple::Vec scalar{};
+  sunray::Tuple::Vec kernel{};
+  const auto same = [&scalar, &kernel]() {
+    return std::memcmp(scalar.data(), kernel.data(), sizeof(scalar)) == 0;
+  };
+  using Kernel = sunray::kernel::TupleKernel;
+  using Scalar = sunray::kernel::ScalarTuple;
+
+  SECTION("kernel is chosen at compile time")
+  {
+    CHECK(std::string{Kernel::name}.size() > 0);
+    CHECK(alignof(sunray::Tuple) == Kernel::alignment);
+  }
+  SECTION("same results as the scalar kernel")
+  {
+    Scalar::add(a.data(), b.data(), scalar.data());
+    Kernel::add(a.data(), b.data(), kernel.data());
+    CHECK(same());
+    Scalar::subtract(a.data(), b.data(), scalar.data());
+    Kernel::subtract(a.data(), b.data(), kernel.data());
+    CHECK(same());
+    Scalar::scale(a.data(), -1.75, scalar.data());
+    Kernel::scale(a.data(), -1.75, kernel.data());
+    CHECK(same());
+    Scalar::negate(a.data(), scalar.data());
+    Kernel::negate(a.data(), kernel.data());
+    CHECK(same());
+    Scalar::cross(a.data(), b.data(), scalar.data());
+    Kernel::cross(a.data(), b.data(), kernel.data());
+    CHECK(same());
+    scalar[0] = Scalar::dot(a.data(), b.data());
+    kernel[0] = Kernel::dot(a.data(), b.data());
+    CHECK(same());
+  }
+  SECTION("same results as the scalar kernel on random tuples")
+  {
+    // The compiler may fuse the products and sums of the scalar kernel into FMA instructions, which round once instead of
+    // twice. The sums of products differ by a few units in the last place of the largest product then.
+    const auto close = [&scalar, &kernel]() {
+      const auto margin = 4 * 100 * 100 * std::numeric_limits<sunray::Real>::epsilon();
+      for (size_t n = 0; n < scalar.size(); ++n) {
+        if (scalar[n] != Approx(kernel[n]).margin(margin)) {
+          return false;
+        }
+      }
+      return true;
+    };
+    std::mt19937 gen{4711};
+    std::uniform_real_distribution<sunray::Real> distribution{-100, 100};
+    const auto random_tuple = [&gen, &distribution]() {
+      return sunray::Tuple::Vec{{distribution(gen), distribution(gen), distribution(gen), distribution(gen)}};
+    };
+    for (int n = 0; n < 1000; ++n) {
+      const auto x = random_tuple();
+      const auto y = random_tuple();
+      const auto s = distribution(gen);
+      Scalar::add(x.data(), y.data(), scalar.data());
+      Kernel::add(x.data(), y.data(), kernel.data());
+      CHECK(same());
+      Scalar::subtract(x.data(), y.data(), scalar.data());
+      Kernel::subtract(x.data(), y.data(), kernel.data());
+      CHECK(same());
+      Scalar::scale(x.data(), s, scalar.data());
+      Kernel::scale(x.data(), s, kernel.data());
+      CHECK(same());
+      Scalar::negate(x.data(), scalar.data());
+      Kernel::negate(x.data(), kernel.data());
+      CHECK(same());
+      Scalar::cross(x.data(), y.data(), scalar.data());
+      Kernel::cross(x.data(), y.data(), kernel.data());
+      CHECK(close());
+      scalar[0] = Scalar::dot(x.data(), y.data());
+      kernel[0] = Kernel::dot(x.data(), y.data());
+      CHECK(close());
+    }
+  }
+  SECTION("result may be an argument")
+  {
+    kernel = a;
+    Kernel::add(kernel.data(), b.data(), kernel.data());
+    CHECK(sunray::Tuple{kernel} == sunray::Tuple{1.0, 1.75, 5.875, 1.0});
+    kernel = a;
+    Kernel::cross(kernel.data(), b.data(), kernel.data());
+    CHECK(sunray::Tuple{kernel} == sunray::Tuple{a}.crossProduct(sunray::Tuple{b}));
+  }
+  SECTION("cross product of points is a vector")
+  {
+    const auto cross = sunray::create_point(1, 2, 3).crossProduct(sunray::create_point(2, 3, 4));
+    CHECK(cross == sunray::create_vector(-1, 2, -1));
+  }
+}
@@ -11,6 +11,7 @@
 #include <sun_ray/feature/transformation.h>
 #include <sun_ray/feature/world.h>
 
+#include <cstring>
 #include <sstream>
 
 #include <catch2/catch.hpp>
@@ -142,6 +143,83 @@ TEST_CASE("intersect world", "[world]")
   }
 }
 
+TEST_CASE("intersect world with hierarchy", "[world]")
+{
+  sunray::World world = default_world();
+  sunray::Transformation trans;
+  trans.translate(0, -1, 0);
+  world.add_object(sunray::Plane::make_plane(trans.matrix()));
+  for (int n = 0; n < 20; ++n) {
+    trans.clear();
+    trans.scale(0.25, 0.25, 0.25).translate(static_cast<sunray::Real>(n - 10), 1, 3);
+    world.add_object(sunray::Sphere::make_sphere(trans.matrix()));
+  }
+
+  SECTION("build hierarchy")
+  {
+    CHECK_FALSE(world.has_hierarchy());
+    world.build_hierarchy();
+    CHECK(world.has_hierarchy());
+    world.add_object(sunray::Sphere::make_sphere());
+    CHECK_FALSE(world.has_hierarchy());
+  }
+  SECTION("intersect world with hierarchy")
+  {
+    world.build_hierarchy();
+    auto ray = sunray::Ray{sunray::create_point(0, 0, -5), sunray::create_vector(0, 0, 1)};
+    sunray::Intersections intersections;
+    world.intersect(ray, intersections);
+    REQUIRE(intersections.intersections().size() == 4);
+    CHECK(intersections.intersections()[0].time() == Approx(4));
+    CHECK(intersections.intersections()[1].time() == Approx(4.5));
+    CHECK(intersections.intersections()[2].time() == Approx(5.5));
+    CHECK(intersections.intersections()[3].time() == Approx(6));
+  }
+  SECTION("intersect world with hierarchy from inside")
+  {
+    world.build_hierarchy();
+    auto ray = sunray::Ray{sunray::create_point(0, 0, 0), sunray::create_vector(0, 0, 1)};
+    sunray::Intersections intersections;
+    world.intersect(ray, intersections);
+    REQUIRE(intersections.intersections().size() == 4);
+    CHECK(intersections.intersections()[0].time() == Approx(-1));
+    CHECK(intersections.intersections()[3].time() == Approx(1));
+  }
+  SECTION("hierarchy finds the same intersections as the linear search")
+  {
+    std::vector<sunray::Vector> directions;
+    for (int x = -12; x <= 12; ++x) {
+      for (int y = -3; y <= 3; ++y) {
+        directions.emplace_back(sunray::create_vector(x * 0.1, y * 0.1, 1).normalize());
+      }
+    }
+    const auto origin = sunray::create_point(0, 0, -5);
+
+    std::vector<std::vector<double>> expected;
+    for (const auto& direction : directions) {
+      auto ray = sunray::Ray{origin, direction};
+      sunray::Intersections intersections;
+      world.intersect(ray, intersections);
+      std::vector<double> times;
+      for (const auto& intersection : intersections.intersections()) {
+        times.push_back(intersection.time());
+      }
+      expected.push_back(times);
+    }
+
+    world.build_hierarchy();
+    for (size_t n = 0; n < directions.size(); ++n) {
+      auto ray = sunray::Ray{origin, directions[n]};
+      sunray::Intersections intersections;
+      world.intersect(ray, intersections);
+      REQUIRE(intersections.intersections().size() == expected[n].size());
+      for (size_t i = 0; i < expected[n].size(); ++i) {
+        CHECK(intersections.intersections()[i].time() == Approx(expected[n][i]));
+      }
+    }
+  }
+}
+
 TEST_CASE("intersect world from inside", "[world]")
 {
   sunray::World world;
@@ -289,6 +367,62 @@ TEST_CASE("shadow test", "[world]")
   }
 }
 
+TEST_CASE("occlusion test", "[world]")
+{
+  sunray::World world;
+  auto blocker = sunray::Sphere::make_sphere(sunray::Matrix44::translation(0, 0, 5));
+  auto shadowless = sunray::Sphere::make_sphere(sunray::Material{}, sunray::Matrix44::translation(3, 0, 5), false);
+  world.add_object(blocker);
+  world.add_object(shadowless);
+  world.add_object(sunray::Plane::make_plane(sunray::Matrix44::translation(0, -2, 0)));
+
+  for (const bool hierarchy : {false, true}) {
+    if (hierarchy) {
+      world.build_hierarchy();
+    }
+    sunray::Ray ray{sunray::create_point(0, 0, 0), sunray::create_vector(0, 0, 1)};
+    CHECK(world.occluded(ray, 10.0));
+    CHECK(world.occluded(ray, 4.5));
+    CHECK_FALSE(world.occluded(ray, 3.5));
+    CHECK_FALSE(world.occluded(sunray::Ray{sunray::create_point(3, 0, 0), sunray::create_vector(0, 0, 1)}, 10.0));
+    CHECK_FALSE(world.occluded(sunray::Ray{sunray::create_point(0, 0, 8), sunray::create_vector(0, 0, 1)}, 10.0));
+    CHECK(world.occluded(sunray::Ray{sunray::create_point(0, 0, 20), sunray::create_vector(0, -1, 0)}, 10.0));
+    CHECK_FALSE(world.occluded(sunray::Ray{sunray::create_point(0, 0, 20), sunray::create_vector(0, -1, 0)}, 1.5));
+  }
+}
+
+TEST_CASE("shadow cache", "[world]")
+{
+  sunray::World world = default_world();
+  auto light = std::make_shared<sunray::PointLight>(sunray::create_point(-10, 10, -10), sunray::Color(1, 1, 1));
+  auto other_light = std::make_shared<sunray::PointLight>(sunray::create_point(10, 10, 10), sunray::Color(1, 1, 1));
+  sunray::ShadowCache cache;
+
+  CHECK(world.is_shadowed(*light, sunray::create_point(10, -10, 10), cache));
+  REQUIRE(cache.occluder(*light));
+  CHECK(cache.occluder(*other_light) == nullptr);
+  CHECK(cache.lookups() == 1);
+  CHECK(cache.hits() == 0);
+
+  CHECK(world.is_shadowed(*light, sunray::create_point(10, -9, 10), cache));
+  CHECK(cache.lookups() == 2);
+  CHECK(cache.hits() == 1);
+
+  const auto* occluder = cache.occluder(*light);
+  CHECK_FALSE(world.is_shadowed(*light, sunray::create_point(0, 10, 0), cache));
+  CHECK(cache.occluder(*light) == occluder);
+  CHECK(cache.lookups() == 3);
+  CHECK(cache.hits() == 1);
+
+  CHECK_FALSE(world.is_shadowed(*other_light, sunray::create_point(0, 10, 0), cache));
+  CHECK(cache.occluder(*other_light) == nullptr);
+
+  cache.clear();
+  CHECK(cache.occluder(*light) == nullptr);
+  CHECK(cache.lookups() == 4);
+  CHECK(cache.hits() == 1);
+}
+
 TEST_CASE("reflection test", "[world]")
 {
   sunray::World world;
@@ -375,6 +509,63 @@ TEST_CASE("limit maximum recursive depth", "[world]")
   }
 }
 
+TEST_CASE("minimum weight of secondary rays", "[world]")
+{
+  sunray::World world = default_world();
+  sunray::Transformation trans;
+  trans.translate(0, -1, 0);
+  auto plane = sunray::Plane::make_plane(sunray::Material{sunray::Color{1, 1, 1}, 0.1f, 0.9f, 0.9f, 200.0f, 0.5f, 0.0f, 1.0f},
+                                         trans.matrix());
+  world.add_object(plane);
+  auto ray = sunray::Ray{sunray::create_point(0, 0, -3), sunray::create_vector(0, -sqrt(2) / 2, sqrt(2) / 2)};
+  sunray::Intersections intersections;
+
+  sunray::RenderContext context;
+  context.reflections_ = false;
+  world.context(context);
+  const auto surface = world.color_at(ray, intersections);
+  context.reflections_ = true;
+  context.minimum_weight_ = 0.0f;
+  world.context(context);
+  const auto full = world.color_at(ray, intersections);
+  CHECK_FALSE(full == surface);
+
+  SECTION("rays below the minimum weight are cut off")
+  {
+    context.minimum_weight_ = 0.6f;
+    world.context(context);
+    CHECK(world.color_at(ray, intersections) == surface);
+  }
+  SECTION("rays above the minimum weight are followed")
+  {
+    context.minimum_weight_ = 0.4f;
+    world.context(context);
+    CHECK(world.color_at(ray, intersections) == full);
+  }
+  SECTION("russian roulette follows every ray for the first bounces")
+  {
+    context.minimum_weight_ = 0.6f;
+    context.russian_roulette_ = true;
+    context.russian_roulette_depth_ = 1;
+    world.context(context);
+    CHECK(world.color_at(ray, intersections) == full);
+  }
+  SECTION("russian roulette keeps the expected color")
+  {
+    context.minimum_weight_ = 0.6f;
+    context.russian_roulette_ = true;
+    context.russian_roulette_depth_ = 0;
+    world.context(context);
+    const auto color = world.color_at(ray, intersections);
+    CHECK(color == world.color_at(ray, intersections));
+
+    // A surviving ray counts with the minimum weight instead of the reflectivity of the plane
+    sunray::IntersectionState state{sunray::Intersection{sqrt(2), plane.get()}, ray, sunray::Intersections{}};
+    const auto survived = surface + world.reflect_color(state, 5) * (0.6f / 0.5f);
+    CHECK((color == surface || color == survived));
+  }
+}
+
 TEST_CASE("refraction color test", "[world]")
 {
   sunray::World world;
@@ -513,4 +704,38 @@ TEST_CASE("reflection and transparent test", "[world]")
     auto color = world.shade_hit(state, 5);
     CHECK(color == sunray::Color{0.93391f, 0.69643f, 0.69243f});
   }
+  SECTION("colors of the rays are combined in the order of a recursion")
+  {
+    trans.clear();
+    trans.translate(0, -1, 0);
+    auto floor = sunray::Plane::make_plane(sunray::Material{sunray::Color{1, 1, 1}, 0.1f, 0.9f, 0.9f, 200.0f, 0.5f, 0.5f, 1.5f},
+                                           trans.matrix());
+    world.add_object(floor);
+
+    sunray::Intersections intersections;
+    intersections.add(sunray::Intersection{sqrt(2), floor.get()});
+    sunray::IntersectionState state{intersections.intersections()[0], ray, intersections};
+    const auto reflectance = state.schlick();
+    const auto expected = world.shade_hit(state, 0) + world.reflect_color(state, 5) * reflectance +
+                          world.refracted_color(state, 5) * (1 - reflectance);
+    const auto color = world.shade_hit(state, 5);
+    CHECK(std::memcmp(static_cast<const float*>(color), static_cast<const float*>(expected), 3 * sizeof(float)) == 0);
+  }
+  SECTION("ray stack is reused for several rays")
+  {
+    trans.clear();
+    trans.translate(0, -1, 0);
+    auto floor = sunray::Plane::make_plane(sunray::Material{sunray::Color{1, 1, 1}, 0.1f, 0.9f, 0.9f, 200.0f, 0.5f, 0.5f, 1.5f},
+                                           trans.matrix());
+    world.add_object(floor);
+
+    sunray::Intersections intersections;
+    sunray::ShadowCache cache;
+    sunray::RayStack stack;
+    for (int n = 0; n < 3; ++n) {
+      CHECK(world.color_at(ray, intersections, cache, stack) == sunray::Color{0.93391f, 0.69643f, 0.69243f});
+      CHECK(stack.empty());
+      CHECK(intersections.hit()->object() == floor.get());
+    }
+  }
 }
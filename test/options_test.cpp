@@ -93,6 +93,115 @@ TEST_CASE("options", "[options]")
     CHECK(opts.second.files_.size() == 3);
     CHECK(stream.str().empty());
   }
+  SECTION("process progress option")
+  {
+    std::vector<std::string> args{"app", "-s", "script.wsl"};
+
+    auto opts = sunray::Options::handle_options(stream, args);
+    CHECK(opts.first);
+    CHECK(opts.second.progress_);
+
+    args = {"app", "--progress"};
+    opts = sunray::Options::handle_options(stream, args);
+    CHECK(opts.first);
+    CHECK(opts.second.progress_);
+
+    args = {"app", "script.wsl", "-s"};
+    opts = sunray::Options::handle_options(stream, args);
+    CHECK_FALSE(opts.first);
+    CHECK_FALSE(opts.second.progress_);
+  }
+  SECTION("process threads option")
+  {
+    std::vector<std::string> args{"app", "-t", "4", "script.wsl"};
+
+    auto opts = sunray::Options::handle_options(stream, args);
+    CHECK(opts.first);
+    CHECK(opts.second.threads_ == 4);
+    CHECK(opts.second.files_.size() == 1);
+
+    args = {"app", "--threads", "12"};
+    opts = sunray::Options::handle_options(stream, args);
+    CHECK(opts.first);
+    CHECK(opts.second.threads_ == 12);
+    CHECK(stream.str().empty());
+  }
+  SECTION("process affinity option")
+  {
+    std::vector<std::string> args{"app", "-c", "scatter", "script.wsl"};
+
+    auto opts = sunray::Options::handle_options(stream, args);
+    CHECK(opts.first);
+    CHECK(opts.second.affinity_ == sunray::AffinityPolicy::scatter);
+
+    args = {"app", "--affinity", "compact"};
+    opts = sunray::Options::handle_options(stream, args);
+    CHECK(opts.first);
+    CHECK(opts.second.affinity_ == sunray::AffinityPolicy::compact);
+    CHECK(stream.str().empty());
+  }
+  SECTION("process processes option")
+  {
+    std::vector<std::string> args{"app", "-t", "8", "-p", "2", "script.wsl"};
+
+    auto opts = sunray::Options::handle_options(stream, args);
+    CHECK(opts.first);
+    CHECK(opts.second.threads_ == 8);
+    CHECK(opts.second.processes_ == 2);
+
+    args = {"app", "--processes", "4"};
+    opts = sunray::Options::handle_options(stream, args);
+    CHECK(opts.first);
+    CHECK(opts.second.processes_ == 4);
+    CHECK(stream.str().empty());
+  }
+  SECTION("process frames option")
+  {
+    std::vector<std::string> args{"app", "-a", "3", "script.wsl"};
+
+    auto opts = sunray::Options::handle_options(stream, args);
+    CHECK(opts.first);
+    CHECK(opts.second.frames_ == 3);
+
+    args = {"app", "--frames", "2"};
+    opts = sunray::Options::handle_options(stream, args);
+    CHECK(opts.first);
+    CHECK(opts.second.frames_ == 2);
+    CHECK(stream.str().empty());
+  }
+  SECTION("process deadline option")
+  {
+    std::vector<std::string> args{"app", "-l", "2000", "script.wsl"};
+
+    auto opts = sunray::Options::handle_options(stream, args);
+    CHECK(opts.first);
+    CHECK(opts.second.deadline_.count() == 2000);
+
+    args = {"app", "--deadline", "125"};
+    opts = sunray::Options::handle_options(stream, args);
+    CHECK(opts.first);
+    CHECK(opts.second.deadline_.count() == 125);
+    CHECK(stream.str().empty());
+  }
+  SECTION("process region option")
+  {
+    std::vector<std::string> args{"app", "-r", "10,20,300,40", "script.wsl"};
+
+    auto opts = sunray::Options::handle_options(stream, args);
+    CHECK(opts.first);
+    REQUIRE(opts.second.region_);
+    CHECK(opts.second.region_->x_ == 10);
+    CHECK(opts.second.region_->y_ == 20);
+    CHECK(opts.second.region_->width_ == 300);
+    CHECK(opts.second.region_->height_ == 40);
+    CHECK(opts.second.files_.size() == 1);
+
+    args = {"app", "--region", "0,0,1,1"};
+    opts = sunray::Options::handle_options(stream, args);
+    CHECK(opts.first);
+    CHECK(opts.second.region_);
+    CHECK(stream.str().empty());
+  }
 }
 
 TEST_CASE("options usage", "[options]")
@@ -103,13 +212,20 @@ TEST_CASE("options usage", "[options]")
   {
     sunray::Options::print_usage(stream);
     CHECK_FALSE(stream.str().empty());
-    auto expected = R"(Usage: sun_ray [ --help ] | [ [-df] <FILE> [<FILE>]... ]
+    auto expected = R"(Usage: sun_ray [ --help ] | [ [-dfs] [-t <THREADS>] [-c <POLICY>] [-p <PROCESSES>] [-a <FRAMES>] [-l <MILLISECONDS>] [-r <X,Y,WIDTH,HEIGHT>] <FILE> [<FILE>]... ]
 help:
   --help                              display this help and exit
 
 processing options:
   -d, --dump                          dump instructions
   -f, --format                        format the program
+  -s, --progress                      print the progress of the renders, interrupting cancels them
+  -t, --threads <THREADS>             number of render threads, defaults to the number of hardware threads
+  -c, --affinity <POLICY>             pin the render threads: none, compact or scatter, defaults to none
+  -p, --processes <PROCESSES>         number of render processes sharing the threads, defaults to 1
+  -a, --frames <FRAMES>               number of animation frames rendered at the same time, defaults to 1
+  -l, --deadline <MILLISECONDS>       lower the quality of every frame to render it in time
+  -r, --region <X,Y,WIDTH,HEIGHT>     render only this rectangle of pixels and patch it into existing images
   <FILE>                              script to execute
 
 )";
@@ -144,6 +260,71 @@ TEST_CASE("error options", "[options]")
     CHECK(opts.second.files_.empty());
     CHECK_FALSE(stream.str().empty());
   }
+  SECTION("process wrong threads option")
+  {
+    for (const auto& args : std::vector<std::vector<std::string>>{
+           {"app", "-t"}, {"app", "-t", "0"}, {"app", "-t", "four"}, {"app", "--threads", "-2"}, {"app", "x.wsl", "-t", "2"}}) {
+      auto opts = sunray::Options::handle_options(stream, args);
+      CHECK_FALSE(opts.first);
+      CHECK(opts.second.threads_ == 0);
+    }
+    CHECK_FALSE(stream.str().empty());
+  }
+  SECTION("process wrong affinity option")
+  {
+    for (const auto& args : std::vector<std::vector<std::string>>{
+           {"app", "-c"}, {"app", "-c", "spread"}, {"app", "--affinity", ""}, {"app", "x.wsl", "-c", "compact"}}) {
+      auto opts = sunray::Options::handle_options(stream, args);
+      CHECK_FALSE(opts.first);
+      CHECK(opts.second.affinity_ == sunray::AffinityPolicy::none);
+    }
+    CHECK_FALSE(stream.str().empty());
+  }
+  SECTION("process wrong processes option")
+  {
+    for (const auto& args : std::vector<std::vector<std::string>>{
+           {"app", "-p"}, {"app", "-p", "0"}, {"app", "--processes", "two"}, {"app", "x.wsl", "-p", "2"}}) {
+      auto opts = sunray::Options::handle_options(stream, args);
+      CHECK_FALSE(opts.first);
+      CHECK(opts.second.processes_ == 1);
+    }
+    CHECK_FALSE(stream.str().empty());
+  }
+  SECTION("process wrong frames option")
+  {
+    for (const auto& args : std::vector<std::vector<std::string>>{
+           {"app", "-a"}, {"app", "-a", "0"}, {"app", "--frames", "two"}, {"app", "x.wsl", "-a", "2"}}) {
+      auto opts = sunray::Options::handle_options(stream, args);
+      CHECK_FALSE(opts.first);
+      CHECK(opts.second.frames_ == 1);
+    }
+    CHECK_FALSE(stream.str().empty());
+  }
+  SECTION("process wrong deadline option")
+  {
+    for (const auto& args : std::vector<std::vector<std::string>>{
+           {"app", "-l"}, {"app", "-l", "0"}, {"app", "--deadline", "1.5"}, {"app", "x.wsl", "-l", "20"}}) {
+      auto opts = sunray::Options::handle_options(stream, args);
+      CHECK_FALSE(opts.first);
+      CHECK(opts.second.deadline_.count() == 0);
+    }
+    CHECK_FALSE(stream.str().empty());
+  }
+  SECTION("process wrong region option")
+  {
+    for (const auto& args : std::vector<std::vector<std::string>>{{"app", "-r"},
+                                                                  {"app", "-r", "1,2,3"},
+                                                                  {"app", "-r", "1,2,3,4,5"},
+                                                                  {"app", "-r", "1,2,0,4"},
+                                                                  {"app", "-r", "1,-2,3,4"},
+                                                                  {"app", "--region", "1,,3,4"},
+                                                                  {"app", "x.wsl", "-r", "1,2,3,4"}}) {
+      auto opts = sunray::Options::handle_options(stream, args);
+      CHECK_FALSE(opts.first);
+      CHECK_FALSE(opts.second.region_);
+    }
+    CHECK_FALSE(stream.str().empty());
+  }
   SECTION("process after untagged options")
   {
     std::vector<std::string> args{"app", "script.wsl", "-f", "-d"};
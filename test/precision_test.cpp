@@ -0,0 +1,71 @@
+//
+//  precision_test.cpp
+//  sun_ray_test
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#include <sun_ray/canvas_file_reader.h>
+#include <sun_ray/feature/camera.h>
+#include <sun_ray/feature/checker_pattern.h>
+#include <sun_ray/feature/plane.h>
+#include <sun_ray/feature/sphere.h>
+#include <sun_ray/feature/transformation.h>
+#include <sun_ray/feature/world.h>
+
+#include <catch2/catch.hpp>
+
+
+namespace
+{
+  // Checkered floor with a matte, a mirroring and a glass sphere, which covers shadows, reflections and refractions
+  sunray::World precision_scene()
+  {
+    sunray::World world;
+    world.add_light(std::make_shared<sunray::PointLight>(sunray::create_point(-10, 10, -10), sunray::Color{1, 1, 1}));
+
+    sunray::Material floor{sunray::Color{1, 1, 1}, 0.1f, 0.9f, 0.0f, 200.0f, 0.2f, 0.0f, 1.0f};
+    floor.pattern(std::make_shared<sunray::CheckerPattern>(sunray::Color{0.9f, 0.9f, 0.9f}, sunray::Color{0.1f, 0.1f, 0.1f}));
+    world.add_object(sunray::Plane::make_plane(floor));
+
+    sunray::Transformation trans;
+    trans.translate(-1.5, 1, 0.5);
+    world.add_object(sunray::Sphere::make_sphere(
+      sunray::Material{sunray::Color{0.1f, 0.5f, 1.0f}, 0.1f, 0.7f, 0.3f, 200.0f, 0.0f, 0.0f, 1.0f}, trans.matrix()));
+    trans.clear();
+    trans.scale(0.75, 0.75, 0.75).translate(0.5, 0.75, -0.5);
+    world.add_object(sunray::Sphere::make_sphere(
+      sunray::Material{sunray::Color{0.1f, 0.1f, 0.1f}, 0.1f, 0.3f, 0.9f, 300.0f, 0.9f, 0.0f, 1.0f}, trans.matrix()));
+    trans.clear();
+    trans.scale(0.5, 0.5, 0.5).translate(1.5, 0.5, -1.5);
+    world.add_object(sunray::Sphere::make_sphere(
+      sunray::Material{sunray::Color{0.1f, 0.1f, 0.1f}, 0.0f, 0.1f, 0.9f, 300.0f, 0.9f, 0.9f, 1.5f}, trans.matrix()));
+    world.build_hierarchy();
+    return world;
+  }
+
+  sunray::Camera precision_camera()
+  {
+    return sunray::Camera{80, 60, sunray::PI / 3,
+                          sunray::view_transformation(sunray::create_point(0, 1.5, -5), sunray::create_point(0, 1, 0),
+                                                      sunray::create_vector(0, 1, 0))};
+  }
+}
+
+
+TEST_CASE("render with the precision of the build", "[precision]")
+{
+  // Rendered in double precision and written as binary PPM
+  const auto reference = sunray::CanvasFileReader{std::filesystem::path{__FILE__}.parent_path() / "data" /
+                                                  "precision_reference.ppm"}
+                           .read();
+
+  sunray::ThreadPool pool{2};
+  const auto canvas = precision_camera().render(precision_scene(), pool);
+  const auto diff = sunray::difference(canvas, reference, 8.0f / 255.0f);
+
+  // The reference is rounded to 8 bit, floats may move a few edges of shadows and reflections by a pixel
+  CHECK(diff.mean_ < 1.0 / 255.0);
+  CHECK(diff.pixels_ <= canvas.width() * canvas.height() / 100);
+}
@@ -6,6 +6,7 @@
 //  Copyright © 2020 Lars-Christian Fürstenberg. All rights reserved.
 //
 
+#include "../temporary_directory.h"
 #include <sun_ray/script/objects/camera.h>
 
 #include <sstream>
@@ -119,6 +120,135 @@ TEST_CASE("camera methods", "[camera]")
     CHECK(canvas->height() == Approx(10));
     CHECK(canvas->width() == Approx(20));
   }
+  SECTION("render world progressive")
+  {
+    auto world = std::make_shared<sunray::script::WorldMetaClass>()->construct();
+    world->add(std::make_shared<sunray::PointLight>(sunray::create_point(0, 5, -10.0), sunray::Color(1, 1, 1)));
+    camera->horizontal(20);
+    camera->vertical(10);
+
+    auto idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("Camera_render_progressive", 5));
+    REQUIRE(idx != -1);
+    auto res = function_registry.call_function(static_cast<size_t>(idx), {camera, world, "progressive"s, 0.1, 0.0});
+    REQUIRE(sunray::script::is_class(res));
+    auto canvas = std::dynamic_pointer_cast<sunray::script::Canvas>(sunray::script::as_class(res));
+    REQUIRE(canvas);
+    CHECK(canvas->width() == Approx(20));
+    CHECK_THROWS(function_registry.call_function(static_cast<size_t>(idx), {camera, world, "progressive"s, -1.0, 0.0}));
+  }
+  SECTION("render world with thread pool")
+  {
+    auto pool = std::make_shared<sunray::ThreadPool>(2);
+    auto pool_meta_class = std::make_shared<sunray::script::CameraMetaClass>(pool);
+    auto pool_camera = pool_meta_class->construct();
+    pool_camera->horizontal(20);
+    pool_camera->vertical(10);
+    auto world = std::make_shared<sunray::script::WorldMetaClass>()->construct();
+    world->add(std::make_shared<sunray::PointLight>(sunray::create_point(0, 5, -10.0), sunray::Color(1, 1, 1)));
+
+    auto idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("Camera_render", 2));
+    for (int n = 0; n < 2; ++n) {
+      auto res = function_registry.call_function(static_cast<size_t>(idx), {pool_camera, world});
+      auto canvas = std::dynamic_pointer_cast<sunray::script::Canvas>(sunray::script::as_class(res));
+      REQUIRE(canvas);
+      CHECK(canvas->width() == Approx(20));
+    }
+  }
+  SECTION("render region of world")
+  {
+    for (auto pool : {std::make_shared<sunray::ThreadPool>(2), sunray::ThreadPoolPtr{}}) {
+      auto region_meta_class = std::make_shared<sunray::script::CameraMetaClass>(pool, sunray::Tile{5, 2, 4, 3});
+      auto region_camera = region_meta_class->construct();
+      region_camera->horizontal(20);
+      region_camera->vertical(10);
+      auto world = std::make_shared<sunray::script::WorldMetaClass>()->construct();
+
+      auto res = region_camera->render(world->world());
+      auto canvas = std::dynamic_pointer_cast<sunray::script::Canvas>(res);
+      REQUIRE(canvas);
+      CHECK(canvas->width() == Approx(4));
+      CHECK(canvas->height() == Approx(3));
+
+      region_camera->horizontal(8);
+      CHECK_THROWS(region_camera->render(world->world()));
+    }
+  }
+  SECTION("render world with deadline")
+  {
+    auto deadline_camera = camera_meta_class->construct();
+    deadline_camera->horizontal(20);
+    deadline_camera->vertical(10);
+    auto world = std::make_shared<sunray::script::WorldMetaClass>()->construct();
+    world->add(std::make_shared<sunray::PointLight>(sunray::create_point(0, 5, -10.0), sunray::Color(1, 1, 1)));
+
+    world->samples_per_pixel(16);
+    auto canvas = std::dynamic_pointer_cast<sunray::script::Canvas>(deadline_camera->render(world));
+    REQUIRE(canvas);
+    CHECK(canvas->quality().empty());
+
+    world->deadline(0.001);
+    canvas = std::dynamic_pointer_cast<sunray::script::Canvas>(deadline_camera->render(world));
+    REQUIRE(canvas);
+    CHECK(canvas->width() == Approx(20));
+    CHECK(canvas->height() == Approx(10));
+    CHECK(canvas->quality().find("samples: 1 ") == 0);
+  }
+  SECTION("render frames in flight")
+  {
+    auto pool = std::make_shared<sunray::ThreadPool>(2);
+    auto frames = std::make_shared<sunray::FrameQueue>(pool, 2);
+    auto frame_meta_class = std::make_shared<sunray::script::CameraMetaClass>(pool, std::nullopt, nullptr, frames);
+    auto frame_camera = frame_meta_class->construct();
+    frame_camera->horizontal(20);
+    frame_camera->vertical(10);
+
+    TemporaryDirectoryGuard guard;
+    std::vector<std::shared_ptr<sunray::script::World>> worlds;
+    for (int n = 0; n < 3; ++n) {
+      auto world = std::make_shared<sunray::script::WorldMetaClass>()->construct();
+      world->add(std::make_shared<sunray::PointLight>(sunray::create_point(static_cast<sunray::Real>(n), 5, -10.0),
+                                                      sunray::Color(1, 1, 1)));
+      auto canvas = std::dynamic_pointer_cast<sunray::script::Canvas>(frame_camera->render(world));
+      REQUIRE(canvas);
+      CHECK(canvas->width() == Approx(20));
+      CHECK(canvas->height() == Approx(10));
+      canvas->write((guard.temporary_directory_path() / ("frame" + std::to_string(n))).string());
+      worlds.push_back(world);
+    }
+    // Changing a world waits for its frame
+    worlds.front()->add(std::make_shared<sunray::PointLight>(sunray::create_point(0, 5, 10.0), sunray::Color(1, 1, 1)));
+    frames->wait();
+    for (int n = 0; n < 3; ++n) {
+      const auto image =
+        sunray::CanvasFileReader{guard.temporary_directory_path() / ("frame" + std::to_string(n) + ".png")}.read();
+      CHECK(image.width() == 20);
+      CHECK(image.height() == 10);
+    }
+  }
+#ifndef _WIN32
+  SECTION("render world in several processes")
+  {
+    // The workers build the same world and render it with the same camera as the coordinating process
+    auto processes = std::make_shared<sunray::DistributedRenderer>(2, 1);
+    const auto render = [&processes](const sunray::ThreadPoolPtr& pool) {
+      auto process_meta_class = std::make_shared<sunray::script::CameraMetaClass>(pool, std::nullopt, processes);
+      auto process_camera = process_meta_class->construct();
+      process_camera->horizontal(20);
+      process_camera->vertical(10);
+      auto world = std::make_shared<sunray::script::WorldMetaClass>()->construct();
+      world->add(std::make_shared<sunray::PointLight>(sunray::create_point(0, 5, -10.0), sunray::Color(1, 1, 1)));
+      return std::dynamic_pointer_cast<sunray::script::Canvas>(process_camera->render(world->world()));
+    };
+    processes->start([&render](sunray::DistributedRenderer&) {
+      render(nullptr);
+    });
+
+    auto canvas = render(std::make_shared<sunray::ThreadPool>(2));
+    REQUIRE(canvas);
+    CHECK(canvas->width() == Approx(20));
+    CHECK(canvas->height() == Approx(10));
+  }
+#endif
 }
 
 TEST_CASE("camera stream", "[camera]")
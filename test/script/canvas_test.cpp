@@ -10,6 +10,8 @@
 
 #include <sstream>
 
+#include "../temporary_directory.h"
+
 #include <catch2/catch.hpp>
 
 using namespace std::string_literals;
@@ -110,6 +112,43 @@ TEST_CASE("canvas write", "[canvas]")
     REQUIRE(sunray::script::is_double(res));
     CHECK(sunray::script::as_double(res) == Approx(0));
   }
+  SECTION("write region")
+  {
+    TemporaryDirectoryGuard guard;
+    const auto file = guard.temporary_directory_path() / "region.png";
+    const auto red = sunray::Color{1.0f, 0, 0};
+    const auto blue = sunray::Color{0, 0, 1.0f};
+
+    sunray::Canvas patch{2, 3};
+    patch.pixel_at(0, 0, red);
+    auto region = std::make_shared<sunray::script::Canvas>(canva_meta_class, std::move(patch), sunray::Tile{4, 5, 2, 3}, 8, 9);
+    CHECK(region->width() == Approx(2));
+    CHECK(region->height() == Approx(3));
+
+    // Without an image, the region is written as is
+    region->write(file.string());
+    const auto small = sunray::CanvasFileReader{file}.read();
+    CHECK(small.width() == 2);
+    CHECK(small.height() == 3);
+    CHECK(small.pixel_at(0, 0) == red);
+
+    // An image of the full size gets the region patched in
+    sunray::Canvas full{8, 9};
+    full.pixel_at(0, 0, blue);
+    full.pixel_at(5, 7, blue);
+    sunray::CanvasFileWriter{sunray::ImageFormat::PNG, file}.write(full);
+    region->write(file.string());
+    const auto image = sunray::CanvasFileReader{file}.read();
+    REQUIRE(image.width() == 8);
+    REQUIRE(image.height() == 9);
+    CHECK(image.pixel_at(0, 0) == blue);
+    CHECK(image.pixel_at(4, 5) == red);
+    CHECK(image.pixel_at(5, 7) == sunray::Color{0, 0, 0});
+
+    // An image of another size is not overwritten
+    sunray::CanvasFileWriter{sunray::ImageFormat::PNG, file}.write(sunray::Canvas{4, 4});
+    CHECK_THROWS_AS(region->write(file.string()), std::runtime_error);
+  }
 }
 
 TEST_CASE("canvas stream", "[canvas]")
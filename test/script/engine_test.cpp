@@ -41,6 +41,26 @@ TEST_CASE("process script", "[engine]")
     CHECK(output.str() == "z = 220.00");
     CHECK_FALSE(diagnostic_output.str().empty());
   }
+  SECTION("process simple script with render threads")
+  {
+    std::stringstream output;
+    std::stringstream diagnostic_output;
+    sunray::script::Engine engine{output, diagnostic_output, false, false, 3};
+    REQUIRE(engine.thread_pool());
+    CHECK(engine.thread_pool()->size() == 3);
+    CHECK(engine.process(is));
+    CHECK(output.str() == "z = 220.00");
+  }
+  SECTION("process simple script with render processes")
+  {
+    std::stringstream output;
+    std::stringstream diagnostic_output;
+    sunray::script::Engine engine{output, diagnostic_output, false, false, 3, std::nullopt,
+                                  std::make_shared<sunray::DistributedRenderer>(2, 1), 4};
+    CHECK_FALSE(engine.thread_pool());
+    CHECK(engine.process(is));
+    CHECK(output.str() == "z = 220.00");
+  }
 }
 
 TEST_CASE("process script error", "[engine]")
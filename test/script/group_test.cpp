@@ -0,0 +1,121 @@
+//
+//  group_test.cpp
+//  sun_ray_test
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#include <sun_ray/script/objects/group.h>
+#include <sun_ray/script/objects/sphere.h>
+
+#include <sstream>
+
+#include <catch2/catch.hpp>
+
+
+TEST_CASE("group construction", "[group]")
+{
+  sunray::script::FunctionRegistry function_registry;
+  sunray::script::MetaClassRegistry registry{function_registry};
+  registry.add_meta_class(std::make_shared<sunray::script::GroupMetaClass>());
+
+  SECTION("construct group")
+  {
+    auto idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("Group_constructor", 1));
+    REQUIRE(idx != -1);
+    auto group = function_registry.call_function(static_cast<size_t>(idx), {});
+    REQUIRE(sunray::script::is_class(group));
+  }
+  SECTION("construct group error")
+  {
+    auto idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("Group_constructor", 1));
+    REQUIRE(idx != -1);
+    CHECK_THROWS(function_registry.call_function(static_cast<size_t>(idx), {0.0}));
+  }
+}
+
+TEST_CASE("group methods", "[group]")
+{
+  sunray::script::FunctionRegistry function_registry;
+  sunray::script::MetaClassRegistry registry{function_registry};
+  auto group_meta_class = std::make_shared<sunray::script::GroupMetaClass>();
+  registry.add_meta_class(group_meta_class);
+  auto sphere_meta_class = std::make_shared<sunray::script::SphereMetaClass>();
+  registry.add_meta_class(sphere_meta_class);
+  auto material_meta_class = std::make_shared<sunray::script::MaterialMetaClass>();
+  auto material{material_meta_class->construct()};
+  auto group{group_meta_class->construct()};
+
+  SECTION("add shapes")
+  {
+    auto idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("Group_add", 2));
+    REQUIRE(idx != -1);
+    auto res = function_registry.call_function(static_cast<size_t>(idx), {group, sphere_meta_class->construct(material)});
+    REQUIRE(sunray::script::is_class(res));
+    auto inner_group{group_meta_class->construct()};
+    function_registry.call_function(static_cast<size_t>(idx), {inner_group, sphere_meta_class->construct(material)});
+    function_registry.call_function(static_cast<size_t>(idx), {group, inner_group});
+
+    auto g = group->group();
+    REQUIRE(g->children().size() == 2);
+    auto inner = std::dynamic_pointer_cast<const sunray::Group>(g->children()[1]);
+    REQUIRE(inner);
+    CHECK(inner->children().size() == 1);
+    CHECK(inner->parent() == g.get());
+  }
+  SECTION("add error")
+  {
+    auto idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("Group_add", 2));
+    REQUIRE(idx != -1);
+    CHECK_THROWS(function_registry.call_function(static_cast<size_t>(idx), {group, material}));
+    CHECK_THROWS(function_registry.call_function(static_cast<size_t>(idx), {group, group}));
+
+    auto inner_group{group_meta_class->construct()};
+    auto innermost_group{group_meta_class->construct()};
+    function_registry.call_function(static_cast<size_t>(idx), {group, inner_group});
+    function_registry.call_function(static_cast<size_t>(idx), {inner_group, innermost_group});
+    CHECK_THROWS(function_registry.call_function(static_cast<size_t>(idx), {inner_group, group}));
+    CHECK_THROWS(function_registry.call_function(static_cast<size_t>(idx), {innermost_group, group}));
+    CHECK_NOTHROW(function_registry.call_function(static_cast<size_t>(idx), {group, innermost_group}));
+    CHECK(group->group()->children().size() == 2);
+  }
+  SECTION("transform")
+  {
+    auto idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("Group_scale", 4));
+    auto res = function_registry.call_function(static_cast<size_t>(idx), {group, 5.0, 5.0, 5.0});
+    idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("Group_shear", 7));
+    res = function_registry.call_function(static_cast<size_t>(idx), {group, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0});
+    idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("Group_translate", 4));
+    res = function_registry.call_function(static_cast<size_t>(idx), {group, -1.0, 0.0, 1.0});
+    idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("Group_rotate_x", 2));
+    res = function_registry.call_function(static_cast<size_t>(idx), {group, sunray::PI / 4});
+    idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("Group_rotate_y", 2));
+    res = function_registry.call_function(static_cast<size_t>(idx), {group, sunray::PI / 2});
+    idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("Group_rotate_z", 2));
+    res = function_registry.call_function(static_cast<size_t>(idx), {group, sunray::PI});
+    REQUIRE(sunray::script::is_class(res));
+    auto p = std::dynamic_pointer_cast<sunray::script::Group>(sunray::script::as_class(res));
+    REQUIRE(p);
+    sunray::Transformation trans;
+    trans.scale(5, 5, 5)
+      .shear(0, 1, 0, 0, 0, 0)
+      .translate(-1, 0, 1)
+      .rotate_x(sunray::PI / 4)
+      .rotate_y(sunray::PI / 2)
+      .rotate_z(sunray::PI);
+    CHECK(p->transformation() == trans.matrix());
+    CHECK(p->group()->transformation() == trans.matrix());
+  }
+}
+
+TEST_CASE("group stream", "[group]")
+{
+  auto group_meta_class = std::make_shared<sunray::script::GroupMetaClass>();
+
+  SECTION("to string")
+  {
+    auto group{group_meta_class->construct()};
+    CHECK(group->to_string() == "Group");
+  }
+}
@@ -0,0 +1,88 @@
+//
+//  instance_test.cpp
+//  sun_ray_test
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#include <sun_ray/script/objects/group.h>
+#include <sun_ray/script/objects/instance.h>
+#include <sun_ray/script/objects/sphere.h>
+
+#include <sstream>
+
+#include <catch2/catch.hpp>
+
+
+TEST_CASE("instance construction", "[instance]")
+{
+  sunray::script::FunctionRegistry function_registry;
+  sunray::script::MetaClassRegistry registry{function_registry};
+  registry.add_meta_class(std::make_shared<sunray::script::InstanceMetaClass>());
+  auto sphere_meta_class = std::make_shared<sunray::script::SphereMetaClass>();
+  auto material_meta_class = std::make_shared<sunray::script::MaterialMetaClass>();
+  auto material{material_meta_class->construct()};
+  auto sphere{sphere_meta_class->construct(material)};
+
+  SECTION("construct instance")
+  {
+    auto idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("Instance_constructor", 1));
+    REQUIRE(idx != -1);
+    auto instance = function_registry.call_function(static_cast<size_t>(idx), {sphere});
+    REQUIRE(sunray::script::is_class(instance));
+    instance = function_registry.call_function(static_cast<size_t>(idx), {sphere, material});
+    REQUIRE(sunray::script::is_class(instance));
+  }
+  SECTION("construct instance error")
+  {
+    auto idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("Instance_constructor", 1));
+    REQUIRE(idx != -1);
+    CHECK_THROWS(function_registry.call_function(static_cast<size_t>(idx), {}));
+    CHECK_THROWS(function_registry.call_function(static_cast<size_t>(idx), {material}));
+    CHECK_THROWS(function_registry.call_function(static_cast<size_t>(idx), {sphere, material, material}));
+  }
+}
+
+TEST_CASE("instance methods", "[instance]")
+{
+  sunray::script::FunctionRegistry function_registry;
+  sunray::script::MetaClassRegistry registry{function_registry};
+  auto instance_meta_class = std::make_shared<sunray::script::InstanceMetaClass>();
+  registry.add_meta_class(instance_meta_class);
+  auto group_meta_class = std::make_shared<sunray::script::GroupMetaClass>();
+  auto sphere_meta_class = std::make_shared<sunray::script::SphereMetaClass>();
+  auto material_meta_class = std::make_shared<sunray::script::MaterialMetaClass>();
+  auto material{material_meta_class->construct()};
+  auto group{group_meta_class->construct()};
+  group->add(sphere_meta_class->construct(material));
+
+  SECTION("instances share the prototype")
+  {
+    auto first{instance_meta_class->construct(group)};
+    auto second{instance_meta_class->construct(group, material)};
+    auto first_instance = first->instance();
+    auto second_instance = second->instance();
+    CHECK(first_instance->prototype() == second_instance->prototype());
+    CHECK(first_instance->material_override() == nullptr);
+    CHECK(second_instance->material_override() != nullptr);
+  }
+  SECTION("transform")
+  {
+    auto instance{instance_meta_class->construct(group)};
+    auto idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("Instance_scale", 4));
+    auto res = function_registry.call_function(static_cast<size_t>(idx), {instance, 5.0, 5.0, 5.0});
+    idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("Instance_translate", 4));
+    res = function_registry.call_function(static_cast<size_t>(idx), {instance, 1.0, 2.0, 3.0});
+    REQUIRE(sunray::script::is_class(res));
+    CHECK(instance->instance()->transformation() ==
+          sunray::Matrix44::translation(1, 2, 3) * sunray::Matrix44::scaling(5, 5, 5));
+  }
+  SECTION("to string")
+  {
+    auto instance{instance_meta_class->construct(group)};
+    std::stringstream ss;
+    ss << instance->to_string();
+    CHECK(ss.str() == "Instance");
+  }
+}
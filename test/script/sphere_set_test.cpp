@@ -0,0 +1,112 @@
+//
+//  sphere_set_test.cpp
+//  sun_ray_test
+//
+//  Created by Lars-Christian Fürstenberg on 17.10.26.
+//  Copyright © 2026 Lars-Christian Fürstenberg. All rights reserved.
+//
+
+#include <sun_ray/script/objects/sphere_set.h>
+
+#include <sstream>
+
+#include <catch2/catch.hpp>
+
+
+TEST_CASE("sphere set construction", "[sphere_set]")
+{
+  sunray::script::FunctionRegistry function_registry;
+  sunray::script::MetaClassRegistry registry{function_registry};
+  registry.add_meta_class(std::make_shared<sunray::script::SphereSetMetaClass>());
+  auto material_meta_class = std::make_shared<sunray::script::MaterialMetaClass>();
+
+  SECTION("construct sphere set")
+  {
+    auto material{material_meta_class->construct()};
+    auto idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("SphereSet_constructor", 1));
+    REQUIRE(idx != -1);
+    auto set = function_registry.call_function(static_cast<size_t>(idx), {material});
+    REQUIRE(sunray::script::is_class(set));
+  }
+  SECTION("construct sphere set error")
+  {
+    auto idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("SphereSet_constructor", 1));
+    REQUIRE(idx != -1);
+    CHECK_THROWS(function_registry.call_function(static_cast<size_t>(idx), {0.0, -0.1, 0.0, 1.0}));
+  }
+}
+
+TEST_CASE("sphere set methods", "[sphere_set]")
+{
+  sunray::script::FunctionRegistry function_registry;
+  sunray::script::MetaClassRegistry registry{function_registry};
+  auto set_meta_class = std::make_shared<sunray::script::SphereSetMetaClass>();
+  registry.add_meta_class(set_meta_class);
+  auto material_meta_class = std::make_shared<sunray::script::MaterialMetaClass>();
+  auto point_meta_class = std::make_shared<sunray::script::PointMetaClass>();
+  auto material{material_meta_class->construct()};
+  auto set{set_meta_class->construct(material)};
+
+  SECTION("add spheres")
+  {
+    auto idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("SphereSet_add", 5));
+    REQUIRE(idx != -1);
+    auto res = function_registry.call_function(static_cast<size_t>(idx), {set, 1.0, 2.0, 3.0, 0.5});
+    REQUIRE(sunray::script::is_class(res));
+    function_registry.call_function(static_cast<size_t>(idx), {set, -1.0, 0.0, 0.0, 1.0});
+    CHECK(set->size() == 2);
+    auto s = set->sphere_set();
+    REQUIRE(s->size() == 2);
+    CHECK(s->center(0) == sunray::create_point(1, 2, 3));
+    CHECK(s->radius(0) == Approx(0.5));
+    CHECK_THROWS(function_registry.call_function(static_cast<size_t>(idx), {set, -1.0, 0.0, 0.0, 0.0}));
+  }
+  SECTION("scatter spheres")
+  {
+    auto idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("SphereSet_scatter", 6));
+    REQUIRE(idx != -1);
+    auto minimum = point_meta_class->construct(-5, 0, -5);
+    auto maximum = point_meta_class->construct(5, 2, 5);
+    auto res = function_registry.call_function(static_cast<size_t>(idx), {set, 1000.0, 0.1, 0.2, minimum, maximum});
+    REQUIRE(sunray::script::is_class(res));
+    auto s = set->sphere_set();
+    REQUIRE(s->size() == 1000);
+    for (uint32_t n = 0; n < s->size(); ++n) {
+      CHECK(s->radius(n) >= 0.1);
+      CHECK(s->radius(n) <= 0.2);
+    }
+    CHECK(sunray::BoundingBox{sunray::create_point(-5.2, -0.2, -5.2), sunray::create_point(5.2, 2.2, 5.2)}.contains(
+      s->bounds()));
+    CHECK_THROWS(function_registry.call_function(static_cast<size_t>(idx), {set, -1.0, 0.1, 0.2, minimum, maximum}));
+    CHECK_THROWS(function_registry.call_function(static_cast<size_t>(idx), {set, 10.0, 0.2, 0.1, minimum, maximum}));
+    CHECK_THROWS(function_registry.call_function(static_cast<size_t>(idx), {set, 10.0, 0.1, 0.2, material, maximum}));
+  }
+  SECTION("transform")
+  {
+    auto idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("SphereSet_scale", 4));
+    auto res = function_registry.call_function(static_cast<size_t>(idx), {set, 5.0, 5.0, 5.0});
+    idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("SphereSet_translate", 4));
+    res = function_registry.call_function(static_cast<size_t>(idx), {set, -1.0, 0.0, 1.0});
+    idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("SphereSet_set_casts_shadow", 2));
+    function_registry.call_function(static_cast<size_t>(idx), {set, false});
+    auto p = std::dynamic_pointer_cast<sunray::script::SphereSet>(sunray::script::as_class(res));
+    REQUIRE(p);
+    sunray::Transformation trans;
+    trans.scale(5, 5, 5).translate(-1, 0, 1);
+    CHECK(p->sphere_set()->transformation() == trans.matrix());
+    CHECK_FALSE(p->sphere_set()->casts_shadow());
+  }
+}
+
+TEST_CASE("sphere set stream", "[sphere_set]")
+{
+  auto set_meta_class = std::make_shared<sunray::script::SphereSetMetaClass>();
+  auto material_meta_class = std::make_shared<sunray::script::MaterialMetaClass>();
+
+  SECTION("to string")
+  {
+    auto set{set_meta_class->construct(material_meta_class->construct())};
+    set->add(0, 0, 0, 1);
+    CHECK(set->to_string() == "SphereSet size: 1");
+  }
+}
@@ -273,7 +273,7 @@ TEST_CASE("visit parts", "[stack machine visitor]")
     CHECK(instructions[3].code_ == sunray::script::OpCode::PUSH);
     CHECK(sunray::script::as_double(instructions[3].value_) == Approx(3));
     CHECK(instructions[4].code_ == sunray::script::OpCode::PUSH);
-    CHECK(sunray::script::as_double(instructions[4].value_) == Approx(39));
+    CHECK(sunray::script::as_double(instructions[4].value_) == Approx(40));
     CHECK(instructions[5].code_ == sunray::script::OpCode::FUNC);
     CHECK(instructions[6].code_ == sunray::script::OpCode::STOREVAR);
     CHECK(instructions[6].index_.value() == 0);
@@ -112,6 +112,72 @@ TEST_CASE("world properties", "[world]")
     CHECK(sunray::script::as_double(res) == Approx(0));
     CHECK_FALSE(world->world().context().refractions_);
   }
+  SECTION("set samples per pixel and filter")
+  {
+    auto idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("World_set_samples_per_pixel", 2));
+    auto res = function_registry.call_function(static_cast<size_t>(idx), {world, 16.0});
+    REQUIRE(sunray::script::is_double(res));
+    CHECK(world->world().context().samples_per_pixel_ == 16);
+    CHECK_THROWS(function_registry.call_function(static_cast<size_t>(idx), {world, 0.0}));
+
+    idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("World_set_filter", 2));
+    CHECK(world->world().context().filter_ == sunray::ReconstructionFilter::BOX);
+    res = function_registry.call_function(static_cast<size_t>(idx), {world, "gaussian"s});
+    REQUIRE(sunray::script::is_double(res));
+    CHECK(world->world().context().filter_ == sunray::ReconstructionFilter::GAUSSIAN);
+    CHECK_THROWS(function_registry.call_function(static_cast<size_t>(idx), {world, "tent"s}));
+  }
+  SECTION("set anti aliasing")
+  {
+    auto idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("World_set_anti_aliasing", 2));
+    auto res = function_registry.call_function(static_cast<size_t>(idx), {world, true});
+    REQUIRE(sunray::script::is_double(res));
+    idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("World_set_anti_aliasing_threshold", 2));
+    res = function_registry.call_function(static_cast<size_t>(idx), {world, 0.25});
+    REQUIRE(sunray::script::is_double(res));
+    CHECK(world->world().context().anti_aliasing_);
+    CHECK(world->world().context().anti_aliasing_threshold_ == Approx(0.25f));
+    CHECK_THROWS(function_registry.call_function(static_cast<size_t>(idx), {world, -1.0}));
+  }
+  SECTION("set minimum weight and russian roulette")
+  {
+    auto idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("World_set_minimum_weight", 2));
+    auto res = function_registry.call_function(static_cast<size_t>(idx), {world, 0.01});
+    REQUIRE(sunray::script::is_double(res));
+    CHECK(world->world().context().minimum_weight_ == Approx(0.01f));
+    CHECK_THROWS(function_registry.call_function(static_cast<size_t>(idx), {world, -1.0}));
+
+    idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("World_set_russian_roulette", 2));
+    res = function_registry.call_function(static_cast<size_t>(idx), {world, true});
+    REQUIRE(sunray::script::is_double(res));
+    CHECK(world->world().context().russian_roulette_);
+
+    idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("World_set_russian_roulette_depth", 2));
+    res = function_registry.call_function(static_cast<size_t>(idx), {world, 3.0});
+    REQUIRE(sunray::script::is_double(res));
+    CHECK(world->world().context().russian_roulette_depth_ == 3);
+    CHECK_THROWS(function_registry.call_function(static_cast<size_t>(idx), {world, -1.0}));
+  }
+  SECTION("set tile size")
+  {
+    auto idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("World_set_tile_size", 2));
+    auto res = function_registry.call_function(static_cast<size_t>(idx), {world, 32.0});
+    REQUIRE(sunray::script::is_double(res));
+    CHECK(world->world().context().tile_size_ == 32);
+    CHECK_THROWS(function_registry.call_function(static_cast<size_t>(idx), {world, 0.0}));
+  }
+  SECTION("set deadline")
+  {
+    CHECK(world->world().context().deadline_.count() == 0);
+    auto idx = function_registry.index_for_function(sunray::script::NameMangler::mangle("World_set_deadline", 2));
+    auto res = function_registry.call_function(static_cast<size_t>(idx), {world, 1.5});
+    REQUIRE(sunray::script::is_double(res));
+    CHECK(world->world().context().deadline_.count() == 1500);
+    CHECK_THROWS(function_registry.call_function(static_cast<size_t>(idx), {world, -1.0}));
+
+    auto deadline_world = std::make_shared<sunray::script::WorldMetaClass>(std::chrono::milliseconds{250})->construct();
+    CHECK(deadline_world->world().context().deadline_.count() == 250);
+  }
 }
 
 TEST_CASE("world stream", "[world]")